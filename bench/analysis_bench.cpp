@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/genreclassifier.h>
+#include <drumcore/seed.h>
+
+#include <vector>
+
+using namespace JKDigital;
+
+// Backbeat grooves with seeded percussion, ~20 onsets per bar
+static std::vector<DrumBar> makeBars(size_t count) {
+    std::vector<DrumBar> bars(count);
+    for (size_t b = 0; b < count; ++b) {
+        for (int s = 0; s < 32; s += 4) bars[b].steps[2][s] = DrumStep(0.7f, 0.0f, 0);
+        bars[b].steps[0][0] = DrumStep(1.0f, 0.0f, 0);
+        bars[b].steps[0][16] = DrumStep(1.0f, 0.0f, 0);
+        bars[b].steps[1][8] = DrumStep(0.9f, 0.0f, 0);
+        bars[b].steps[1][24] = DrumStep(0.9f, 0.0f, 0);
+        for (int k = 0; k < 8; ++k) {
+            const uint64_t r = Seed::splitmix64(b * 8 + static_cast<uint64_t>(k));
+            bars[b].steps[r % DrumBar::NUM_INSTRUMENTS][(r >> 8) % 32] =
+                DrumStep(0.3f + 0.5f * Seed::toUnitFloat(r), 0.0f, 0);
+        }
+    }
+    return bars;
+}
+
+// arg = bars per batch (feature extraction + linear model); 10k bars is 38 MB of DrumBar
+static void BM_GenreClassifier_Batch(benchmark::State& state) {
+    const std::vector<DrumBar> bars = makeBars(static_cast<size_t>(state.range(0)));
+    std::vector<GenreClassifier::Result> results(bars.size());
+    const GenreClassifier classifier;
+    for (auto _ : state) {
+        classifier.classifyBatch(bars.data(), bars.size(), results.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars.size()));
+}
+BENCHMARK(BM_GenreClassifier_Batch)->Arg(256)->Arg(10000)->Unit(benchmark::kMicrosecond);
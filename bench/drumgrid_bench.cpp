@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/timesignature.h>
+
+using namespace JKDigital;
+
+namespace {
+
+enum Density { kEmpty = 0, kSparse = 1, kDense = 2 };
+
+const char* const kDensityNames[] = {"empty", "sparse", "dense"};
+
+// Sparse: a basic groove (about 10% of cells); dense: every cell
+DrumBar makeBar(int density) {
+    DrumBar bar;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const bool on = density == kDense || (density == kSparse && (i * 7 + s) % 10 == 0);
+            if (on) bar.steps[i][s] = DrumStep(0.1f + 0.8f * ((i + s) % 8) / 7.0f, 0.0f, 0);
+        }
+    }
+    return bar;
+}
+
+void densityArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("density")->Arg(kEmpty)->Arg(kSparse)->Arg(kDense);
+}
+
+}  // namespace
+
+static void BM_DrumBar_Clear(benchmark::State& state) {
+    DrumBar bar = makeBar(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        bar.clear();
+        benchmark::DoNotOptimize(bar);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_Clear)->Apply(densityArgs);
+
+static void BM_DrumBar_GateVelocity(benchmark::State& state) {
+    DrumBar bar = makeBar(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        bar.gateVelocity(0.05f);
+        benchmark::DoNotOptimize(bar);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_GateVelocity)->Apply(densityArgs);
+
+static void BM_DrumBar_GateVelocityMasked(benchmark::State& state) {
+    DrumBar bar = makeBar(static_cast<int>(state.range(0)));
+    const uint32_t mask = TimeSignatureUtils::getActiveMask(TimeSignature::k3_4);
+    for (auto _ : state) {
+        bar.gateVelocity(0.05f, mask);
+        benchmark::DoNotOptimize(bar);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_GateVelocityMasked)->Apply(densityArgs);
+
+static void BM_DrumBar_CopyHitsFrom(benchmark::State& state) {
+    const DrumBar src = makeBar(static_cast<int>(state.range(0)));
+    DrumBar dst;
+    for (auto _ : state) {
+        dst.copyHitsFrom(src);
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_CopyHitsFrom)->Apply(densityArgs);
+
+static void BM_DrumBar_HasNotes(benchmark::State& state) {
+    const DrumBar bar = makeBar(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&bar);
+        benchmark::DoNotOptimize(bar.hasNotes());
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_HasNotes)->Apply(densityArgs);
+
+static void BM_DrumBar_HasNotesMasked(benchmark::State& state) {
+    const DrumBar bar = makeBar(static_cast<int>(state.range(0)));
+    const uint32_t mask = TimeSignatureUtils::getActiveMask(TimeSignature::k3_4);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&bar);
+        benchmark::DoNotOptimize(bar.hasNotes(mask));
+    }
+    state.SetLabel(kDensityNames[state.range(0)]);
+}
+BENCHMARK(BM_DrumBar_HasNotesMasked)->Apply(densityArgs);
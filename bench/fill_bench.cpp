@@ -0,0 +1,34 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/fillengine.h>
+
+using namespace JKDigital;
+
+static void BM_Fill_FindCandidates(benchmark::State& state) {
+    DrumBar bar;
+    for (int s = 16; s < 32; s += 2) bar.steps[1][s].setFillCandidate(true);
+    for (auto _ : state) benchmark::DoNotOptimize(FillEngine::findCandidates(bar));
+}
+BENCHMARK(BM_Fill_FindCandidates);
+
+static void BM_Fill_Generate(benchmark::State& state) {
+    DrumBar source;
+    for (int s = 0; s < 32; s += 4) source.steps[2][s].velocity = 0.6f;
+    const FillCandidates candidates = FillEngine::findCandidates(source);
+    const FillVoicing voicing = FillEngine::genreVoicing(DrumBar::Genre::Funk);
+    FillParams params;
+    params.length = static_cast<FillLength>(state.range(0));
+    DrumBar out;
+    uint32_t bar = 0;
+    for (auto _ : state) {
+        FillEngine::generate(source, candidates, params, voicing, Seed::deriveSeed(42, 0, bar++),
+                             out);
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Fill_Generate)->Arg(0)->Arg(1)->Arg(2);
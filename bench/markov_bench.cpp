@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/markovgenerator.h>
+#include <drumcore/seed.h>
+
+using namespace JKDigital;
+
+// Rock model trained on 64 backbeat bars with seeded ghost notes and percussion
+static MarkovPatternModel trainRock() {
+    MarkovTrainer trainer;
+    for (uint64_t b = 0; b < 64; ++b) {
+        DrumBar bar;
+        bar.genre = DrumBar::Genre::Rock;
+        for (int s = 0; s < 32; s += 4) bar.steps[2][s] = DrumStep(0.7f, 0.0f, 0);
+        bar.steps[0][0] = DrumStep(1.0f, 0.0f, 0);
+        bar.steps[0][16] = DrumStep(1.0f, 0.0f, 0);
+        bar.steps[1][8] = DrumStep(1.0f, 0.0f, DrumStep::FLAG_ACCENT);
+        bar.steps[1][24] = DrumStep(1.0f, 0.0f, DrumStep::FLAG_ACCENT);
+        for (int k = 0; k < 6; ++k) {
+            const uint64_t r = Seed::splitmix64(b * 6 + static_cast<uint64_t>(k));
+            bar.steps[r % DrumBar::NUM_INSTRUMENTS][(r >> 8) % 32] =
+                DrumStep(0.2f, 0.0f, DrumStep::FLAG_GHOST);
+        }
+        trainer.addBar(bar);
+    }
+    MarkovPatternModel model;
+    trainer.build(model);
+    return model;
+}
+
+// One bar per iteration, a new seed each time
+static void BM_Markov_Generate(benchmark::State& state) {
+    const MarkovPatternModel model = trainRock();
+    DrumBar bar;
+    uint64_t seed = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.generate(bar, DrumBar::Genre::Rock, seed++));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Markov_Generate);
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/drummapping.h>
+#include <drumcore/kitmap.h>
+#include <drumcore/midirecorder.h>
+#include <drumcore/noteoffscheduler.h>
+
+using namespace JKDigital;
+
+namespace {
+
+DrumBar makeGroove() {
+    DrumBar bar;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            if ((i * 5 + s) % 3 != 0) continue;
+            const uint8_t flags = (s % 8 == 0) ? DrumStep::FLAG_ACCENT
+                                               : ((s % 8 == 6) ? DrumStep::FLAG_GHOST : 0);
+            bar.steps[i][s] = DrumStep(0.2f + 0.7f * ((i + s) % 5) / 4.0f, 0.0f, flags);
+        }
+    }
+    return bar;
+}
+
+}  // namespace
+
+// Baseline: per-note scalar conversion with the Constants multipliers applied by the caller
+static void BM_Midi_ScalarBar(benchmark::State& state) {
+    const DrumBar bar = makeGroove();
+    int32_t notes[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    int32_t velocities[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    for (auto _ : state) {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                const DrumStep& step = bar.steps[i][s];
+                float v = step.velocity;
+                if (step.isAccent()) v *= Constants::kAccentVelocityMultiplier;
+                else if (step.isGhost()) v *= Constants::kGhostVelocityMultiplier;
+                notes[i][s] = GMDrumMap::getNote(i);
+                velocities[i][s] = GMDrumMap::toMidiVelocity(v);
+            }
+        }
+        benchmark::DoNotOptimize(notes);
+        benchmark::DoNotOptimize(velocities);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * DrumBar::NUM_INSTRUMENTS *
+                            DrumBar::STEPS_PER_BAR);
+}
+BENCHMARK(BM_Midi_ScalarBar);
+
+static void BM_Midi_VelocityCurveBar(benchmark::State& state) {
+    const DrumBar bar = makeGroove();
+    const VelocityCurve curve = VelocityCurve::exponential(1.5f);
+    uint8_t out[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    for (auto _ : state) {
+        curve.convertBar(bar, out);
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * DrumBar::NUM_INSTRUMENTS *
+                            DrumBar::STEPS_PER_BAR);
+}
+BENCHMARK(BM_Midi_VelocityCurveBar);
+
+static void BM_Midi_KitMapBar(benchmark::State& state) {
+    const DrumBar bar = makeGroove();
+    const KitMap kit = KitMap::generalMidi();
+    int8_t out[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    for (auto _ : state) {
+        kit.convertBar(bar, out);
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * DrumBar::NUM_INSTRUMENTS *
+                            DrumBar::STEPS_PER_BAR);
+}
+BENCHMARK(BM_Midi_KitMapBar);
+
+// Per-event recording cost, including periodic bar rollover and queue push
+static void BM_MidiRecorder_RecordEvent(benchmark::State& state) {
+    MidiRecorder recorder;
+    MidiRecorder::Transport transport;
+    transport.sampleRate = 48000.0;
+    const int32_t notes[] = {GMDrumMap::KICK, GMDrumMap::CLOSED_HH, GMDrumMap::SNARE,
+                             GMDrumMap::CLOSED_HH};
+    DrumBar drained;
+    int64_t block = 0;
+    for (auto _ : state) {
+        // One 256-sample block (0.0267 PPQ at 120 BPM) per event
+        transport.ppqPosition = static_cast<double>(block) * 256.0 / 24000.0;
+        transport.barStartPpq = static_cast<double>(static_cast<int64_t>(
+                                    transport.ppqPosition / 4.0)) * 4.0;
+        recorder.beginBlock(transport);
+        benchmark::DoNotOptimize(recorder.recordEvent(17, notes[block & 3], 100));
+        while (recorder.popBar(drained)) benchmark::DoNotOptimize(drained);
+        ++block;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MidiRecorder_RecordEvent);
+
+// Worst case: every block closes a bar. args = {jump, drain}
+//   jump 0: one bar later per block (rollover), 1: three bars later (flush + reopen)
+//   drain 0: queue stays full, so every close drops; 1: every close pushes
+static void BM_MidiRecorder_RolloverEveryEvent(benchmark::State& state) {
+    const bool jump = state.range(0) != 0;
+    const bool drain = state.range(1) != 0;
+    MidiRecorder recorder;
+    MidiRecorder::Transport transport;
+    transport.sampleRate = 48000.0;
+    const double barsPerBlock = jump ? 3.0 : 1.0;
+    DrumBar drained;
+    int64_t block = 0;
+    for (auto _ : state) {
+        // Half a beat into the bar, past the previous bar's close point
+        transport.barStartPpq = static_cast<double>(block) * barsPerBlock * 4.0;
+        transport.ppqPosition = transport.barStartPpq + 0.5;
+        recorder.beginBlock(transport);
+        benchmark::DoNotOptimize(recorder.recordEvent(17, GMDrumMap::KICK, 100));
+        if (drain) {
+            while (recorder.popBar(drained)) benchmark::DoNotOptimize(drained);
+        }
+        ++block;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = static_cast<double>(recorder.droppedBars());
+}
+BENCHMARK(BM_MidiRecorder_RolloverEveryEvent)
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({1, 0})
+    ->Args({1, 1});
+
+// One 128-sample block with four note-ons (retriggers every block on the hi-hat)
+static void BM_NoteOffScheduler_Block(benchmark::State& state) {
+    NoteOffScheduler scheduler(48000.0);
+    const int notes[] = {GMDrumMap::KICK, GMDrumMap::CLOSED_HH, GMDrumMap::SNARE,
+                         GMDrumMap::CLOSED_HH};
+    int64_t emitted = 0;
+    auto emit = [&](const NoteOffScheduler::NoteOff& e) { emitted += e.sampleOffset; };
+    int64_t block = 0;
+    for (auto _ : state) {
+        for (int k = 0; k < 4; ++k) {
+            scheduler.noteOn(k * 32, 9, notes[(block + k) & 3], emit);
+        }
+        scheduler.advance(128, emit);
+        ++block;
+    }
+    benchmark::DoNotOptimize(emitted);
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_NoteOffScheduler_Block);
@@ -0,0 +1,316 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Cross-core latency harness for the SPSC primitives.
+//
+// Modes:
+//   pingpong  Round trip: A pushes to queue 1, B pops and pushes the same
+//             payload to queue 2, A pops it. Measures publish-to-visible
+//             latency in both directions with no queue backlog.
+//   stream    One-way: the producer publishes a timestamped payload once
+//             the consumer has taken the previous one, so each sample is
+//             publish-to-visible latency with no backlog. Head and tail
+//             are both written every item, which exposes false sharing
+//             between them.
+//
+// Each mode runs the current LockFreeQueue layout and a copy with head
+// and tail on separate cache lines, plus DrumPatternBuffer for DrumBar
+// payloads. Threads are pinned with --cores A,B (Linux); pick A and B on
+// the same physical core (SMT siblings), different cores, or different
+// sockets to compare topologies (see --topology).
+//
+//   drumcore_pingpong [--cores 0,1] [--iterations 200000] [--mode pingpong|stream|all]
+//------------------------------------------------------------------------
+
+#include <drumcore/drumgrid.h>
+#include <drumcore/lockfreequeue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace JKDigital;
+
+namespace {
+
+constexpr size_t kCacheLine = 64;
+constexpr size_t kQueueCapacity = 64;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+bool pinToCore(int core) {
+#if defined(__linux__)
+    if (core < 0) return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+
+void printTopology(int core) {
+    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(core) + "/topology/";
+    std::string siblings, package;
+    std::ifstream(base + "thread_siblings_list") >> siblings;
+    std::ifstream(base + "physical_package_id") >> package;
+    std::printf("  cpu%d: package %s, SMT siblings %s\n", core,
+                package.empty() ? "?" : package.c_str(), siblings.empty() ? "?" : siblings.c_str());
+}
+
+/** LockFreeQueue with head and tail on separate cache lines (comparison only). */
+template <typename T, size_t Capacity>
+class PaddedQueue {
+  public:
+    bool push(const T& item) {
+        const size_t currentHead = head_.load(std::memory_order_relaxed);
+        const size_t nextHead = (currentHead + 1) & (Capacity - 1);
+        if (nextHead == tail_.load(std::memory_order_acquire)) return false;
+        buffer_[currentHead] = item;
+        head_.store(nextHead, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const size_t currentTail = tail_.load(std::memory_order_relaxed);
+        if (currentTail == head_.load(std::memory_order_acquire)) return false;
+        item = buffer_[currentTail];
+        tail_.store((currentTail + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+  private:
+    T buffer_[Capacity];
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+};
+
+template <size_t Bytes>
+struct Payload {
+    uint64_t stamp;
+    unsigned char data[Bytes > sizeof(uint64_t) ? Bytes - sizeof(uint64_t) : 1];
+};
+
+// DrumBar carries its timestamp in the first step
+inline void stamp(DrumBar& bar, uint64_t t) {
+    std::memcpy(static_cast<void*>(&bar.steps[0][0]), &t, sizeof(t));
+}
+inline uint64_t stampOf(const DrumBar& bar) {
+    uint64_t t;
+    std::memcpy(&t, static_cast<const void*>(&bar.steps[0][0]), sizeof(t));
+    return t;
+}
+template <size_t Bytes>
+inline void stamp(Payload<Bytes>& p, uint64_t t) {
+    p.stamp = t;
+}
+template <size_t Bytes>
+inline uint64_t stampOf(const Payload<Bytes>& p) {
+    return p.stamp;
+}
+
+struct Config {
+    int producerCore = 0;
+    int consumerCore = 1;
+    size_t iterations = 200000;
+    bool pingpong = true;
+    bool stream = true;
+};
+
+void report(const char* mode, const char* layout, size_t bytes, std::vector<uint64_t>& samples,
+            bool consumerPinned) {
+    if (!consumerPinned) {
+        std::printf("%-9s %-18s %6zu B  failed: cannot pin the consumer thread\n", mode, layout,
+                    bytes);
+        return;
+    }
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&](double q) {
+        const size_t i = static_cast<size_t>(q * static_cast<double>(samples.size() - 1));
+        return static_cast<unsigned long long>(samples[i]);
+    };
+    std::printf("%-9s %-18s %6zu B  p50 %7llu  p99 %7llu  p99.9 %8llu  max %9llu ns\n", mode,
+                layout, bytes, at(0.5), at(0.99), at(0.999),
+                static_cast<unsigned long long>(samples.back()));
+}
+
+template <typename Queue, typename T>
+void runPingPong(const Config& cfg, const char* layout, size_t bytes) {
+    Queue* forward = new Queue();
+    Queue* backward = new Queue();
+    std::vector<uint64_t> samples;
+    samples.reserve(cfg.iterations);
+    std::atomic<bool> ready{false};
+    bool pinned = false;
+
+    std::thread echo([&] {
+        pinned = pinToCore(cfg.consumerCore);
+        ready.store(true);
+        T item;
+        for (size_t i = 0; i < cfg.iterations; ++i) {
+            while (!forward->pop(item)) {
+            }
+            while (!backward->push(item)) {
+            }
+        }
+    });
+
+    pinToCore(cfg.producerCore);
+    while (!ready.load()) {
+    }
+    T item{};
+    for (size_t i = 0; i < cfg.iterations; ++i) {
+        const uint64_t start = nowNs();
+        stamp(item, start);
+        while (!forward->push(item)) {
+        }
+        while (!backward->pop(item)) {
+        }
+        samples.push_back(nowNs() - start);
+    }
+    echo.join();
+    delete forward;
+    delete backward;
+    report("pingpong", layout, bytes, samples, pinned);
+}
+
+template <typename Queue, typename T>
+void runStream(const Config& cfg, const char* layout, size_t bytes) {
+    Queue* queue = new Queue();
+    std::vector<uint64_t> samples;
+    samples.reserve(cfg.iterations);
+    std::atomic<bool> ready{false};
+    bool pinned = false;
+    // Items taken so far; on its own line so pacing does not share with the queue
+    alignas(kCacheLine) std::atomic<size_t> consumed{0};
+
+    std::thread consumer([&] {
+        pinned = pinToCore(cfg.consumerCore);
+        ready.store(true);
+        T item;
+        for (size_t i = 0; i < cfg.iterations; ++i) {
+            while (!queue->pop(item)) {
+            }
+            samples.push_back(nowNs() - stampOf(item));
+            consumed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    pinToCore(cfg.producerCore);
+    while (!ready.load()) {
+    }
+    T item{};
+    for (size_t i = 0; i < cfg.iterations; ++i) {
+        // One item in flight: the stamp never includes time spent queued
+        while (consumed.load(std::memory_order_acquire) != i) {
+        }
+        stamp(item, nowNs());
+        while (!queue->push(item)) {
+        }
+    }
+    consumer.join();
+    delete queue;
+    report("stream", layout, bytes, samples, pinned);
+}
+
+template <typename T>
+void runLayouts(const Config& cfg, size_t bytes) {
+    using Current = LockFreeQueue<T, kQueueCapacity>;
+    using Padded = PaddedQueue<T, kQueueCapacity>;
+    if (cfg.pingpong) {
+        runPingPong<Current, T>(cfg, "LockFreeQueue", bytes);
+        runPingPong<Padded, T>(cfg, "padded", bytes);
+    }
+    if (cfg.stream) {
+        runStream<Current, T>(cfg, "LockFreeQueue", bytes);
+        runStream<Padded, T>(cfg, "padded", bytes);
+    }
+}
+
+void runPatternBuffer(const Config& cfg) {
+    const size_t bytes = sizeof(DrumBar);
+    if (cfg.pingpong) runPingPong<DrumPatternBuffer, DrumBar>(cfg, "DrumPatternBuffer", bytes);
+    if (cfg.stream) runStream<DrumPatternBuffer, DrumBar>(cfg, "DrumPatternBuffer", bytes);
+}
+
+void usage() {
+    std::printf(
+        "usage: drumcore_pingpong [--cores A,B] [--iterations N] [--mode pingpong|stream|all]\n"
+        "                         [--topology]\n"
+        "  --cores      producer and consumer CPUs (-1 = unpinned), default 0,1\n"
+        "  --iterations samples per run, default 200000\n"
+        "  --topology   print package/SMT siblings of the chosen CPUs\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    bool topology = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--cores" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%d,%d", &cfg.producerCore, &cfg.consumerCore) != 2) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            cfg.iterations = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--mode" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            cfg.pingpong = mode == "pingpong" || mode == "all";
+            cfg.stream = mode == "stream" || mode == "all";
+        } else if (arg == "--topology") {
+            topology = true;
+        } else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    const unsigned cpus = std::thread::hardware_concurrency();
+    std::printf("drumcore SPSC latency: producer cpu %d, consumer cpu %d, %u CPUs, %zu samples\n",
+                cfg.producerCore, cfg.consumerCore, cpus, cfg.iterations);
+    if (topology) {
+        if (cfg.producerCore >= 0) printTopology(cfg.producerCore);
+        if (cfg.consumerCore >= 0) printTopology(cfg.consumerCore);
+    }
+    if (cpus < 2) {
+        std::printf("warning: fewer than 2 CPUs; threads share a core and latencies reflect "
+                    "scheduler time slices\n");
+    }
+    const int maxCore = static_cast<int>(cpus) - 1;
+    bool consumerPinnable = false;
+    std::thread([&] { consumerPinnable = pinToCore(cfg.consumerCore); }).join();
+    if (cfg.producerCore > maxCore || cfg.consumerCore > maxCore || !pinToCore(cfg.producerCore) ||
+        !consumerPinnable) {
+        std::printf("warning: cannot pin to the requested CPUs; running unpinned\n");
+        cfg.producerCore = cfg.consumerCore = -1;
+    }
+
+    runLayouts<Payload<8>>(cfg, 8);
+    runLayouts<Payload<64>>(cfg, 64);
+    runLayouts<Payload<512>>(cfg, 512);
+    runPatternBuffer(cfg);
+    return 0;
+}
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/lockfreequeue.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace JKDigital;
+
+namespace {
+
+template <size_t Bytes>
+struct Payload {
+    unsigned char data[Bytes];
+};
+
+}  // namespace
+
+// Single-threaded push+pop round trip: the uncontended cost per item
+template <size_t Bytes>
+static void BM_LockFreeQueue_PushPop(benchmark::State& state) {
+    LockFreeQueue<Payload<Bytes>, 64> queue;
+    Payload<Bytes> item = {};
+    for (auto _ : state) {
+        queue.push(item);
+        queue.pop(item);
+        benchmark::DoNotOptimize(item);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(Bytes));
+}
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_PushPop, 8);
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_PushPop, 64);
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_PushPop, 512);
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_PushPop, sizeof(DrumBar));
+
+// Producer on the benchmark thread, consumer on a second thread
+template <size_t Bytes>
+static void BM_LockFreeQueue_Throughput(benchmark::State& state) {
+    LockFreeQueue<Payload<Bytes>, 1024> queue;
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+        Payload<Bytes> out;
+        while (!done.load(std::memory_order_relaxed)) {
+            while (queue.pop(out)) benchmark::DoNotOptimize(out);
+        }
+        while (queue.pop(out)) benchmark::DoNotOptimize(out);
+    });
+
+    const Payload<Bytes> item = {};
+    int64_t pushed = 0;
+    for (auto _ : state) {
+        while (!queue.push(item)) {
+        }
+        ++pushed;
+    }
+    done.store(true);
+    consumer.join();
+    state.SetItemsProcessed(pushed);
+    state.SetBytesProcessed(pushed * static_cast<int64_t>(Bytes));
+}
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_Throughput, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_Throughput, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_Throughput, 512)->UseRealTime();
+
+static void BM_DrumPatternBuffer_PushPop(benchmark::State& state) {
+    DrumPatternBuffer buffer;
+    DrumBar bar;
+    bar.steps[0][0].velocity = 1.0f;
+    for (auto _ : state) {
+        buffer.push(bar);
+        buffer.pop(bar);
+        benchmark::DoNotOptimize(bar);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(DrumBar)));
+}
+BENCHMARK(BM_DrumPatternBuffer_PushPop);
@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/samplerenderer.h>
+#include <drumcore/seed.h>
+
+#include <vector>
+
+using namespace JKDigital;
+
+// Ten decaying 200 ms one-shots at 48 kHz, mono
+static SampleKit makeKit() {
+    SampleKit kit(48000.0);
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        Sample s;
+        s.numChannels = 1;
+        s.sampleRate = 48000.0;
+        s.channels[0].resize(9600);
+        for (size_t f = 0; f < s.channels[0].size(); ++f) {
+            const float noise = Seed::toUnitFloat(Seed::splitmix64(f * 10 + i)) - 0.5f;
+            s.channels[0][f] = noise / static_cast<float>(1 + f / 512);
+        }
+        kit.setSample(i, s);
+    }
+    return kit;
+}
+
+// Busy one-bar grooves: kick/snare/hats plus sparse percussion
+static std::vector<DrumBar> makeBars(size_t count) {
+    std::vector<DrumBar> bars(count);
+    for (size_t b = 0; b < count; ++b) {
+        for (int s = 0; s < 32; s += 4) bars[b].steps[2][s] = DrumStep(0.7f, 1.5f, 0);
+        for (int s = 0; s < 32; s += 8) bars[b].steps[0][s] = DrumStep(1.0f, 0.0f, 0);
+        bars[b].steps[1][8] = DrumStep(0.9f, -2.0f, 0);
+        bars[b].steps[1][24] = DrumStep(0.9f, -2.0f, 0);
+        bars[b].steps[3][28] = DrumStep(0.8f, 0.0f, 0);
+        bars[b].steps[4 + b % 6][(b * 5) % 32] = DrumStep(0.5f, 0.0f, DrumStep::FLAG_GHOST);
+    }
+    return bars;
+}
+
+// One stereo one-bar preview
+static void BM_Render_Bar(benchmark::State& state) {
+    const SampleKit kit = makeKit();
+    const std::vector<DrumBar> bars = makeBars(1);
+    const RenderSettings settings;
+    const size_t frames = SampleRenderer::renderFrames(kit, 1, settings);
+    std::vector<float> left(frames), right(frames);
+    for (auto _ : state) {
+        SampleRenderer::render(kit, bars.data(), 1, settings, left.data(), right.data(), frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Render_Bar)->Unit(benchmark::kMicrosecond);
+
+// 64 mono previews, arg = worker threads (0 = caller only)
+static void BM_Render_PreviewBatch(benchmark::State& state) {
+    const SampleKit kit = makeKit();
+    const std::vector<DrumBar> bars = makeBars(64);
+    const RenderSettings settings;
+    const size_t frames = SampleRenderer::renderFrames(kit, 1, settings);
+    std::vector<float> out(bars.size() * frames);
+    ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state) {
+        SampleRenderer::renderBatch(pool, kit, bars.data(), bars.size(), settings, out.data(), 1,
+                                    frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars.size()));
+}
+BENCHMARK(BM_Render_PreviewBatch)
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(7)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/seed.h>
+
+using namespace JKDigital;
+
+static void BM_Seed_NextRandom(benchmark::State& state) {
+    uint64_t rng = Seed::deriveSeed(42, 0, 0);
+    for (auto _ : state) benchmark::DoNotOptimize(Seed::nextRandom(rng));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seed_NextRandom);
+
+static void BM_Seed_RandomFloat(benchmark::State& state) {
+    uint64_t rng = Seed::deriveSeed(42, 0, 0);
+    for (auto _ : state) benchmark::DoNotOptimize(Seed::randomFloat(rng));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seed_RandomFloat);
+
+static void BM_Seed_DeriveSeed(benchmark::State& state) {
+    uint32_t bar = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(Seed::deriveSeed(42, 3, bar++));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seed_DeriveSeed);
+
+static void BM_Seed_FillFloatsBar(benchmark::State& state) {
+    const uint64_t barSeed = Seed::deriveSeed(42, 0, 0);
+    float out[10][32];
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < 10; ++i) Seed::fillFloats(barSeed, i, 0, out[i], 32);
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 320);
+}
+BENCHMARK(BM_Seed_FillFloatsBar);
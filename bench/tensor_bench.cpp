@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/seed.h>
+#include <drumcore/tensordecode.h>
+#include <drumcore/tensorpack.h>
+
+#include <vector>
+
+using namespace JKDigital;
+
+static std::vector<DrumBar> makeBatch(size_t count) {
+    std::vector<DrumBar> bars(count);
+    for (size_t b = 0; b < count; ++b) {
+        for (int s = 0; s < 32; s += 2) {
+            bars[b].steps[b % 10][s] = DrumStep(0.8f, static_cast<float>(s % 7) - 3.0f, 0);
+        }
+    }
+    return bars;
+}
+
+// Batch of 256 bars, arg = TensorLayout
+static void BM_Tensor_PackBatch(benchmark::State& state) {
+    const std::vector<DrumBar> bars = makeBatch(256);
+    TensorBuffer buffer(bars.size());
+    const TensorLayout layout = static_cast<TensorLayout>(state.range(0));
+    for (auto _ : state) {
+        TensorPack::pack(bars.data(), bars.size(), buffer.data(), layout);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(TensorPack::floatsFor(256) * sizeof(float)));
+}
+BENCHMARK(BM_Tensor_PackBatch)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Scalar reference for comparison, arg = TensorLayout
+static void BM_Tensor_PackBatchScalar(benchmark::State& state) {
+    const std::vector<DrumBar> bars = makeBatch(256);
+    TensorBuffer buffer(bars.size());
+    const TensorLayout layout = static_cast<TensorLayout>(state.range(0));
+    for (auto _ : state) {
+        for (size_t b = 0; b < bars.size(); ++b) {
+            TensorPack::detail::packBarScalar(bars[b], buffer.data() + b * TensorPack::kFloatsPerBar,
+                                              layout);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Tensor_PackBatchScalar)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Model output: probabilities skewed low (about 20% above 0.5)
+static std::vector<float> makeOutput(size_t count) {
+    std::vector<float> t(TensorPack::floatsFor(count));
+    for (size_t k = 0; k < t.size(); ++k) t[k] = Seed::toUnitFloat(Seed::splitmix64(k));
+    for (size_t b = 0; b < count; ++b) {
+        float* prob = t.data() + b * TensorPack::kFloatsPerBar + 2 * 320;
+        for (int c = 0; c < 320; ++c) prob[c] = prob[c] * prob[c] * prob[c];
+    }
+    return t;
+}
+
+// Batch of 256 bars, arg = TensorLayout
+static void BM_Tensor_DecodeBatch(benchmark::State& state) {
+    const std::vector<float> t = makeOutput(256);
+    std::vector<DrumBar> bars(256);
+    DecodeParams params;
+    params.hitThreshold = 0.5f;
+    params.maxHits[0] = 4;
+    params.maxHits[1] = 4;
+    const TensorLayout layout = static_cast<TensorLayout>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TensorDecode::decode(t.data(), 256, bars.data(), params, layout));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Tensor_DecodeBatch)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Scalar reference for comparison, arg = TensorLayout
+static void BM_Tensor_DecodeBatchScalar(benchmark::State& state) {
+    const std::vector<float> t = makeOutput(256);
+    std::vector<DrumBar> bars(256);
+    DecodeParams params;
+    params.maxHits[0] = 4;
+    params.maxHits[1] = 4;
+    const TensorLayout layout = static_cast<TensorLayout>(state.range(0));
+    for (auto _ : state) {
+        for (size_t b = 0; b < bars.size(); ++b) {
+            benchmark::DoNotOptimize(TensorDecode::detail::decodeBarScalar(
+                t.data() + b * TensorPack::kFloatsPerBar, bars[b], params, layout));
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Tensor_DecodeBatchScalar)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
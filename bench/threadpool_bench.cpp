@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <drumcore/fillengine.h>
+#include <drumcore/threadpool.h>
+
+#include <vector>
+
+using namespace JKDigital;
+
+// Offline batch: 16384 seeded fill bars, arg = worker threads (0 = serial)
+static void BM_Parallel_GenerateFills(benchmark::State& state) {
+    const size_t count = 16384;
+    ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    DrumBar source;
+    for (int s = 0; s < 32; s += 4) source.steps[2][s].velocity = 0.6f;
+    const FillCandidates candidates = FillEngine::findCandidates(source);
+    const FillVoicing voicing = FillEngine::genreVoicing(DrumBar::Genre::Funk);
+    FillParams params;
+    params.length = FillLength::FullBar;
+    std::vector<DrumBar> bars(count);
+    for (auto _ : state) {
+        Parallel::forEach(pool, 0, count, 64, [&](size_t i) {
+            FillEngine::generate(source, candidates, params, voicing,
+                                 Seed::deriveSeed(42, 0, static_cast<uint32_t>(i)), bars[i]);
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_Parallel_GenerateFills)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(3)
+    ->Arg(7)
+    ->Arg(15)
+    ->Arg(31)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Scheduler overhead: empty chunks, arg = grain
+static void BM_Parallel_EmptyChunks(benchmark::State& state) {
+    ThreadPool pool(ThreadPool::defaultWorkerCount());
+    const size_t grain = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Parallel::forRange(pool, 0, 65536, grain,
+                           [](size_t b, size_t e) { benchmark::DoNotOptimize(b + e); });
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(65536 / grain));
+}
+BENCHMARK(BM_Parallel_EmptyChunks)->Arg(64)->Arg(1024)->UseRealTime();
@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Alias-method weighted sampling tables for probabilistic step generation.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/arena.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// AliasTable - O(1) discrete distribution sampling (Walker/Vose)
+//------------------------------------------------------------------------
+/**
+ * Precomputed discrete distribution using Walker's alias method.
+ *
+ * Building is O(n); each draw is O(1) from a single 64-bit random value
+ * (upper 32 bits pick a column, lower 32 bits pick column or alias).
+ * Fixed capacity. Sampling never allocates. Tables of up to
+ * MAX_STACK_BUILD outcomes build with stack worklists (12 bytes per
+ * outcome), so they are safe to build on any thread, including the audio
+ * thread. Larger tables take their worklists from threadScratch(), which
+ * allocates on a thread's first large build only.
+ *
+ * @tparam MaxSize Maximum number of outcomes
+ */
+template <int MaxSize> class AliasTable {
+    static_assert(MaxSize > 0 && MaxSize <= 65536, "MaxSize must be in 1..65536");
+
+  public:
+    static constexpr int MAX_SIZE = MaxSize;
+
+    /** Largest MaxSize whose build worklists live on the stack (12 KB). */
+    static constexpr int MAX_STACK_BUILD = 1024;
+
+    /** Constructor - initializes empty table. */
+    AliasTable() : size_(0) {}
+
+    /**
+     * Build the table from non-negative weights (need not sum to 1).
+     *
+     * @param weights Weight per outcome
+     * @param count Number of outcomes (1 to MaxSize)
+     * @return false if count is out of range or no weight is positive
+     */
+    bool build(const float* weights, int count) {
+        size_ = 0;
+        if (count <= 0 || count > MaxSize) return false;
+
+        double total = 0.0;
+        for (int i = 0; i < count; ++i) {
+            if (weights[i] > 0.0f) total += weights[i];
+        }
+        if (!(total > 0.0)) return false;
+
+        if constexpr (MaxSize <= MAX_STACK_BUILD) {
+            double scaled[MaxSize];
+            uint16_t small[MaxSize];
+            uint16_t large[MaxSize];
+            fill(weights, count, total, scaled, small, large);
+        } else {
+            ScratchArena& arena = threadScratch();
+            ScratchArena::Scope scope(arena);
+            std::pmr::vector<double> scaled(static_cast<size_t>(count), &arena);
+            std::pmr::vector<uint16_t> small(static_cast<size_t>(count), &arena);
+            std::pmr::vector<uint16_t> large(static_cast<size_t>(count), &arena);
+            fill(weights, count, total, scaled.data(), small.data(), large.data());
+        }
+        size_ = count;
+        return true;
+    }
+
+    /** Number of outcomes (0 if not built). */
+    int size() const { return size_; }
+
+    /** Check if the table has not been built. */
+    bool isEmpty() const { return size_ == 0; }
+
+    /**
+     * Draw an outcome from a 64-bit random value.
+     *
+     * @param random Uniform random value (e.g. from Seed::randomAt)
+     * @return Outcome index in [0, size()), or -1 if empty
+     */
+    int sample(uint64_t random) const {
+        if (size_ == 0) return -1;
+        const uint64_t column = ((random >> 32) * static_cast<uint64_t>(size_)) >> 32;
+        const uint32_t coin = static_cast<uint32_t>(random);
+        return coin < threshold_[column] ? static_cast<int>(column) : alias_[column];
+    }
+
+    /**
+     * Draw an outcome, advancing a Seed::nextRandom state.
+     *
+     * @param state Mutable seed state
+     * @return Outcome index in [0, size()), or -1 if empty
+     */
+    int draw(uint64_t& state) const { return sample(Seed::nextRandom(state)); }
+
+  private:
+    // Vose's algorithm over caller-provided worklists of count entries
+    void fill(const float* weights, int count, double total, double* scaled, uint16_t* small,
+              uint16_t* large) {
+        int numSmall = 0;
+        int numLarge = 0;
+        const double scale = static_cast<double>(count) / total;
+        for (int i = 0; i < count; ++i) {
+            scaled[i] = weights[i] > 0.0f ? weights[i] * scale : 0.0;
+            if (scaled[i] < 1.0) small[numSmall++] = static_cast<uint16_t>(i);
+            else
+                large[numLarge++] = static_cast<uint16_t>(i);
+        }
+
+        while (numSmall > 0 && numLarge > 0) {
+            const uint16_t s = small[--numSmall];
+            const uint16_t l = large[numLarge - 1];
+            threshold_[s] = toThreshold(scaled[s]);
+            alias_[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                --numLarge;
+                small[numSmall++] = l;
+            }
+        }
+        // Leftovers are full columns (exactly 1.0 up to rounding)
+        while (numLarge > 0) {
+            const uint16_t l = large[--numLarge];
+            threshold_[l] = UINT32_MAX;
+            alias_[l] = l;
+        }
+        while (numSmall > 0) {
+            const uint16_t s = small[--numSmall];
+            threshold_[s] = UINT32_MAX;
+            alias_[s] = s;
+        }
+    }
+
+    static uint32_t toThreshold(double p) {
+        if (p <= 0.0) return 0;
+        if (p >= 1.0) return UINT32_MAX;
+        return static_cast<uint32_t>(p * 4294967296.0);
+    }
+
+    uint32_t threshold_[MaxSize];
+    uint16_t alias_[MaxSize];
+    int size_;
+};
+
+//------------------------------------------------------------------------
+// BarSampler - alias tables built from a DrumBar-shaped probability grid
+//------------------------------------------------------------------------
+/**
+ * Sampling tables for generating bars from a 10x32 probability grid.
+ *
+ * Holds an alias table over all 320 cells, one per instrument row over
+ * its 32 steps, and one per instrument over quantized velocity levels.
+ * Whole-bar draws use Seed::randomAt(), so any bar can be drawn
+ * independently of the others.
+ */
+class BarSampler {
+  public:
+    static constexpr int NUM_INSTRUMENTS = DrumBar::NUM_INSTRUMENTS;
+    static constexpr int STEPS_PER_BAR = DrumBar::STEPS_PER_BAR;
+    static constexpr int NUM_CELLS = NUM_INSTRUMENTS * STEPS_PER_BAR;
+
+    /** Maximum number of quantized velocity levels per instrument. */
+    static constexpr int MAX_VELOCITY_LEVELS = 16;
+
+    /** Velocity used by instruments without a velocity distribution. */
+    static constexpr float kDefaultVelocity = 0.8f;
+
+    /** Instrument lane used for drawBar() hit positions. */
+    static constexpr uint32_t kHitLane = 0xFFFE;
+
+    /** Constructor - initializes empty tables. */
+    BarSampler() {
+        for (auto& row : probability_) {
+            for (float& p : row) p = 0.0f;
+        }
+        for (auto& levels : numLevels_) levels = 0;
+    }
+
+    /**
+     * Build cell and step tables from a hit-probability grid.
+     *
+     * @param probability Per-cell hit probability/weight [instrument][step]
+     * @return false if the grid has no positive cell
+     */
+    bool setHitGrid(const float (&probability)[NUM_INSTRUMENTS][STEPS_PER_BAR]) {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                const float p = probability[i][s];
+                probability_[i][s] = p < 0.0f ? 0.0f : (p > 1.0f ? 1.0f : p);
+            }
+            stepTables_[i].build(probability_[i], STEPS_PER_BAR);
+        }
+        return cellTable_.build(&probability_[0][0], NUM_CELLS);
+    }
+
+    /**
+     * Build cell and step tables using a bar's velocities as probabilities.
+     *
+     * Useful for averaged/blended bars where velocity encodes hit likelihood.
+     *
+     * @param bar Source bar
+     * @return false if the bar has no notes
+     */
+    bool setHitGrid(const DrumBar& bar) {
+        float grid[NUM_INSTRUMENTS][STEPS_PER_BAR];
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < STEPS_PER_BAR; ++s) grid[i][s] = bar.steps[i][s].velocity;
+        }
+        return setHitGrid(grid);
+    }
+
+    /**
+     * Set an instrument's velocity distribution.
+     *
+     * Level k of n maps to velocity (k + 1) / n.
+     *
+     * @param instrument Instrument index (0-9)
+     * @param weights Weight per velocity level
+     * @param numLevels Number of levels (1 to MAX_VELOCITY_LEVELS)
+     * @return false if arguments are invalid or no weight is positive
+     */
+    bool setVelocityDistribution(int instrument, const float* weights, int numLevels) {
+        if (instrument < 0 || instrument >= NUM_INSTRUMENTS) return false;
+        if (!velocityTables_[instrument].build(weights, numLevels)) {
+            numLevels_[instrument] = 0;
+            return false;
+        }
+        numLevels_[instrument] = numLevels;
+        return true;
+    }
+
+    /** Hit probability of a cell as stored (clamped to 0.0-1.0). */
+    float probability(int instrument, int step) const { return probability_[instrument][step]; }
+
+    /**
+     * Draw a cell, weighted by probability across the whole grid.
+     *
+     * @param random Uniform random value
+     * @return Cell index (instrument * 32 + step), or -1 if grid is empty
+     */
+    int drawCell(uint64_t random) const { return cellTable_.sample(random); }
+
+    /**
+     * Draw a step for one instrument, weighted by that row's probabilities.
+     *
+     * @return Step index, or -1 if the row is empty
+     */
+    int drawStep(int instrument, uint64_t random) const {
+        return stepTables_[instrument].sample(random);
+    }
+
+    /** Draw a velocity for one instrument from its distribution. */
+    float drawVelocity(int instrument, uint64_t random) const {
+        const int levels = numLevels_[instrument];
+        if (levels == 0) return kDefaultVelocity;
+        const int level = velocityTables_[instrument].sample(random);
+        return static_cast<float>(level + 1) / static_cast<float>(levels);
+    }
+
+    /**
+     * Draw a bar with a fixed number of hits placed by grid weight.
+     *
+     * Hits are drawn with replacement; repeated cells merge, so the bar
+     * may contain fewer than numHits notes. Output is cleared first.
+     *
+     * @param out Destination bar
+     * @param barSeed Seed from Seed::deriveSeed()
+     * @param numHits Number of hit draws
+     */
+    void drawBar(DrumBar& out, uint64_t barSeed, int numHits) const {
+        out.clear();
+        for (int k = 0; k < numHits; ++k) {
+            const uint32_t hit = static_cast<uint32_t>(k);
+            const int cell = drawCell(Seed::randomAt(barSeed, Seed::stepCounter(kHitLane, hit)));
+            if (cell < 0) return;
+            const int inst = cell / STEPS_PER_BAR;
+            const float vel =
+                drawVelocity(inst, Seed::randomAt(barSeed, Seed::stepCounter(kHitLane, hit, 1)));
+            out.steps[inst][cell % STEPS_PER_BAR].velocity = vel;
+        }
+    }
+
+    /**
+     * Draw a bar where each cell hits independently with its probability.
+     *
+     * Output is cleared first. Cell (i, s) uses draws 0 (hit) and 1
+     * (velocity) of Seed::stepCounter(i, s).
+     *
+     * @param out Destination bar
+     * @param barSeed Seed from Seed::deriveSeed()
+     */
+    void drawBarIndependent(DrumBar& out, uint64_t barSeed) const {
+        out.clear();
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            const uint32_t inst = static_cast<uint32_t>(i);
+            for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                const uint32_t step = static_cast<uint32_t>(s);
+                if (Seed::floatAt(barSeed, inst, step) < probability_[i][s]) {
+                    out.steps[i][s].velocity =
+                        drawVelocity(i, Seed::randomAt(barSeed, Seed::stepCounter(inst, step, 1)));
+                }
+            }
+        }
+    }
+
+  private:
+    float probability_[NUM_INSTRUMENTS][STEPS_PER_BAR];
+    AliasTable<NUM_CELLS> cellTable_;
+    AliasTable<STEPS_PER_BAR> stepTables_[NUM_INSTRUMENTS];
+    AliasTable<MAX_VELOCITY_LEVELS> velocityTables_[NUM_INSTRUMENTS];
+    int numLevels_[NUM_INSTRUMENTS];
+};
+
+}  // namespace JKDigital
@@ -0,0 +1,343 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Monotonic scratch arena and bounded pool as std::pmr memory resources.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// ScratchArena - monotonic allocator with checkpoint/rewind
+//------------------------------------------------------------------------
+/**
+ * Monotonic (bump) std::pmr::memory_resource for temporary data.
+ *
+ * Allocation advances a pointer inside the current chunk; deallocation
+ * is a no-op. Memory is reclaimed wholesale by rewinding to a Checkpoint
+ * (or reset()), which keeps every chunk for reuse: once a workload has
+ * run once, repeating it allocates nothing from the upstream resource.
+ *
+ * Chunks come from the upstream resource (global heap by default), start
+ * at the initial size and grow geometrically; oversized requests get a
+ * chunk of their own. No chunk exists until the first allocation.
+ *
+ * One arena per thread (see threadScratch()); not thread-safe. Library
+ * users: PatternLibraryIndex::build, Parallel::reduce, SampleRenderer,
+ * AliasTable::build (tables above MAX_STACK_BUILD outcomes).
+ *
+ *   ScratchArena& arena = threadScratch();
+ *   ScratchArena::Scope scope(arena);        // rewinds on exit
+ *   std::pmr::vector<DrumBar> bars(64, &arena);
+ */
+class ScratchArena : public std::pmr::memory_resource {
+  public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /** Position to rewind to. */
+    struct Checkpoint {
+        void* chunk;
+        size_t offset;
+        size_t bytesInUse;
+    };
+
+    /** Allocator counters since construction (or resetMetrics). */
+    struct Metrics {
+        /** Bytes handed out and not yet rewound (including alignment padding). */
+        size_t bytesInUse = 0;
+        /** High-water mark of bytesInUse. */
+        size_t peakBytes = 0;
+        /** Total size of the chunks held. */
+        size_t capacity = 0;
+        /** allocate() calls. */
+        uint64_t allocations = 0;
+        /** Chunks obtained from the upstream resource. */
+        uint64_t upstreamAllocations = 0;
+        /** rewind() and reset() calls. */
+        uint64_t rewinds = 0;
+    };
+
+    /** RAII checkpoint: rewinds the arena when it goes out of scope. */
+    class Scope {
+      public:
+        explicit Scope(ScratchArena& arena) : arena_(arena), mark_(arena.checkpoint()) {}
+        ~Scope() { arena_.rewind(mark_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        ScratchArena& arena_;
+        Checkpoint mark_;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param initialChunkSize Size of the first chunk (later chunks double)
+     * @param upstream Resource chunks are obtained from
+     */
+    explicit ScratchArena(size_t initialChunkSize = kDefaultChunkSize,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream),
+          nextChunkSize_(initialChunkSize > kHeaderSize ? initialChunkSize : kDefaultChunkSize) {}
+
+    ~ScratchArena() override { release(); }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /** Current position. */
+    Checkpoint checkpoint() const { return {current_, offset_, metrics_.bytesInUse}; }
+
+    /**
+     * Free everything allocated after a checkpoint. Chunks are kept.
+     * Checkpoints taken after this one become invalid.
+     */
+    void rewind(const Checkpoint& mark) {
+        current_ = static_cast<Chunk*>(mark.chunk);
+        offset_ = mark.offset;
+        metrics_.bytesInUse = mark.bytesInUse;
+        ++metrics_.rewinds;
+    }
+
+    /** Free everything; chunks are kept for reuse. */
+    void reset() { rewind({nullptr, 0, 0}); }
+
+    /** Return every chunk to the upstream resource. */
+    void release() {
+        Chunk* chunk = head_;
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next;
+            upstream_->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+            chunk = next;
+        }
+        head_ = nullptr;
+        current_ = nullptr;
+        offset_ = 0;
+        metrics_.bytesInUse = 0;
+        metrics_.capacity = 0;
+    }
+
+    /** Counters (see Metrics). */
+    const Metrics& metrics() const { return metrics_; }
+
+    /** Zero the counters except bytesInUse and capacity. */
+    void resetMetrics() {
+        const Metrics kept = metrics_;
+        metrics_ = Metrics();
+        metrics_.bytesInUse = kept.bytesInUse;
+        metrics_.peakBytes = kept.bytesInUse;
+        metrics_.capacity = kept.capacity;
+    }
+
+    /** Typed array allocation (uninitialized, freed by rewind). */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++metrics_.allocations;
+        if (current_ == nullptr) {
+            if (head_ == nullptr) head_ = newChunk(bytes + alignment, nullptr);
+            current_ = head_;
+            offset_ = kHeaderSize;
+        }
+        for (;;) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(current_);
+            const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(alignment - 1);
+            const size_t end = static_cast<size_t>(aligned - base) + bytes;
+            if (end <= current_->size) {
+                metrics_.bytesInUse += end - offset_;
+                if (metrics_.bytesInUse > metrics_.peakBytes) {
+                    metrics_.peakBytes = metrics_.bytesInUse;
+                }
+                offset_ = end;
+                return reinterpret_cast<void*>(aligned);
+            }
+            // Move to the next retained chunk if it is big enough,
+            // otherwise splice a new one in after the current chunk
+            Chunk* next = current_->next;
+            if (next == nullptr || next->size - kHeaderSize < bytes + alignment) {
+                next = newChunk(bytes + alignment, next);
+                current_->next = next;
+            }
+            current_ = next;
+            offset_ = kHeaderSize;
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+  private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    static constexpr size_t kHeaderSize = sizeof(Chunk);
+
+    /** Chunks stop doubling at this size (larger requests still fit). */
+    static constexpr size_t kMaxGrowthSize = 1024 * 1024;
+
+    Chunk* newChunk(size_t needed, Chunk* next) {
+        size_t size = nextChunkSize_;
+        while (size - kHeaderSize < needed) size *= 2;
+        Chunk* chunk = static_cast<Chunk*>(upstream_->allocate(size, alignof(std::max_align_t)));
+        chunk->next = next;
+        chunk->size = size;
+        nextChunkSize_ = size < kMaxGrowthSize ? size * 2 : size;
+        metrics_.capacity += size;
+        ++metrics_.upstreamAllocations;
+        return chunk;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    size_t nextChunkSize_;
+    Chunk* head_ = nullptr;
+    Chunk* current_ = nullptr;
+    size_t offset_ = 0;
+    Metrics metrics_;
+};
+
+/**
+ * Scratch arena of the calling thread.
+ *
+ * Created on first use; its chunks live until the thread exits. Take a
+ * ScratchArena::Scope around each pass so the next pass reuses the memory.
+ */
+inline ScratchArena& threadScratch() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+//------------------------------------------------------------------------
+// BoundedPool - fixed-size block pool
+//------------------------------------------------------------------------
+/**
+ * std::pmr::memory_resource handing out fixed-size blocks from one slab.
+ *
+ * The slab (blockSize x blockCount) is obtained from the upstream resource
+ * at construction; afterwards allocate/deallocate are O(1) free-list
+ * operations. Requests larger than a block, over-aligned requests and
+ * requests made while the pool is exhausted go to the overflow resource
+ * and are counted, so the bound can be sized from the metrics.
+ *
+ * Not thread-safe.
+ */
+class BoundedPool : public std::pmr::memory_resource {
+  public:
+    /** Allocator counters. */
+    struct Metrics {
+        size_t blocksInUse = 0;
+        size_t peakBlocks = 0;
+        uint64_t allocations = 0;
+        /** Requests served by the overflow resource. */
+        uint64_t overflowAllocations = 0;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param blockSize Bytes per block (rounded up to max_align_t)
+     * @param blockCount Number of blocks in the slab
+     * @param upstream Resource the slab is obtained from
+     * @param overflow Resource for requests the pool cannot serve
+     */
+    BoundedPool(size_t blockSize, size_t blockCount,
+                std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                std::pmr::memory_resource* overflow = std::pmr::new_delete_resource())
+        : blockSize_(roundUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize)),
+          blockCount_(blockCount), upstream_(upstream), overflow_(overflow) {
+        slab_ = static_cast<unsigned char*>(
+            upstream_->allocate(blockSize_ * blockCount_, alignof(std::max_align_t)));
+        for (size_t i = blockCount_; i > 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab_ + (i - 1) * blockSize_);
+            block->next = freeList_;
+            freeList_ = block;
+        }
+    }
+
+    ~BoundedPool() override {
+        upstream_->deallocate(slab_, blockSize_ * blockCount_, alignof(std::max_align_t));
+    }
+
+    BoundedPool(const BoundedPool&) = delete;
+    BoundedPool& operator=(const BoundedPool&) = delete;
+
+    /** Block size in bytes (after rounding). */
+    size_t blockSize() const { return blockSize_; }
+
+    /** Number of blocks in the slab. */
+    size_t blockCount() const { return blockCount_; }
+
+    /** Counters (see Metrics). */
+    const Metrics& metrics() const { return metrics_; }
+
+    /** True if the pointer lies in the slab. */
+    bool owns(const void* p) const {
+        const unsigned char* c = static_cast<const unsigned char*>(p);
+        return c >= slab_ && c < slab_ + blockSize_ * blockCount_;
+    }
+
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++metrics_.allocations;
+        if (bytes > blockSize_ || alignment > alignof(std::max_align_t) || freeList_ == nullptr) {
+            ++metrics_.overflowAllocations;
+            return overflow_->allocate(bytes, alignment);
+        }
+        FreeBlock* block = freeList_;
+        freeList_ = block->next;
+        if (++metrics_.blocksInUse > metrics_.peakBlocks) {
+            metrics_.peakBlocks = metrics_.blocksInUse;
+        }
+        return block;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (!owns(p)) {
+            overflow_->deallocate(p, bytes, alignment);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeList_;
+        freeList_ = block;
+        --metrics_.blocksInUse;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+  private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static size_t roundUp(size_t bytes) {
+        const size_t a = alignof(std::max_align_t);
+        return (bytes + a - 1) & ~(a - 1);
+    }
+
+    size_t blockSize_;
+    size_t blockCount_;
+    std::pmr::memory_resource* upstream_;
+    std::pmr::memory_resource* overflow_;
+    unsigned char* slab_ = nullptr;
+    FreeBlock* freeList_ = nullptr;
+    Metrics metrics_;
+};
+
+}  // namespace JKDigital
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Portable bit manipulation helpers for step masks.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+/**
+ * Bit helpers for 32-step occupancy and active-step masks.
+ *
+ * Bit n of a step mask corresponds to step n of a DrumBar row.
+ */
+namespace BitUtils {
+
+/**
+ * Number of set bits.
+ *
+ * x86 builds without POPCNT (baseline x86-64) use the inline bit-twiddling
+ * version: the builtin would call a libgcc routine there.
+ */
+inline int popcount32(uint32_t x) {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+    return __builtin_popcount(x);
+#elif defined(_MSC_VER)
+    return static_cast<int>(__popcnt(x));
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return static_cast<int>((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+#endif
+}
+
+/** Index of the lowest set bit (x must be non-zero). */
+inline int countTrailingZeros32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while ((x & 1u) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/** Index of the highest set bit (x must be non-zero). */
+inline int highestBit64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while (x >>= 1) ++n;
+    return n;
+#endif
+}
+
+#if defined(DRUMCORE_HAS_SSE2)
+/** Number of set bits in each of four 32-bit lanes. */
+inline __m128i popcount32x4(__m128i x) {
+    const __m128i m1 = _mm_set1_epi32(0x55555555);
+    const __m128i m2 = _mm_set1_epi32(0x33333333);
+    const __m128i m4 = _mm_set1_epi32(0x0F0F0F0F);
+    x = _mm_sub_epi32(x, _mm_and_si128(_mm_srli_epi32(x, 1), m1));
+    x = _mm_add_epi32(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi32(x, 2), m2));
+    x = _mm_and_si128(_mm_add_epi32(x, _mm_srli_epi32(x, 4)), m4);
+    x = _mm_add_epi32(x, _mm_srli_epi32(x, 8));
+    x = _mm_add_epi32(x, _mm_srli_epi32(x, 16));
+    return _mm_and_si128(x, _mm_set1_epi32(0x3F));
+}
+#endif
+
+/** Mask with the lowest `count` bits set (count 0-32). */
+constexpr uint32_t lowMask32(int count) {
+    return count <= 0 ? 0u : (count >= 32 ? 0xFFFFFFFFu : ((1u << count) - 1u));
+}
+
+}  // namespace BitUtils
+}  // namespace JKDigital
@@ -0,0 +1,32 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Build configuration: header-only or separately compiled, SIMD availability.
+//------------------------------------------------------------------------
+
+#pragma once
+
+/**
+ * drumcore is header-only by default. Defining DRUMCORE_SEPARATE_COMPILATION
+ * (done by linking the drumcore::drumcore_impl target) turns the heavier
+ * non-template functions into plain declarations; their definitions, kept
+ * in include/drumcore/impl/ *.ipp, are then compiled once into
+ * drumcore_impl instead of into every including translation unit.
+ *
+ * DRUMCORE_DECL marks those functions: `inline` when header-only, empty
+ * when separately compiled.
+ */
+#if defined(DRUMCORE_SEPARATE_COMPILATION)
+#define DRUMCORE_DECL
+#else
+#define DRUMCORE_DECL inline
+#endif
+
+/**
+ * DRUMCORE_HAS_SSE2 is defined when SSE2 intrinsics can be used (always
+ * on x86-64). Headers with SSE2 kernels include <emmintrin.h> under it
+ * and fall back to scalar loops otherwise.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRUMCORE_HAS_SSE2 1
+#endif
@@ -6,12 +6,34 @@
 
 #pragma once
 
+#include <drumcore/aliastable.h>
+#include <drumcore/arena.h>
+#include <drumcore/bitutils.h>
 #include <drumcore/constants.h>
 #include <drumcore/version.h>
 #include <drumcore/denormalguard.h>
 #include <drumcore/drumgrid.h>
 #include <drumcore/drummapping.h>
+#include <drumcore/fillengine.h>
+#include <drumcore/genreclassifier.h>
 #include <drumcore/genremapper.h>
+#include <drumcore/groove.h>
+#include <drumcore/humanizer.h>
+#include <drumcore/kitmap.h>
 #include <drumcore/lockfreequeue.h>
+#include <drumcore/markovgenerator.h>
+#include <drumcore/midirecorder.h>
+#include <drumcore/noteoffscheduler.h>
+#include <drumcore/patternhistory.h>
+#include <drumcore/patternlibrary.h>
+#include <drumcore/pipeline.h>
+#include <drumcore/rhythmfeatures.h>
+#include <drumcore/rtprofiler.h>
+#include <drumcore/rtsafety.h>
+#include <drumcore/samplerenderer.h>
 #include <drumcore/seed.h>
+#include <drumcore/tensordecode.h>
+#include <drumcore/tensorpack.h>
+#include <drumcore/threadpool.h>
 #include <drumcore/timesignature.h>
+#include <drumcore/trackedbar.h>
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <drumcore/bitutils.h>
+
 #include <atomic>
 #include <cassert>
 #include <cstdint>
@@ -103,6 +105,9 @@ struct DrumBar {
     /** Number of steps per bar (32nd note resolution). */
     static constexpr int STEPS_PER_BAR = 32;
 
+    /** Active-step mask covering every step. */
+    static constexpr uint32_t ALL_STEPS = 0xFFFFFFFFu;
+
     /** Genre classification for pattern generation. */
     enum class Genre {
         Rock = 0,
@@ -172,6 +177,23 @@ struct DrumBar {
         }
     }
 
+    /**
+     * Remove steps with velocity below threshold, visiting only active steps.
+     *
+     * @param threshold Velocity threshold
+     * @param activeMask Bit n set if step n is active (see TimeSignatureDescriptor)
+     */
+    void gateVelocity(float threshold, uint32_t activeMask) {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (uint32_t m = activeMask; m != 0; m &= m - 1) {
+                DrumStep& step = steps[i][BitUtils::countTrailingZeros32(m)];
+                if (step.velocity > 0.0f && step.velocity < threshold) {
+                    step.clear();
+                }
+            }
+        }
+    }
+
     /** Copy all active hits from another bar (output must be pre-cleared). */
     void copyHitsFrom(const DrumBar& src) {
         for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
@@ -183,6 +205,18 @@ struct DrumBar {
         }
     }
 
+    /** Copy hits from another bar on active steps only. */
+    void copyHitsFrom(const DrumBar& src, uint32_t activeMask) {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (uint32_t m = activeMask; m != 0; m &= m - 1) {
+                const int j = BitUtils::countTrailingZeros32(m);
+                if (src.steps[i][j].hasNote()) {
+                    steps[i][j] = src.steps[i][j];
+                }
+            }
+        }
+    }
+
     /** Check if the bar contains any notes. */
     bool hasNotes() const {
         for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
@@ -194,6 +228,28 @@ struct DrumBar {
         }
         return false;
     }
+
+    /** Occupancy bitmask of one instrument row (bit n set if step n has a note). */
+    uint32_t noteMask(int instrument) const {
+        assert(instrument >= 0 && instrument < NUM_INSTRUMENTS);
+        uint32_t mask = 0;
+        for (int j = 0; j < STEPS_PER_BAR; ++j) {
+            mask |= static_cast<uint32_t>(steps[instrument][j].velocity > 0.0f) << j;
+        }
+        return mask;
+    }
+
+    /** Check if the bar contains any notes on active steps. */
+    bool hasNotes(uint32_t activeMask) const {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (uint32_t m = activeMask; m != 0; m &= m - 1) {
+                if (steps[i][BitUtils::countTrailingZeros32(m)].hasNote()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
 };
 
 //------------------------------------------------------------------------
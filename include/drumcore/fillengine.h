@@ -0,0 +1,292 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Seeded fill generation driven by fill-candidate steps.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/bitutils.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+#include <drumcore/timesignature.h>
+
+#include <cstdint>
+
+namespace JKDigital {
+
+/** Portion of the bar a fill replaces, counted back from the bar end. */
+enum class FillLength { LastBeat = 0, HalfBar = 1, FullBar = 2 };
+
+/** Number of FillLength values. */
+constexpr int kNumFillLengths = 3;
+
+/** Fill shape controls. */
+struct FillParams {
+    FillLength length = FillLength::LastBeat;
+
+    /** Hit probability per slot (0.0 = only the final hit, 1.0 = every slot). */
+    float density = 0.6f;
+
+    /** Peak velocity, reached at the end of the fill's crescendo. */
+    float velocity = 0.9f;
+};
+
+/** Genre-specific instrument choice and articulation of a fill. */
+struct FillVoicing {
+    static constexpr int MAX_VOICES = 4;
+
+    /** Instrument rows the fill moves through, start to end. */
+    int voices[MAX_VOICES];
+    int numVoices;
+
+    /** Steps per slot: 1 = 32nds, 2 = 16ths, 4 = 8ths. */
+    int resolution;
+
+    /** Chance of taking the next voice early. */
+    float voiceSpread;
+
+    /** Chance (scaled by density) of a 32nd-note double after a hit. */
+    float rollChance;
+
+    /** Chance of an off-beat hit being a ghost note. */
+    float ghostChance;
+
+    /** Crash (and kick) on the downbeat after the fill. */
+    bool landingCrash;
+};
+
+/** Fill-candidate and fill-window masks of one bar, computed once per bar. */
+struct FillCandidates {
+    /** Steps flagged FLAG_FILL_CANDIDATE, per instrument row. */
+    uint32_t rows[DrumBar::NUM_INSTRUMENTS] = {};
+
+    /** Union of rows. */
+    uint32_t any = 0;
+
+    /** Active steps covered by each FillLength. */
+    uint32_t window[kNumFillLengths] = {};
+
+    /** Beat starts (accent positions). */
+    uint32_t beats = 0;
+};
+
+//------------------------------------------------------------------------
+// FillEngine - seeded fill generation
+//------------------------------------------------------------------------
+/**
+ * Builds fills over the end of a bar.
+ *
+ * Within the fill window the groove rows (everything but kick and crash)
+ * are cleared and replaced by a crescendo moving through the genre's
+ * voices (e.g. snare -> high tom -> low tom). Slots whose step is a fill
+ * candidate in the source bar are preferred: when the window contains
+ * candidates, other slots are hit at half the density. The final slot is
+ * always hit so the fill leads into the next downbeat.
+ *
+ * Every draw comes from Seed::floatAt on the caller's bar seed, so the
+ * result depends only on (source, params, voicing, seed). Generation
+ * visits at most 32 slots with no allocation: cheap enough to run on the
+ * audio thread inside the lookahead before the bar boundary.
+ */
+namespace FillEngine {
+
+// Seed lanes, disjoint from the instrument rows used by other transforms
+constexpr uint32_t kHitLane = 0x100;
+constexpr uint32_t kVoiceLane = 0x101;
+constexpr uint32_t kGhostLane = 0x102;
+constexpr uint32_t kRollLane = 0x103;
+
+// Instrument rows
+constexpr int kKick = 0;
+constexpr int kSnare = 1;
+constexpr int kRim = 4;
+constexpr int kLowTom = 5;
+constexpr int kHighTom = 6;
+constexpr int kCrash = 7;
+constexpr int kPerc = 9;
+
+/** Rows cleared inside the fill window (all but kick and crash). */
+constexpr uint32_t kClearedRows = ((1u << DrumBar::NUM_INSTRUMENTS) - 1) & ~(1u << kKick) &
+                                  ~(1u << kCrash);
+
+/**
+ * Compute the candidate and window masks of a bar.
+ *
+ * @param bar Source bar
+ * @param desc Time signature of the bar
+ */
+inline FillCandidates findCandidates(const DrumBar& bar, const TimeSignatureDescriptor& desc) {
+    FillCandidates c;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        uint32_t mask = 0;
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            mask |= static_cast<uint32_t>(bar.steps[i][s].isFillCandidate()) << s;
+        }
+        c.rows[i] = mask & desc.activeMask;
+        c.any |= c.rows[i];
+    }
+
+    const int active = desc.activeSteps;
+    const int beat = desc.stepsPerBeat > 0 ? desc.stepsPerBeat : active;
+    const int beats = active / beat > 0 ? active / beat : 1;
+    const int lastBeatStart = active > beat ? active - beat : 0;
+    const int halfStart = (beats / 2) * beat;
+    c.window[static_cast<int>(FillLength::LastBeat)] =
+        desc.activeMask & ~BitUtils::lowMask32(lastBeatStart);
+    c.window[static_cast<int>(FillLength::HalfBar)] =
+        desc.activeMask & ~BitUtils::lowMask32(halfStart);
+    c.window[static_cast<int>(FillLength::FullBar)] = desc.activeMask;
+
+    for (int s = 0; s < active; ++s) {
+        if (desc.metricWeight[s] >= TimeSignatureDescriptor::WEIGHT_BEAT) c.beats |= 1u << s;
+    }
+    return c;
+}
+
+/** Candidate and window masks for one of the enum time signatures. */
+inline FillCandidates findCandidates(const DrumBar& bar,
+                                     TimeSignature timeSig = TimeSignature::k4_4) {
+    return findCandidates(bar, TimeSignatureUtils::getDescriptor(timeSig));
+}
+
+/**
+ * Default fill voicing for a genre.
+ *
+ * @param genre Genre to get a voicing for
+ * @return Voicing tuned for the genre
+ */
+inline FillVoicing genreVoicing(DrumBar::Genre genre) {
+    constexpr FillVoicing kVoicings[DrumBar::kNumGenres] = {
+        {{kSnare, kHighTom, kLowTom, kLowTom}, 3, 2, 0.20f, 0.10f, 0.00f, true},   // Rock
+        {{kRim, kHighTom, kLowTom, kLowTom}, 3, 2, 0.25f, 0.05f, 0.10f, true},     // Latin
+        {{kSnare, kHighTom, kLowTom, kLowTom}, 3, 2, 0.20f, 0.25f, 0.30f, true},   // Funk
+        {{kSnare, kHighTom, kSnare, kLowTom}, 4, 2, 0.30f, 0.05f, 0.35f, true},    // Jazz
+        {{kSnare, kPerc, kSnare, kSnare}, 2, 2, 0.20f, 0.30f, 0.10f, false},       // HipHop
+        {{kHighTom, kLowTom, kPerc, kPerc}, 3, 2, 0.25f, 0.05f, 0.10f, true},      // Afrobeat
+        {{kSnare, kHighTom, kSnare, kSnare}, 2, 2, 0.15f, 0.35f, 0.25f, true},     // NewOrleans
+        {{kRim, kHighTom, kLowTom, kLowTom}, 3, 2, 0.25f, 0.05f, 0.10f, true},     // Afrocuban
+        {{kSnare, kHighTom, kLowTom, kLowTom}, 3, 2, 0.20f, 0.10f, 0.00f, true},   // Other
+        {{kSnare, kHighTom, kLowTom, kLowTom}, 3, 2, 0.20f, 0.10f, 0.00f, true}};  // Uncertain
+
+    int index = static_cast<int>(genre);
+    if (index < 0 || index >= DrumBar::kNumGenres) index = 0;
+    return kVoicings[index];
+}
+
+/**
+ * Generate a fill over the end of a bar.
+ *
+ * out receives a copy of source with role Fill and the fill window
+ * rewritten. source and out may be the same bar.
+ *
+ * @param source Bar to build the fill on
+ * @param candidates Masks from findCandidates(source, ...)
+ * @param params Length, density and velocity
+ * @param voicing Instruments and articulation (see genreVoicing)
+ * @param barSeed Seed from Seed::deriveSeed() for this transform and bar
+ * @param out Destination bar
+ */
+inline void generate(const DrumBar& source, const FillCandidates& candidates,
+                     const FillParams& params, const FillVoicing& voicing, uint64_t barSeed,
+                     DrumBar& out) {
+    if (&out != &source) out = source;
+    out.role = DrumBar::Role::Fill;
+
+    int length = static_cast<int>(params.length);
+    if (length < 0 || length >= kNumFillLengths) length = 0;
+    const uint32_t window = candidates.window[length];
+    if (window == 0) return;
+
+    for (uint32_t rows = kClearedRows; rows != 0; rows &= rows - 1) {
+        DrumStep* row = out.steps[BitUtils::countTrailingZeros32(rows)];
+        for (uint32_t m = window; m != 0; m &= m - 1) {
+            row[BitUtils::countTrailingZeros32(m)].clear();
+        }
+    }
+
+    const uint32_t grid = voicing.resolution >= 4   ? 0x11111111u
+                          : voicing.resolution >= 2 ? 0x55555555u
+                                                    : 0xFFFFFFFFu;
+    uint32_t slots = window & grid;
+    if (slots == 0) slots = 1u << BitUtils::highestBit64(window);
+    const uint32_t preferred = candidates.any & slots;
+    const float density =
+        params.density < 0.0f ? 0.0f : (params.density > 1.0f ? 1.0f : params.density);
+    const int numVoices = voicing.numVoices < 1 ? 1
+                          : voicing.numVoices > FillVoicing::MAX_VOICES ? FillVoicing::MAX_VOICES
+                                                                         : voicing.numVoices;
+
+    const int numSlots = BitUtils::popcount32(slots);
+    int slot = 0;
+    for (uint32_t m = slots; m != 0; m &= m - 1, ++slot) {
+        const int s = BitUtils::countTrailingZeros32(m);
+        const uint32_t step = static_cast<uint32_t>(s);
+        const bool last = (m & (m - 1)) == 0;
+        const bool isCandidate = ((preferred >> s) & 1u) != 0;
+        const float p = preferred == 0 || isCandidate ? density : 0.5f * density;
+        if (!last && Seed::floatAt(barSeed, kHitLane, step) >= p) continue;
+
+        // Crescendo and voice progression over the fill
+        const float t = numSlots > 1 ? static_cast<float>(slot) / static_cast<float>(numSlots - 1)
+                                     : 1.0f;
+        int v = static_cast<int>(t * static_cast<float>(numVoices));
+        v = v >= numVoices ? numVoices - 1 : v;
+        if (v + 1 < numVoices && Seed::floatAt(barSeed, kVoiceLane, step) < voicing.voiceSpread) {
+            ++v;
+        }
+        const int instrument = voicing.voices[v];
+
+        const bool onBeat = ((candidates.beats >> s) & 1u) != 0;
+        float velocity = params.velocity * (0.7f + 0.3f * t);
+        uint8_t flags = DrumStep::FLAG_FILL_CANDIDATE;
+        if (onBeat || last) {
+            flags |= DrumStep::FLAG_ACCENT;
+        } else if (Seed::floatAt(barSeed, kGhostLane, step) < voicing.ghostChance) {
+            velocity *= 0.45f;
+            flags = DrumStep::FLAG_GHOST;
+        }
+        velocity = velocity > 1.0f ? 1.0f : velocity;
+        out.steps[instrument][s] = DrumStep(velocity, 0.0f, flags);
+
+        // 32nd-note double into the next step
+        const int next = s + 1;
+        if (next < DrumBar::STEPS_PER_BAR && ((window >> next) & 1u) != 0 &&
+            Seed::floatAt(barSeed, kRollLane, step) < voicing.rollChance * density) {
+            const uint8_t rollFlags = static_cast<uint8_t>(flags & ~DrumStep::FLAG_ACCENT);
+            out.steps[instrument][next] = DrumStep(velocity * 0.8f, 0.0f, rollFlags);
+        }
+    }
+}
+
+/**
+ * Generate a fill using the source bar's genre voicing.
+ *
+ * @param source Bar to build the fill on
+ * @param params Length, density and velocity
+ * @param barSeed Seed from Seed::deriveSeed() for this transform and bar
+ * @param out Destination bar
+ * @param timeSig Time signature of the bar
+ */
+inline void generate(const DrumBar& source, const FillParams& params, uint64_t barSeed,
+                     DrumBar& out, TimeSignature timeSig = TimeSignature::k4_4) {
+    generate(source, findCandidates(source, timeSig), params, genreVoicing(source.genre), barSeed,
+             out);
+}
+
+/**
+ * Add the landing after a fill to the following bar: crash and kick on
+ * the downbeat (no-op for voicings without a landing crash).
+ *
+ * @param next Bar following the fill
+ * @param voicing Voicing used for the fill
+ * @param velocity Landing velocity
+ */
+inline void land(DrumBar& next, const FillVoicing& voicing, float velocity = 1.0f) {
+    if (!voicing.landingCrash) return;
+    next.steps[kCrash][0] = DrumStep(velocity, 0.0f, DrumStep::FLAG_ACCENT);
+    if (!next.steps[kKick][0].hasNote()) next.steps[kKick][0] = DrumStep(velocity, 0.0f, 0);
+}
+
+}  // namespace FillEngine
+}  // namespace JKDigital
@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Lightweight on-device genre classifier over rhythmic features.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/rhythmfeatures.h>
+#include <drumcore/timesignature.h>
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// GenreClassifier - linear softmax classifier with embedded weights
+//------------------------------------------------------------------------
+/**
+ * Linear classifier mapping RhythmFeatures to a DrumBar::Genre.
+ *
+ * Scores are W * x + b over the nine concrete genres (Rock..Other),
+ * converted to a confidence with a softmax. Bars without onsets, or whose
+ * best confidence falls below the threshold, are labeled Uncertain.
+ * With SSE2 the softmax uses a polynomial exp (within a few ulp of
+ * std::exp), four classes at a time.
+ *
+ * The embedded default weights are derived from per-genre prototype
+ * feature vectors (nearest-centroid in a scaled feature space, which is
+ * linear). Trained weights can be installed with setWeights().
+ */
+class GenreClassifier {
+  public:
+    static constexpr int NUM_FEATURES = RhythmFeatures::NUM_FEATURES;
+
+    /** Number of scored genres (all except Uncertain). */
+    static constexpr int NUM_CLASSES = DrumBar::kNumGenres - 1;
+
+    /** Default minimum confidence for a concrete genre label. */
+    static constexpr float kDefaultMinConfidence = 0.35f;
+
+    /** Classification result. */
+    struct Result {
+        DrumBar::Genre genre;
+        float confidence;
+    };
+
+    /** Constructor - installs the embedded default weights. */
+    GenreClassifier();
+
+    /**
+     * Install trained weights.
+     *
+     * @param weights Weight per class (Rock..Other) and feature
+     * @param bias Bias per class
+     */
+    void setWeights(const float (&weights)[NUM_CLASSES][NUM_FEATURES],
+                    const float (&bias)[NUM_CLASSES]) {
+        for (int g = 0; g < NUM_CLASSES; ++g) {
+            for (int f = 0; f < NUM_FEATURES; ++f) weights_[f][g] = weights[g][f];
+            bias_[g] = bias[g];
+        }
+    }
+
+    /** Set the minimum confidence for a concrete genre label. */
+    void setMinConfidence(float minConfidence) { minConfidence_ = minConfidence; }
+
+    /** Classify a feature vector. */
+    Result classify(const RhythmFeatures& features) const {
+        if (features.onsetCount == 0) return {DrumBar::Genre::Uncertain, 0.0f};
+
+        // Feature-major so each feature updates all class scores at once
+        float scores[kPaddedClasses];
+        for (int g = 0; g < kPaddedClasses; ++g) scores[g] = bias_[g];
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            const float x = features.values[f];
+            for (int g = 0; g < kPaddedClasses; ++g) scores[g] += weights_[f][g] * x;
+        }
+        int best = 0;
+        for (int g = 1; g < NUM_CLASSES; ++g) {
+            if (scores[g] > scores[best]) best = g;
+        }
+
+        const float confidence = 1.0f / softmaxDenominator(scores, scores[best]);
+
+        if (confidence < minConfidence_) return {DrumBar::Genre::Uncertain, confidence};
+        return {static_cast<DrumBar::Genre>(best), confidence};
+    }
+
+    /** Classify a bar. */
+    Result classify(const DrumBar& bar, TimeSignature timeSig = TimeSignature::k4_4) const {
+        return classify(RhythmAnalysis::extract(bar, timeSig));
+    }
+
+    /**
+     * Classify a batch of bars sharing one time signature.
+     *
+     * @param bars Bars to classify
+     * @param count Number of bars
+     * @param out Result per bar
+     * @param timeSig Time signature of the bars
+     */
+    void classifyBatch(const DrumBar* bars, size_t count, Result* out,
+                       TimeSignature timeSig = TimeSignature::k4_4) const {
+        const int t = static_cast<int>(timeSig);
+        const RhythmAnalysis::MetricMasks& masks =
+            RhythmAnalysis::kMetricMasks[(t >= 0 && t < kNumTimeSignatures) ? t : 0];
+        RhythmFeatures features;
+        for (size_t b = 0; b < count; ++b) {
+            RhythmAnalysis::extract(bars[b], masks, features);
+            out[b] = classify(features);
+        }
+    }
+
+  private:
+    // Class count rounded up to whole SIMD vectors; padding classes score 0
+    static constexpr int kPaddedClasses = (NUM_CLASSES + 3) & ~3;
+
+    // Terms below exp(-20) cannot change a sum that is at least 1
+    static constexpr float kNegligible = -20.0f;
+
+    // Sum of exp(score - top) over the classes; top is the best score
+    static float softmaxDenominator(const float (&scores)[kPaddedClasses], float top) {
+#if defined(DRUMCORE_HAS_SSE2)
+        // Cephes-style expf: 2^n * e^r with |r| <= ln2/2, degree-5 polynomial
+        const __m128 topv = _mm_set1_ps(top);
+        const __m128 cutoff = _mm_set1_ps(kNegligible);
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 sum = _mm_setzero_ps();
+        for (int g = 0; g < kPaddedClasses; g += 4) {
+            const __m128 d = _mm_sub_ps(_mm_loadu_ps(scores + g), topv);
+            const int valid = g + 4 <= NUM_CLASSES ? 0xF : (1 << (NUM_CLASSES - g)) - 1;
+            const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+            const __m128 inClass = _mm_castsi128_ps(_mm_cmpeq_epi32(
+                _mm_and_si128(_mm_set1_epi32(valid), laneBits), laneBits));
+            const __m128 keep = _mm_and_ps(_mm_cmpgt_ps(d, cutoff), inClass);
+            const __m128 x = _mm_max_ps(d, cutoff);
+
+            __m128 n = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504f)), _mm_set1_ps(0.5f));
+            const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(n));
+            n = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, n), one));  // floor
+            __m128 r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+            r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(-2.12194440e-4f)));
+
+            __m128 p = _mm_set1_ps(1.9875691500e-4f);
+            p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.3981999507e-3f));
+            p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(8.3334519073e-3f));
+            p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(4.1665795894e-2f));
+            p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.6666665459e-1f));
+            p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(5.0000001201e-1f));
+            p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r), r), r), one);
+
+            const __m128i exponent =
+                _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+            const __m128 e = _mm_mul_ps(p, _mm_castsi128_ps(exponent));
+            sum = _mm_add_ps(sum, _mm_and_ps(keep, e));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+        float sum = 0.0f;
+        for (int g = 0; g < NUM_CLASSES; ++g) {
+            const float d = scores[g] - top;
+            if (d > kNegligible) sum += std::exp(d);
+        }
+        return sum;
+#endif
+    }
+
+    float weights_[NUM_FEATURES][kPaddedClasses] = {};
+    float bias_[kPaddedClasses] = {};
+    float minConfidence_;
+};
+
+}  // namespace JKDigital
+
+#if !defined(DRUMCORE_SEPARATE_COMPILATION)
+#include <drumcore/impl/genreclassifier.ipp>
+#endif
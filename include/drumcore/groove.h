@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Swing and groove templates applied as timing-offset maps.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/timesignature.h>
+
+namespace JKDigital {
+
+/** Unit of GrooveTemplate timing values. */
+enum class GrooveUnit {
+    /** Absolute milliseconds (feel tightens relative to the grid as tempo rises). */
+    Milliseconds = 0,
+    /** Fraction of one 32nd-note step (feel scales with tempo). */
+    StepFraction = 1
+};
+
+/** Subdivision whose off-beats are delayed by swing. */
+enum class SwingResolution { Sixteenth = 0, Eighth = 1 };
+
+//------------------------------------------------------------------------
+// GrooveTemplate - per-step timing and velocity offset map
+//------------------------------------------------------------------------
+/**
+ * Per-step timing and velocity offset map describing a feel.
+ *
+ * Steps at or beyond activeSteps (from the TimeSignature) carry no offset.
+ */
+struct GrooveTemplate {
+    static constexpr int STEPS_PER_BAR = DrumBar::STEPS_PER_BAR;
+
+    /** Timing offset per step, in `unit`. */
+    float timing[STEPS_PER_BAR];
+
+    /** Velocity multiplier per step (1.0 = unchanged). */
+    float velocityScale[STEPS_PER_BAR];
+
+    /** Unit of the timing values. */
+    GrooveUnit unit;
+
+    /** Number of steps the template covers. */
+    int activeSteps;
+
+    /** Default constructor - straight 4/4 template. */
+    GrooveTemplate() : unit(GrooveUnit::StepFraction), activeSteps(STEPS_PER_BAR) {
+        for (int s = 0; s < STEPS_PER_BAR; ++s) {
+            timing[s] = 0.0f;
+            velocityScale[s] = 1.0f;
+        }
+    }
+
+    /** Straight (no offset) template for a time signature. */
+    static GrooveTemplate straight(TimeSignature timeSig) {
+        GrooveTemplate groove;
+        groove.activeSteps = TimeSignatureUtils::getActiveSteps(timeSig);
+        return groove;
+    }
+
+    /**
+     * Swing template.
+     *
+     * Off-beats of each subdivision pair, counted from the bar start, are
+     * delayed. amount 0.0 is straight, 1.0 is full triplet swing (off-beat
+     * at 2/3 of the pair); values in between interpolate linearly.
+     *
+     * @param amount Swing amount (0.0-1.0)
+     * @param timeSig Time signature (sets the active steps)
+     * @param resolution Subdivision to swing
+     * @param offbeatVelocity Velocity multiplier for swung off-beats
+     */
+    static GrooveTemplate swing(float amount, TimeSignature timeSig,
+                                SwingResolution resolution = SwingResolution::Sixteenth,
+                                float offbeatVelocity = 1.0f) {
+        GrooveTemplate groove = straight(timeSig);
+        const int pair = resolution == SwingResolution::Sixteenth ? 4 : 8;
+        const float delay = amount * static_cast<float>(pair) / 6.0f;
+        for (int s = pair / 2; s < groove.activeSteps; s += pair) {
+            groove.timing[s] = delay;
+            groove.velocityScale[s] = offbeatVelocity;
+        }
+        return groove;
+    }
+
+    /**
+     * Copy of this template with timing converted to another unit.
+     *
+     * @param target Desired unit
+     * @param tempoBpm Tempo used for the conversion
+     */
+    GrooveTemplate converted(GrooveUnit target, double tempoBpm) const {
+        GrooveTemplate out = *this;
+        if (target == unit) return out;
+        const float stepMs = stepDurationMs(tempoBpm);
+        const float factor = target == GrooveUnit::Milliseconds ? stepMs : 1.0f / stepMs;
+        for (int s = 0; s < STEPS_PER_BAR; ++s) out.timing[s] = timing[s] * factor;
+        out.unit = target;
+        return out;
+    }
+
+    /**
+     * Interpolate between two templates.
+     *
+     * The result uses a's unit and the larger active step count; b is
+     * converted to a's unit at tempoBpm if the units differ.
+     *
+     * @param a Template at t = 0.0
+     * @param b Template at t = 1.0
+     * @param t Interpolation position
+     * @param tempoBpm Tempo for unit conversion
+     */
+    static GrooveTemplate blend(const GrooveTemplate& a, const GrooveTemplate& b, float t,
+                                double tempoBpm = Constants::kDefaultTempo) {
+        const GrooveTemplate bb = b.converted(a.unit, tempoBpm);
+        GrooveTemplate out = a;
+        out.activeSteps = a.activeSteps > b.activeSteps ? a.activeSteps : b.activeSteps;
+        for (int s = 0; s < STEPS_PER_BAR; ++s) {
+            out.timing[s] = a.timing[s] + (bb.timing[s] - a.timing[s]) * t;
+            out.velocityScale[s] =
+                a.velocityScale[s] + (bb.velocityScale[s] - a.velocityScale[s]) * t;
+        }
+        return out;
+    }
+
+    /** Duration of one 32nd-note step in milliseconds. */
+    static float stepDurationMs(double tempoBpm) {
+        if (tempoBpm <= 0.0) tempoBpm = Constants::kDefaultTempo;
+        return static_cast<float>(60000.0 / tempoBpm * Constants::kBeatsPerStep);
+    }
+};
+
+//------------------------------------------------------------------------
+// Groove - applying and extracting templates
+//------------------------------------------------------------------------
+namespace Groove {
+
+/** Smallest velocity a grooved note can reach (MIDI velocity 1). */
+constexpr float kMinVelocity = 1.0f / 127.0f;
+
+/**
+ * Apply a groove template to a run of bars in one pass.
+ *
+ * Timing is resolved to milliseconds once, then added to every note's
+ * timingOffsetMs and velocities are scaled, with clamping to the
+ * Constants limits and note masking fused into the same loop.
+ *
+ * @param bars Bars to modify
+ * @param numBars Number of bars
+ * @param groove Template to apply
+ * @param tempoBpm Current tempo (used for StepFraction templates)
+ * @param amount Template intensity (0.0 = none, 1.0 = full)
+ */
+DRUMCORE_DECL void apply(DrumBar* bars, int numBars, const GrooveTemplate& groove, double tempoBpm,
+                         float amount = 1.0f);
+
+/** Apply a groove template to a single bar. */
+inline void apply(DrumBar& bar, const GrooveTemplate& groove, double tempoBpm,
+                  float amount = 1.0f) {
+    apply(&bar, 1, groove, tempoBpm, amount);
+}
+
+/**
+ * Extract a groove template from recorded bars.
+ *
+ * For each step, timing is the mean timingOffsetMs of all notes on that
+ * step and velocityScale is the mean velocity on that step relative to the
+ * mean velocity of all notes. Steps with no notes stay neutral.
+ *
+ * @param bars Recorded bars
+ * @param numBars Number of bars
+ * @param tempoBpm Tempo the bars were recorded at
+ * @param timeSig Time signature of the bars
+ * @param unit Unit of the returned template
+ * @return Extracted template
+ */
+DRUMCORE_DECL GrooveTemplate extract(const DrumBar* bars, int numBars, double tempoBpm,
+                                     TimeSignature timeSig,
+                                     GrooveUnit unit = GrooveUnit::StepFraction);
+
+}  // namespace Groove
+}  // namespace JKDigital
+
+#if !defined(DRUMCORE_SEPARATE_COMPILATION)
+#include <drumcore/impl/groove.ipp>
+#endif
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Deterministic timing and velocity humanization.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+
+#include <cstdint>
+
+namespace JKDigital {
+
+/** Shape of the random deviation applied by the humanizer. */
+enum class JitterDistribution { Uniform = 0, Triangular = 1, Gaussian = 2 };
+
+/**
+ * Humanization amounts for a single instrument row.
+ */
+struct HumanizeInstrumentProfile {
+    /** Velocity deviation (normalized velocity units, 0.0-1.0). */
+    float velocityAmount;
+
+    /** Timing deviation in milliseconds. */
+    float timingAmountMs;
+
+    /** Constant timing push (<0) or drag (>0) in milliseconds. */
+    float timingBiasMs;
+};
+
+/**
+ * Complete humanization profile for a bar.
+ *
+ * For Uniform and Triangular distributions the amounts are the peak
+ * deviation. For Gaussian they are two standard deviations, so ~95% of
+ * deviations stay within the amount.
+ */
+struct HumanizeProfile {
+    /** Per-instrument amounts, indexed like DrumBar::steps. */
+    HumanizeInstrumentProfile instruments[DrumBar::NUM_INSTRUMENTS] = {};
+
+    /** Shape of the velocity and timing deviations. */
+    JitterDistribution distribution = JitterDistribution::Gaussian;
+
+    /** Velocity deviation multiplier for ghost notes. */
+    float ghostVelocityScale = 0.5f;
+
+    /** Timing deviation multiplier for ghost notes (ghosts sit looser). */
+    float ghostTimingScale = 1.5f;
+
+    /** Velocity deviation multiplier for accented notes. */
+    float accentVelocityScale = 0.5f;
+
+    /** Timing deviation multiplier for accented notes (accents sit tighter). */
+    float accentTimingScale = 0.6f;
+
+    /** Peak ensemble timing drift in milliseconds, shared by all instruments. */
+    float driftAmountMs = 0.0f;
+
+    /** Distance in bars between drift control points (phrase length). */
+    int32_t driftPhraseBars = 4;
+
+    /** Profile with the same amounts on every instrument. */
+    static HumanizeProfile uniform(float velocityAmount, float timingAmountMs) {
+        HumanizeProfile profile;
+        for (auto& inst : profile.instruments) {
+            inst = {velocityAmount, timingAmountMs, 0.0f};
+        }
+        return profile;
+    }
+};
+
+/**
+ * Seeded humanization of DrumBar velocity and timing.
+ *
+ * All random values come from Seed::randomAt() keyed on
+ * Seed::deriveSeed(masterSeed, transformIndex, barIndex), so results are
+ * identical regardless of processing order or thread. Only steps with a
+ * note are modified; velocities stay in (0.0, 1.0] and timing offsets stay
+ * within Constants::kMinTimingOffsetMs..kMaxTimingOffsetMs.
+ */
+namespace Humanizer {
+
+/** Smallest velocity a humanized note can reach (MIDI velocity 1). */
+constexpr float kMinHumanizedVelocity = 1.0f / 127.0f;
+
+/** Draw indices used per grid cell (see Seed::stepCounter). */
+constexpr uint32_t kVelocityDraw = 0;
+constexpr uint32_t kTimingDraw = 2;
+
+/** Instrument lane used for drift control points. */
+constexpr uint32_t kDriftLane = 0xFFFF;
+
+/**
+ * Deviation in units of the profile amount for one grid cell.
+ *
+ * @param barSeed Seed from Seed::deriveSeed()
+ * @param instrument Instrument index (0-9)
+ * @param step Step index (0-31)
+ * @param draw First draw index (Gaussian consumes draw and draw + 1)
+ * @param dist Distribution shape
+ * @return Deviation, mostly within [-1.0, 1.0]
+ */
+inline float jitter(uint64_t barSeed, uint32_t instrument, uint32_t step, uint32_t draw,
+                    JitterDistribution dist) {
+    const uint64_t r0 = Seed::randomAt(barSeed, Seed::stepCounter(instrument, step, draw));
+    constexpr float kScale = 1.0f / static_cast<float>(1 << 24);
+    const float u0 = static_cast<float>(r0 >> 40) * kScale;
+    const float u1 = static_cast<float>((r0 >> 16) & 0xFFFFFF) * kScale;
+
+    switch (dist) {
+    case JitterDistribution::Uniform: return 2.0f * u0 - 1.0f;
+    case JitterDistribution::Triangular: return u0 + u1 - 1.0f;
+    case JitterDistribution::Gaussian:
+    default: {
+        // Irwin-Hall approximation: sum of four uniforms, std scaled to 0.5
+        const uint64_t r1 =
+            Seed::randomAt(barSeed, Seed::stepCounter(instrument, step, draw + 1));
+        const float u2 = static_cast<float>(r1 >> 40) * kScale;
+        const float u3 = static_cast<float>((r1 >> 16) & 0xFFFFFF) * kScale;
+        return (u0 + u1 + u2 + u3 - 2.0f) * 0.8660254f;
+    }
+    }
+}
+
+/**
+ * Ensemble timing drift at a position in the phrase.
+ *
+ * Random control points every profile.driftPhraseBars bars are joined
+ * with smoothstep interpolation, so drift is continuous across bar lines.
+ *
+ * @param profile Profile supplying drift amount and phrase length
+ * @param masterSeed The global master seed
+ * @param transformIndex Index of the humanize transform in the chain
+ * @param barIndex Bar index in the pattern
+ * @param step Step index (0-31)
+ * @return Drift in milliseconds
+ */
+DRUMCORE_DECL float phraseDrift(const HumanizeProfile& profile, uint64_t masterSeed,
+                                uint32_t transformIndex, uint32_t barIndex, int step);
+
+/**
+ * Default humanization profile for a genre.
+ *
+ * @param genre Genre to get a profile for
+ * @return Profile tuned for the genre's feel
+ */
+DRUMCORE_DECL HumanizeProfile genreProfile(DrumBar::Genre genre);
+
+/**
+ * Humanize one bar in place.
+ *
+ * Each instrument row is processed as a plane: deviations for all 32 steps
+ * are generated first (no carried state), then applied with clamping and
+ * note masking in a single pass.
+ *
+ * @param bar Bar to modify
+ * @param profile Humanization profile
+ * @param masterSeed The global master seed
+ * @param transformIndex Index of the humanize transform in the chain
+ * @param barIndex Bar index in the pattern (seed and drift position)
+ * @param amount Global intensity (0.0 = no change, 1.0 = full profile)
+ */
+DRUMCORE_DECL void humanizeBar(DrumBar& bar, const HumanizeProfile& profile, uint64_t masterSeed,
+                               uint32_t transformIndex, uint32_t barIndex, float amount = 1.0f);
+
+/**
+ * Humanize a multi-bar pattern in place.
+ *
+ * Equivalent to calling humanizeBar() for each bar with barIndex
+ * firstBarIndex + i, so drift is continuous across the pattern.
+ *
+ * @param bars Array of bars to modify
+ * @param numBars Number of bars
+ * @param profile Humanization profile
+ * @param masterSeed The global master seed
+ * @param transformIndex Index of the humanize transform in the chain
+ * @param firstBarIndex Bar index of bars[0]
+ * @param amount Global intensity (0.0 = no change, 1.0 = full profile)
+ */
+DRUMCORE_DECL void humanizePattern(DrumBar* bars, int numBars, const HumanizeProfile& profile,
+                                   uint64_t masterSeed, uint32_t transformIndex,
+                                   uint32_t firstBarIndex = 0, float amount = 1.0f);
+
+}  // namespace Humanizer
+}  // namespace JKDigital
+
+#if !defined(DRUMCORE_SEPARATE_COMPILATION)
+#include <drumcore/impl/humanizer.ipp>
+#endif
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Out-of-line definitions for genreclassifier.h.
+//------------------------------------------------------------------------
+
+#pragma once
+
+namespace JKDigital {
+
+DRUMCORE_DECL GenreClassifier::GenreClassifier() : minConfidence_(kDefaultMinConfidence) {
+    // Per-feature scale: roughly the spread of each feature across genres
+    constexpr float kScale[NUM_FEATURES] = {0.04f, 0.04f, 0.1f, 0.03f, 0.04f, 0.03f,
+                                            0.03f, 0.02f, 0.1f, 0.05f, 0.15f, 0.25f,
+                                            0.1f,  0.03f, 0.02f, 0.25f};
+    // Prototype feature vectors, one row per genre Rock..Other
+    constexpr float kPrototype[NUM_CLASSES][NUM_FEATURES] = {
+        // Kick  Snare  CHH    OHH    Rim    LTom   HTom   Crash  Ride   Perc
+        // Sync  Back   Off    VelVar Total  RideShare
+        {0.09f, 0.0625f, 0.25f, 0.02f, 0.0f, 0.01f, 0.01f, 0.02f, 0.02f, 0.0f,  // Rock
+         0.05f, 0.95f, 0.3f, 0.01f, 0.045f, 0.05f},
+        {0.09f, 0.03f, 0.2f, 0.02f, 0.12f, 0.05f, 0.05f, 0.01f, 0.05f, 0.15f,  // Latin
+         0.45f, 0.2f, 0.35f, 0.03f, 0.08f, 0.2f},
+        {0.16f, 0.12f, 0.4f, 0.04f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f,  // Funk
+         0.5f, 0.9f, 0.3f, 0.06f, 0.08f, 0.02f},
+        {0.05f, 0.08f, 0.0625f, 0.0f, 0.02f, 0.01f, 0.01f, 0.01f, 0.3f, 0.0f,  // Jazz
+         0.35f, 0.3f, 0.2f, 0.05f, 0.055f, 0.85f},
+        {0.12f, 0.0625f, 0.3f, 0.02f, 0.02f, 0.0f, 0.0f, 0.01f, 0.0f, 0.03f,  // HipHop
+         0.4f, 0.95f, 0.25f, 0.03f, 0.06f, 0.0f},
+        {0.12f, 0.1f, 0.35f, 0.06f, 0.03f, 0.03f, 0.03f, 0.01f, 0.02f, 0.1f,  // Afrobeat
+         0.5f, 0.5f, 0.35f, 0.04f, 0.09f, 0.05f},
+        {0.12f, 0.2f, 0.1f, 0.01f, 0.03f, 0.02f, 0.02f, 0.02f, 0.08f, 0.01f,  // NewOrleans
+         0.55f, 0.6f, 0.3f, 0.06f, 0.06f, 0.4f},
+        {0.08f, 0.02f, 0.1f, 0.01f, 0.1f, 0.08f, 0.06f, 0.01f, 0.12f, 0.2f,  // Afrocuban
+         0.5f, 0.15f, 0.3f, 0.03f, 0.08f, 0.5f},
+        {0.08f, 0.06f, 0.15f, 0.03f, 0.03f, 0.03f, 0.03f, 0.02f, 0.08f, 0.05f,  // Other
+         0.3f, 0.5f, 0.3f, 0.03f, 0.05f, 0.3f}};
+
+    // Nearest centroid in scaled space: score = c.z - |c|^2 / 2, z = x / scale
+    for (int g = 0; g < NUM_CLASSES; ++g) {
+        float norm = 0.0f;
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            const float c = kPrototype[g][f] / kScale[f];
+            weights_[f][g] = c / kScale[f];
+            norm += c * c;
+        }
+        bias_[g] = -0.5f * norm;
+    }
+}
+
+}  // namespace JKDigital
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Out-of-line definitions for groove.h.
+//------------------------------------------------------------------------
+
+#pragma once
+
+namespace JKDigital {
+namespace Groove {
+
+DRUMCORE_DECL void apply(DrumBar* bars, int numBars, const GrooveTemplate& groove, double tempoBpm,
+                         float amount) {
+    constexpr int kSteps = GrooveTemplate::STEPS_PER_BAR;
+    const GrooveTemplate ms = groove.converted(GrooveUnit::Milliseconds, tempoBpm);
+
+    float offset[kSteps];
+    float scale[kSteps];
+    for (int s = 0; s < kSteps; ++s) {
+        const bool active = s < groove.activeSteps;
+        offset[s] = active ? ms.timing[s] * amount : 0.0f;
+        scale[s] = active ? 1.0f + (ms.velocityScale[s] - 1.0f) * amount : 1.0f;
+    }
+
+    for (int b = 0; b < numBars; ++b) {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            DrumStep* row = bars[b].steps[i];
+            for (int s = 0; s < kSteps; ++s) {
+                float t = row[s].timingOffsetMs + offset[s];
+                t = t < Constants::kMinTimingOffsetMs
+                        ? Constants::kMinTimingOffsetMs
+                        : (t > Constants::kMaxTimingOffsetMs ? Constants::kMaxTimingOffsetMs : t);
+                float v = row[s].velocity * scale[s];
+                v = v < kMinVelocity ? kMinVelocity : (v > 1.0f ? 1.0f : v);
+
+                const bool on = row[s].velocity > 0.0f;
+                row[s].timingOffsetMs = on ? t : row[s].timingOffsetMs;
+                row[s].velocity = on ? v : row[s].velocity;
+            }
+        }
+    }
+}
+
+DRUMCORE_DECL GrooveTemplate extract(const DrumBar* bars, int numBars, double tempoBpm,
+                                     TimeSignature timeSig,
+                                     GrooveUnit unit) {
+    constexpr int kSteps = GrooveTemplate::STEPS_PER_BAR;
+    double timingSum[kSteps] = {};
+    double velocitySum[kSteps] = {};
+    int count[kSteps] = {};
+    double totalVelocity = 0.0;
+    int totalCount = 0;
+
+    for (int b = 0; b < numBars; ++b) {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < kSteps; ++s) {
+                const DrumStep& step = bars[b].steps[i][s];
+                if (!step.hasNote()) continue;
+                timingSum[s] += step.timingOffsetMs;
+                velocitySum[s] += step.velocity;
+                ++count[s];
+            }
+        }
+    }
+    for (int s = 0; s < kSteps; ++s) {
+        totalVelocity += velocitySum[s];
+        totalCount += count[s];
+    }
+
+    GrooveTemplate groove = GrooveTemplate::straight(timeSig);
+    groove.unit = GrooveUnit::Milliseconds;
+    const double meanVelocity = totalCount > 0 ? totalVelocity / totalCount : 0.0;
+    for (int s = 0; s < groove.activeSteps; ++s) {
+        if (count[s] == 0) continue;
+        groove.timing[s] = static_cast<float>(timingSum[s] / count[s]);
+        if (meanVelocity > 0.0) {
+            groove.velocityScale[s] = static_cast<float>(velocitySum[s] / count[s] / meanVelocity);
+        }
+    }
+    return groove.converted(unit, tempoBpm);
+}
+
+}  // namespace Groove
+}  // namespace JKDigital
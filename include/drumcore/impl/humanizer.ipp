@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Out-of-line definitions for humanizer.h.
+//------------------------------------------------------------------------
+
+#pragma once
+
+namespace JKDigital {
+namespace Humanizer {
+
+DRUMCORE_DECL float phraseDrift(const HumanizeProfile& profile, uint64_t masterSeed,
+                                uint32_t transformIndex, uint32_t barIndex, int step) {
+    if (profile.driftAmountMs == 0.0f) return 0.0f;
+
+    const uint32_t phrase =
+        static_cast<uint32_t>(profile.driftPhraseBars > 0 ? profile.driftPhraseBars : 1);
+    const uint64_t driftSeed = Seed::deriveSeed(masterSeed, transformIndex, 0xFFFFFFFFu);
+    const uint32_t point = barIndex / phrase;
+    const float a = 2.0f * Seed::floatAt(driftSeed, kDriftLane, point) - 1.0f;
+    const float b = 2.0f * Seed::floatAt(driftSeed, kDriftLane, point + 1) - 1.0f;
+
+    const float t = (static_cast<float>(barIndex % phrase) +
+                     static_cast<float>(step) / static_cast<float>(DrumBar::STEPS_PER_BAR)) /
+                    static_cast<float>(phrase);
+    const float s = t * t * (3.0f - 2.0f * t);
+    return (a + (b - a) * s) * profile.driftAmountMs;
+}
+
+DRUMCORE_DECL HumanizeProfile genreProfile(DrumBar::Genre genre) {
+    // Base amounts: Kick, Snare, ClosedHH, OpenHH, Rim, LowTom, HighTom, Crash, Ride, Perc
+    constexpr HumanizeInstrumentProfile kBase[DrumBar::NUM_INSTRUMENTS] = {
+        {0.04f, 2.0f, 0.0f}, {0.06f, 3.0f, 0.0f}, {0.10f, 4.0f, 0.0f}, {0.08f, 4.0f, 0.0f},
+        {0.06f, 3.0f, 0.0f}, {0.08f, 4.0f, 0.0f}, {0.08f, 4.0f, 0.0f}, {0.05f, 3.0f, 0.0f},
+        {0.08f, 4.0f, 0.0f}, {0.10f, 5.0f, 0.0f}};
+
+    struct Feel {
+        float velocityScale;
+        float timingScale;
+        float backbeatBiasMs;  // Snare/rim drag
+        float cymbalBiasMs;    // Hats/ride push or drag
+        float driftMs;
+        JitterDistribution distribution;
+    };
+
+    constexpr JitterDistribution kGauss = JitterDistribution::Gaussian;
+    constexpr JitterDistribution kTri = JitterDistribution::Triangular;
+    constexpr Feel kFeels[DrumBar::kNumGenres] = {
+        {0.8f, 0.8f, 1.0f, 0.0f, 1.0f, kGauss},   // Rock
+        {1.0f, 0.8f, 0.0f, -1.0f, 1.0f, kTri},    // Latin
+        {1.2f, 0.7f, 1.5f, -1.0f, 0.5f, kGauss},  // Funk
+        {1.5f, 1.5f, 2.0f, -2.0f, 3.0f, kGauss},  // Jazz
+        {1.0f, 1.2f, 6.0f, 3.0f, 1.0f, kGauss},   // HipHop
+        {1.2f, 1.0f, 0.0f, -1.5f, 1.5f, kTri},    // Afrobeat
+        {1.4f, 1.4f, 3.0f, 1.0f, 2.5f, kGauss},   // NewOrleans
+        {1.2f, 1.0f, 0.0f, -1.0f, 1.5f, kTri},    // Afrocuban
+        {1.0f, 1.0f, 0.0f, 0.0f, 1.0f, kGauss},   // Other
+        {1.0f, 1.0f, 0.0f, 0.0f, 1.0f, kGauss}};  // Uncertain
+
+    int index = static_cast<int>(genre);
+    if (index < 0 || index >= DrumBar::kNumGenres) index = 0;
+    const Feel& feel = kFeels[index];
+
+    HumanizeProfile profile;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        profile.instruments[i] = {kBase[i].velocityAmount * feel.velocityScale,
+                                  kBase[i].timingAmountMs * feel.timingScale, 0.0f};
+    }
+    profile.instruments[1].timingBiasMs = feel.backbeatBiasMs;
+    profile.instruments[4].timingBiasMs = feel.backbeatBiasMs;
+    profile.instruments[2].timingBiasMs = feel.cymbalBiasMs;
+    profile.instruments[3].timingBiasMs = feel.cymbalBiasMs;
+    profile.instruments[8].timingBiasMs = feel.cymbalBiasMs;
+    profile.driftAmountMs = feel.driftMs;
+    profile.distribution = feel.distribution;
+    return profile;
+}
+
+DRUMCORE_DECL void humanizeBar(DrumBar& bar, const HumanizeProfile& profile, uint64_t masterSeed,
+                               uint32_t transformIndex, uint32_t barIndex, float amount) {
+    constexpr int kSteps = DrumBar::STEPS_PER_BAR;
+    const uint64_t barSeed = Seed::deriveSeed(masterSeed, transformIndex, barIndex);
+
+    float drift[kSteps];
+    for (int s = 0; s < kSteps; ++s) {
+        drift[s] = phraseDrift(profile, masterSeed, transformIndex, barIndex, s) * amount;
+    }
+
+    float velJitter[kSteps];
+    float timeJitter[kSteps];
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        const HumanizeInstrumentProfile& inst = profile.instruments[i];
+        const float velAmount = inst.velocityAmount * amount;
+        const float timeAmount = inst.timingAmountMs * amount;
+        const float bias = inst.timingBiasMs * amount;
+
+        for (int s = 0; s < kSteps; ++s) {
+            velJitter[s] = jitter(barSeed, static_cast<uint32_t>(i), static_cast<uint32_t>(s),
+                                  kVelocityDraw, profile.distribution);
+            timeJitter[s] = jitter(barSeed, static_cast<uint32_t>(i), static_cast<uint32_t>(s),
+                                   kTimingDraw, profile.distribution);
+        }
+
+        DrumStep* row = bar.steps[i];
+        for (int s = 0; s < kSteps; ++s) {
+            DrumStep& step = row[s];
+            const bool ghost = (step.flags & DrumStep::FLAG_GHOST) != 0;
+            const bool accent = (step.flags & DrumStep::FLAG_ACCENT) != 0;
+            const float velScale = ghost    ? profile.ghostVelocityScale
+                                   : accent ? profile.accentVelocityScale
+                                            : 1.0f;
+            const float timeScale = ghost    ? profile.ghostTimingScale
+                                    : accent ? profile.accentTimingScale
+                                             : 1.0f;
+
+            float v = step.velocity + velJitter[s] * velAmount * velScale;
+            v = v < kMinHumanizedVelocity ? kMinHumanizedVelocity : (v > 1.0f ? 1.0f : v);
+
+            float t = step.timingOffsetMs + timeJitter[s] * timeAmount * timeScale;
+            t += bias + drift[s];
+            t = t < Constants::kMinTimingOffsetMs
+                    ? Constants::kMinTimingOffsetMs
+                    : (t > Constants::kMaxTimingOffsetMs ? Constants::kMaxTimingOffsetMs : t);
+
+            const bool on = step.velocity > 0.0f;
+            step.velocity = on ? v : step.velocity;
+            step.timingOffsetMs = on ? t : step.timingOffsetMs;
+        }
+    }
+}
+
+DRUMCORE_DECL void humanizePattern(DrumBar* bars, int numBars, const HumanizeProfile& profile,
+                                   uint64_t masterSeed, uint32_t transformIndex,
+                                   uint32_t firstBarIndex, float amount) {
+    for (int b = 0; b < numBars; ++b) {
+        humanizeBar(bars[b], profile, masterSeed, transformIndex,
+                    firstBarIndex + static_cast<uint32_t>(b), amount);
+    }
+}
+
+}  // namespace Humanizer
+}  // namespace JKDigital
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Out-of-line definitions for rhythmfeatures.h.
+//------------------------------------------------------------------------
+
+#pragma once
+
+namespace JKDigital {
+namespace RhythmAnalysis {
+
+DRUMCORE_DECL void extract(const DrumBar& bar, const MetricMasks& masks, RhythmFeatures& out) {
+    constexpr int kInst = DrumBar::NUM_INSTRUMENTS;
+    constexpr int kPadded = (kInst + 3) & ~3;  // Whole 4-lane vectors
+    uint32_t occupancy[kPadded] = {};
+    int counts[kPadded];          // Onsets per instrument
+    int offbeatCounts[kPadded];   // Of which on off-beat positions
+    float velSum = 0.0f;
+    float velSumSq = 0.0f;
+
+#if defined(DRUMCORE_HAS_SSE2)
+    static_assert(sizeof(DrumStep) == 3 * sizeof(float), "DrumStep must be three 32-bit fields");
+    static_assert(DrumBar::STEPS_PER_BAR == 32, "a row packs into two 16-lane byte masks");
+    constexpr int kGroups = DrumBar::STEPS_PER_BAR / 4;
+
+    // Lane masks of the active steps, four steps per group
+    const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+    __m128 activeLanes[kGroups];
+    for (int g = 0; g < kGroups; ++g) {
+        const __m128i bits = _mm_and_si128(
+            _mm_set1_epi32(static_cast<int>((masks.active >> (g * 4)) & 0xFu)), laneBits);
+        activeLanes[g] = _mm_castsi128_ps(_mm_cmpeq_epi32(bits, laneBits));
+    }
+
+    // Four accumulator pairs so the adds are not one 80-long dependency chain
+    const __m128 zero = _mm_setzero_ps();
+    __m128 sum[4] = {zero, zero, zero, zero};
+    __m128 sumSq[4] = {zero, zero, zero, zero};
+    for (int i = 0; i < kInst; ++i) {
+        const float* row = reinterpret_cast<const float*>(&bar.steps[i][0]);
+        __m128i on[kGroups];
+        for (int g = 0; g < kGroups; ++g) {
+            // Four steps are 12 floats: velocities are a0 a3 b2 c1
+            const __m128 a = _mm_loadu_ps(row + g * 12);
+            const __m128 b = _mm_loadu_ps(row + g * 12 + 4);
+            const __m128 c = _mm_loadu_ps(row + g * 12 + 8);
+            const __m128 bc21 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+            const __m128 v = _mm_shuffle_ps(a, bc21, _MM_SHUFFLE(2, 0, 3, 0));
+            const __m128 hit = _mm_and_ps(_mm_cmpgt_ps(v, zero), activeLanes[g]);
+            const __m128 vm = _mm_and_ps(hit, v);
+            sum[g & 3] = _mm_add_ps(sum[g & 3], vm);
+            sumSq[g & 3] = _mm_add_ps(sumSq[g & 3], _mm_mul_ps(vm, vm));
+            on[g] = _mm_castps_si128(hit);
+        }
+        // Narrow the 32 lane masks to bytes in step order, 16 steps per movemask
+        const __m128i lo = _mm_packs_epi16(_mm_packs_epi32(on[0], on[1]),
+                                           _mm_packs_epi32(on[2], on[3]));
+        const __m128i hi = _mm_packs_epi16(_mm_packs_epi32(on[4], on[5]),
+                                           _mm_packs_epi32(on[6], on[7]));
+        occupancy[i] = static_cast<uint32_t>(_mm_movemask_epi8(lo)) |
+                       (static_cast<uint32_t>(_mm_movemask_epi8(hi)) << 16);
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(_mm_add_ps(sum[0], sum[1]), _mm_add_ps(sum[2], sum[3])));
+    velSum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes,
+                  _mm_add_ps(_mm_add_ps(sumSq[0], sumSq[1]), _mm_add_ps(sumSq[2], sumSq[3])));
+    velSumSq = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    const __m128i offbeat = _mm_set1_epi32(static_cast<int>(masks.offbeat));
+    for (int i = 0; i < kPadded; i += 4) {
+        const __m128i occ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(occupancy + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(counts + i), BitUtils::popcount32x4(occ));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(offbeatCounts + i),
+                         BitUtils::popcount32x4(_mm_and_si128(occ, offbeat)));
+    }
+#else
+    for (int i = 0; i < kInst; ++i) {
+        const DrumStep* row = bar.steps[i];
+        uint32_t mask = 0;
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const float v = row[s].velocity;
+            const bool on = v > 0.0f && ((masks.active >> s) & 1u) != 0;
+            mask |= static_cast<uint32_t>(on) << s;
+            const float vm = on ? v : 0.0f;
+            velSum += vm;
+            velSumSq += vm * vm;
+        }
+        occupancy[i] = mask;
+        counts[i] = BitUtils::popcount32(mask);
+        offbeatCounts[i] = BitUtils::popcount32(mask & masks.offbeat);
+    }
+#endif
+
+    const float invSteps = 1.0f / static_cast<float>(masks.activeSteps);
+    uint32_t any = 0;
+    int total = 0;
+    int offbeatOnsets = 0;
+    for (int i = 0; i < kInst; ++i) {
+        const int n = counts[i];
+        out.values[RhythmFeatures::kDensity + i] = static_cast<float>(n) * invSteps;
+        total += n;
+        offbeatOnsets += offbeatCounts[i];
+        any |= occupancy[i];
+    }
+    out.onsetCount = total;
+
+    // Syncopation: weak-position onsets whose next stronger position is silent
+    int syncopated = 0;
+    for (uint32_t m = any & masks.weak; m != 0; m &= m - 1) {
+        const int s = BitUtils::countTrailingZeros32(m);
+        syncopated += (any & masks.stronger[s]) == 0 ? 1 : 0;
+    }
+    const int anyCount = BitUtils::popcount32(any);
+
+    const uint32_t backbeatHits = (occupancy[kSnare] | occupancy[kRim]) & masks.backbeat;
+    const int backbeatSlots = BitUtils::popcount32(masks.backbeat);
+    const int hats = BitUtils::popcount32(occupancy[kClosedHat] | occupancy[kOpenHat]);
+    const int ride = BitUtils::popcount32(occupancy[kRide]);
+
+    const float mean = total > 0 ? velSum / static_cast<float>(total) : 0.0f;
+    const float variance = total > 0 ? velSumSq / static_cast<float>(total) - mean * mean : 0.0f;
+
+    out.values[RhythmFeatures::kSyncopation] =
+        anyCount > 0 ? static_cast<float>(syncopated) / static_cast<float>(anyCount) : 0.0f;
+    out.values[RhythmFeatures::kBackbeat] =
+        backbeatSlots > 0 ? static_cast<float>(BitUtils::popcount32(backbeatHits)) /
+                                static_cast<float>(backbeatSlots)
+                          : 0.0f;
+    out.values[RhythmFeatures::kOffbeat] =
+        total > 0 ? static_cast<float>(offbeatOnsets) / static_cast<float>(total) : 0.0f;
+    out.values[RhythmFeatures::kVelocityVariance] = variance > 0.0f ? variance : 0.0f;
+    out.values[RhythmFeatures::kTotalDensity] =
+        static_cast<float>(total) * invSteps / static_cast<float>(kInst);
+    out.values[RhythmFeatures::kRideShare] =
+        ride + hats > 0 ? static_cast<float>(ride) / static_cast<float>(ride + hats) : 0.0f;
+}
+
+}  // namespace RhythmAnalysis
+}  // namespace JKDigital
@@ -0,0 +1,339 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Runtime drum-kit maps and precomputed velocity-curve lookup tables.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/drummapping.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// KitMap - instrument/articulation to MIDI note mapping
+//------------------------------------------------------------------------
+/**
+ * Runtime-swappable mapping between grid instruments and MIDI notes.
+ *
+ * Each instrument has a base note plus optional alternates for the ghost,
+ * accent and fill-candidate flags (kNoNote = use the base note). A 128-entry
+ * reverse table maps incoming notes back to instruments; several notes may
+ * map to the same instrument (e.g. electric and acoustic snare).
+ *
+ * Plain value type: copy a configured map into the audio thread as a whole.
+ */
+class KitMap {
+  public:
+    static constexpr int NUM_INSTRUMENTS = DrumBar::NUM_INSTRUMENTS;
+    static constexpr int NUM_NOTES = 128;
+
+    /** Marker for an unset note or unmapped instrument. */
+    static constexpr int8_t kNoNote = -1;
+
+    /** Note variants selectable per step. */
+    enum class Articulation { Normal = 0, Ghost = 1, Accent = 2, Fill = 3 };
+    static constexpr int NUM_ARTICULATIONS = 4;
+
+    /** Constructor - empty map (no notes assigned). */
+    KitMap() { clear(); }
+
+    /** Map matching GMDrumMap, with common GM alternates mapped back as input aliases. */
+    static KitMap generalMidi() {
+        KitMap kit;
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) kit.setNote(i, GMDrumMap::getNote(i));
+        // Input-only aliases: alternate GM notes recorded into the nearest instrument
+        kit.addInputNote(35, 0);  // Acoustic Bass Drum
+        kit.addInputNote(40, 1);  // Electric Snare
+        kit.addInputNote(44, 2);  // Pedal Hi-Hat
+        kit.addInputNote(41, 5);  // Low Floor Tom
+        kit.addInputNote(43, 5);  // High Floor Tom
+        kit.addInputNote(GMDrumMap::MID_TOM, 6);
+        kit.addInputNote(48, 6);  // Hi-Mid Tom
+        kit.addInputNote(57, 7);  // Crash Cymbal 2
+        kit.addInputNote(59, 8);  // Ride Cymbal 2
+        kit.addInputNote(53, 8);  // Ride Bell
+        return kit;
+    }
+
+    /** Remove all note assignments. */
+    void clear() {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (int a = 0; a < NUM_ARTICULATIONS; ++a) notes_[i][a] = kNoNote;
+        }
+        for (int n = 0; n < NUM_NOTES; ++n) {
+            instrumentForNote_[n] = kNoNote;
+            inputAlias_[n] = false;
+        }
+    }
+
+    /**
+     * Set the base note of an instrument (also mapped for input).
+     *
+     * @param instrument Instrument index (0-9)
+     * @param note MIDI note (0-127)
+     * @return false if either argument is out of range
+     */
+    bool setNote(int instrument, int note) {
+        return setArticulationNote(instrument, Articulation::Normal, note);
+    }
+
+    /**
+     * Set the note played for an articulation (also mapped for input).
+     *
+     * The note it replaces stops mapping to this instrument for input,
+     * unless addInputNote() registered it or another assignment still
+     * plays it.
+     *
+     * @param instrument Instrument index (0-9)
+     * @param articulation Articulation to assign
+     * @param note MIDI note (0-127), or kNoNote to fall back to the base note
+     * @return false if an argument is out of range
+     */
+    bool setArticulationNote(int instrument, Articulation articulation, int note) {
+        const int a = static_cast<int>(articulation);
+        if (instrument < 0 || instrument >= NUM_INSTRUMENTS || a < 0 ||
+            a >= NUM_ARTICULATIONS || note < kNoNote || note >= NUM_NOTES) {
+            return false;
+        }
+        const int previous = notes_[instrument][a];
+        notes_[instrument][a] = static_cast<int8_t>(note);
+        if (previous != kNoNote && previous != note) remapInput(previous);
+        if (note != kNoNote) instrumentForNote_[note] = static_cast<int8_t>(instrument);
+        return true;
+    }
+
+    /**
+     * Map an extra incoming note to an instrument without changing output.
+     *
+     * @return false if either argument is out of range
+     */
+    bool addInputNote(int note, int instrument) {
+        if (note < 0 || note >= NUM_NOTES || instrument < 0 || instrument >= NUM_INSTRUMENTS) {
+            return false;
+        }
+        instrumentForNote_[note] = static_cast<int8_t>(instrument);
+        inputAlias_[note] = true;
+        return true;
+    }
+
+    /** Remove the input mapping of a note. */
+    void removeInputNote(int note) {
+        if (note >= 0 && note < NUM_NOTES) {
+            instrumentForNote_[note] = kNoNote;
+            inputAlias_[note] = false;
+        }
+    }
+
+    /**
+     * Note for an instrument and articulation.
+     *
+     * @return MIDI note, the base note if the articulation is unset, or
+     *         kNoNote if the instrument is unmapped or out of range
+     */
+    int note(int instrument, Articulation articulation = Articulation::Normal) const {
+        if (instrument < 0 || instrument >= NUM_INSTRUMENTS) return kNoNote;
+        const int alt = notes_[instrument][static_cast<int>(articulation)];
+        return alt != kNoNote ? alt : notes_[instrument][0];
+    }
+
+    /**
+     * Note for an instrument given a step's flags.
+     *
+     * Accent takes precedence over ghost, ghost over fill candidate.
+     */
+    int noteForFlags(int instrument, uint8_t flags) const {
+        return note(instrument, articulationForFlags(flags));
+    }
+
+    /** Instrument an incoming note maps to, or kNoNote if unmapped. */
+    int instrumentFor(int note) const {
+        return (note >= 0 && note < NUM_NOTES) ? instrumentForNote_[note] : kNoNote;
+    }
+
+    /** Articulation selected by a step's flags. */
+    static Articulation articulationForFlags(uint8_t flags) {
+        if ((flags & DrumStep::FLAG_ACCENT) != 0) return Articulation::Accent;
+        if ((flags & DrumStep::FLAG_GHOST) != 0) return Articulation::Ghost;
+        if ((flags & DrumStep::FLAG_FILL_CANDIDATE) != 0) return Articulation::Fill;
+        return Articulation::Normal;
+    }
+
+    /**
+     * Resolve the MIDI note of every step of a bar in one pass.
+     *
+     * @param bar Source bar
+     * @param out Note per instrument and step (kNoNote where silent or unmapped)
+     */
+    void convertBar(const DrumBar& bar,
+                    int8_t (&out)[NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR]) const {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                const DrumStep& step = bar.steps[i][s];
+                out[i][s] = step.velocity > 0.0f ? static_cast<int8_t>(noteForFlags(i, step.flags))
+                                                 : kNoNote;
+            }
+        }
+    }
+
+  private:
+    // Input mapping of a note no longer assigned to an articulation slot:
+    // kept if it is an input alias, else the first slot still playing it
+    void remapInput(int note) {
+        if (inputAlias_[note]) return;
+        instrumentForNote_[note] = kNoNote;
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            for (int a = 0; a < NUM_ARTICULATIONS; ++a) {
+                if (notes_[i][a] == note) {
+                    instrumentForNote_[note] = static_cast<int8_t>(i);
+                    return;
+                }
+            }
+        }
+    }
+
+    int8_t notes_[NUM_INSTRUMENTS][NUM_ARTICULATIONS];
+    int8_t instrumentForNote_[NUM_NOTES];
+    bool inputAlias_[NUM_NOTES];
+};
+
+//------------------------------------------------------------------------
+// VelocityCurve - 256-entry float-to-MIDI velocity lookup tables
+//------------------------------------------------------------------------
+/**
+ * Precomputed velocity curve with ghost/accent scaling folded in.
+ *
+ * Normalized velocities are quantized to 256 levels and looked up in one
+ * of three tables (normal, ghost, accent), replacing the per-note float
+ * math, multiplier and clamp. Silent (<= 0) maps to MIDI 0; any audible
+ * velocity maps to at least 1.
+ */
+class VelocityCurve {
+  public:
+    static constexpr int LUT_SIZE = 256;
+
+    /** Table selection per step. */
+    static constexpr int kNormal = 0;
+    static constexpr int kGhost = 1;
+    static constexpr int kAccent = 2;
+    static constexpr int NUM_TABLES = 3;
+
+    /** Constructor - linear curve. */
+    VelocityCurve() { build([](float x) { return x; }); }
+
+    /**
+     * Linear curve. Rounds to the nearest MIDI velocity, so it reads up to
+     * one above GMDrumMap::toMidiVelocity, which truncates.
+     */
+    static VelocityCurve linear() { return VelocityCurve(); }
+
+    /**
+     * Exponential (power) curve: out = in^gamma.
+     *
+     * @param gamma > 1.0 softens low velocities, < 1.0 boosts them
+     */
+    static VelocityCurve exponential(float gamma) {
+        VelocityCurve curve;
+        if (gamma <= 0.0f) gamma = 1.0f;
+        curve.build([gamma](float x) { return std::pow(x, gamma); });
+        return curve;
+    }
+
+    /**
+     * Custom curve from a mapping function.
+     *
+     * @param fn Callable mapping 0.0-1.0 to 0.0-1.0 (evaluated 768 times, not per note)
+     */
+    template <typename Fn>
+    static VelocityCurve custom(Fn fn) {
+        VelocityCurve curve;
+        curve.build(fn);
+        return curve;
+    }
+
+    /** Quantize a normalized velocity to a table index (0 only when silent). */
+    static int indexOf(float velocity) {
+        if (!(velocity > 0.0f)) return 0;
+        const int index = static_cast<int>(velocity * (LUT_SIZE - 1) + 0.5f);
+        return index < 1 ? 1 : (index > LUT_SIZE - 1 ? LUT_SIZE - 1 : index);
+    }
+
+    /** Table selected by a step's flags (accent over ghost). */
+    static int tableForFlags(uint8_t flags) {
+        if ((flags & DrumStep::FLAG_ACCENT) != 0) return kAccent;
+        if ((flags & DrumStep::FLAG_GHOST) != 0) return kGhost;
+        return kNormal;
+    }
+
+    /** Convert a normalized velocity and step flags to a MIDI velocity (0-127). */
+    uint8_t toMidi(float velocity, uint8_t flags = 0) const {
+        return lut_[tableForFlags(flags)][indexOf(velocity)];
+    }
+
+    /** Convert a step to a MIDI velocity (0-127). */
+    uint8_t toMidi(const DrumStep& step) const { return toMidi(step.velocity, step.flags); }
+
+    /** Raw table access. */
+    const uint8_t* table(int which) const { return lut_[which]; }
+
+    /**
+     * Convert a whole bar's velocities to MIDI velocities in one pass.
+     *
+     * Indices and table offsets are computed branch-free per row before
+     * the lookups, so the arithmetic part vectorizes.
+     *
+     * @param bar Source bar
+     * @param out MIDI velocity per instrument and step (0 where silent)
+     */
+    void convertBar(const DrumBar& bar,
+                    uint8_t (&out)[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR]) const {
+        constexpr int kSteps = DrumBar::STEPS_PER_BAR;
+        const uint8_t* flat = lut_[0];
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            const DrumStep* row = bar.steps[i];
+            int index[kSteps];
+            for (int s = 0; s < kSteps; ++s) {
+                const bool on = row[s].velocity > 0.0f;
+                float v = (on ? row[s].velocity : 0.0f) * (LUT_SIZE - 1) + 0.5f;
+                v = v > LUT_SIZE - 1 ? LUT_SIZE - 1 : v;
+                int q = static_cast<int>(v);
+                q = (on && q < 1) ? 1 : q;
+                const int accent = (row[s].flags & DrumStep::FLAG_ACCENT) != 0;
+                const int ghost = (row[s].flags & DrumStep::FLAG_GHOST) != 0;
+                const int t = accent ? kAccent : ghost;
+                index[s] = t * LUT_SIZE + q;
+            }
+            for (int s = 0; s < kSteps; ++s) out[i][s] = flat[index[s]];
+        }
+    }
+
+  private:
+    template <typename Fn>
+    void build(Fn fn) {
+        constexpr float kScale[NUM_TABLES] = {1.0f, Constants::kGhostVelocityMultiplier,
+                                              Constants::kAccentVelocityMultiplier};
+        for (int t = 0; t < NUM_TABLES; ++t) {
+            lut_[t][0] = 0;
+            for (int i = 1; i < LUT_SIZE; ++i) {
+                const float x = static_cast<float>(i) / static_cast<float>(LUT_SIZE - 1);
+                float y = static_cast<float>(fn(x)) * kScale[t];
+                y = y < 0.0f ? 0.0f : (y > 1.0f ? 1.0f : y);
+                int midi = static_cast<int>(y * Constants::kMaxVelocity + 0.5f);
+                midi = midi < Constants::kMinVelocity ? Constants::kMinVelocity
+                                                      : (midi > Constants::kMaxVelocity
+                                                             ? Constants::kMaxVelocity
+                                                             : midi);
+                lut_[t][i] = static_cast<uint8_t>(midi);
+            }
+        }
+    }
+
+    uint8_t lut_[NUM_TABLES][LUT_SIZE];
+};
+
+}  // namespace JKDigital
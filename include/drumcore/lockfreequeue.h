@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 namespace JKDigital {
 
@@ -91,4 +92,10 @@ template <typename T, size_t Capacity = 16> class LockFreeQueue {
     LockFreeQueue& operator=(const LockFreeQueue&) = delete;
 };
 
+#if defined(DRUMCORE_SEPARATE_COMPILATION)
+// Common specializations, instantiated once in drumcore_impl
+extern template class LockFreeQueue<float, 16>;
+extern template class LockFreeQueue<int32_t, 16>;
+#endif
+
 }  // namespace JKDigital
@@ -0,0 +1,427 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Per-genre Markov pattern generator with precomputed transition tables.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// MarkovPatternModel - compact transition tables and bar generation
+//------------------------------------------------------------------------
+/**
+ * Lightweight pattern generator using per-genre, per-instrument Markov
+ * chains over quantized step states.
+ *
+ * Each step is one of four states (rest, soft, medium, loud). The
+ * transition to the next state is conditioned on the instrument, the step
+ * position and the previous step's state, and stored as a 15-bit
+ * fixed-point CDF. One genre's tables take ~7.5 KB, so generation stays
+ * cache-resident.
+ *
+ * Tables are produced offline by MarkovTrainer and loaded with
+ * deserialize(). generate() is allocation-free and deterministic.
+ */
+class MarkovPatternModel {
+  public:
+    static constexpr int NUM_GENRES = DrumBar::kNumGenres;
+    static constexpr int NUM_INSTRUMENTS = DrumBar::NUM_INSTRUMENTS;
+    static constexpr int STEPS_PER_BAR = DrumBar::STEPS_PER_BAR;
+
+    /** Quantized step states. */
+    static constexpr int NUM_STATES = 4;
+    static constexpr uint8_t STATE_REST = 0;
+    static constexpr uint8_t STATE_SOFT = 1;
+    static constexpr uint8_t STATE_MEDIUM = 2;
+    static constexpr uint8_t STATE_LOUD = 3;
+
+    /** Velocity band edges used to quantize steps. */
+    static constexpr float kSoftBelow = 0.45f;
+    static constexpr float kLoudFrom = 0.85f;
+
+    /** Fixed-point probability 1.0 in the CDF tables (15-bit uniforms). */
+    static constexpr uint32_t kCdfOne = 1u << 15;
+
+    /** Serialized format identification. */
+    static constexpr uint32_t kMagic = 0x4B4D4344;  // "DCMK"
+    static constexpr uint16_t kFormatVersion = 1;
+
+    /** Per-genre table block. */
+    struct GenreTables {
+        /** CDF thresholds [instrument][step][prevState][state 0..2]. */
+        uint16_t cdf[NUM_INSTRUMENTS][STEPS_PER_BAR][NUM_STATES][NUM_STATES - 1];
+
+        /** Mean velocity per state, quantized to 0-255. */
+        uint8_t velocity[NUM_INSTRUMENTS][NUM_STATES];
+    };
+
+    /** Constructor - initializes with no trained genres. */
+    MarkovPatternModel() {
+        for (auto& t : trained_) t = false;
+    }
+
+    /**
+     * Quantize a step to a Markov state.
+     *
+     * Ghost and accent flags take precedence over the velocity bands.
+     */
+    static uint8_t quantize(const DrumStep& step) {
+        if (!step.hasNote()) return STATE_REST;
+        if (step.isGhost()) return STATE_SOFT;
+        if (step.isAccent()) return STATE_LOUD;
+        if (step.velocity < kSoftBelow) return STATE_SOFT;
+        if (step.velocity >= kLoudFrom) return STATE_LOUD;
+        return STATE_MEDIUM;
+    }
+
+    /** Check whether a genre has trained tables. */
+    bool hasGenre(DrumBar::Genre genre) const {
+        const int g = static_cast<int>(genre);
+        return g >= 0 && g < NUM_GENRES && trained_[g];
+    }
+
+    /** Install tables for a genre (used by MarkovTrainer). */
+    void setGenreTables(DrumBar::Genre genre, const GenreTables& tables) {
+        const int g = static_cast<int>(genre);
+        if (g < 0 || g >= NUM_GENRES) return;
+        tables_[g] = tables;
+        trained_[g] = true;
+    }
+
+    /** Access tables for a trained genre. */
+    const GenreTables& genreTables(DrumBar::Genre genre) const {
+        return tables_[static_cast<int>(genre)];
+    }
+
+    /**
+     * Generate a bar for a genre.
+     *
+     * Instrument i draws its 32 steps from Seed::randomAt(barSeed, i * 8 + k),
+     * four 15-bit uniforms per value. Every step of the bar is overwritten
+     * and its genre is set; ghost/accent flags follow the soft/loud states.
+     *
+     * @param out Destination bar
+     * @param genre Genre tables to use
+     * @param barSeed Seed from Seed::deriveSeed()
+     * @return false if the genre has no trained tables (bar left empty)
+     */
+    bool generate(DrumBar& out, DrumBar::Genre genre, uint64_t barSeed) const {
+        out.genre = genre;
+        if (!hasGenre(genre)) {
+            out.clear();
+            return false;
+        }
+
+        const GenreTables& t = tables_[static_cast<int>(genre)];
+        constexpr float kVelocityScale = 1.0f / 255.0f;
+        constexpr uint8_t kStateFlags[NUM_STATES] = {0, DrumStep::FLAG_GHOST, 0,
+                                                     DrumStep::FLAG_ACCENT};
+
+        float velocity[NUM_INSTRUMENTS][NUM_STATES];
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            velocity[i][STATE_REST] = 0.0f;
+            for (int st = 1; st < NUM_STATES; ++st) {
+                velocity[i][st] = static_cast<float>(t.velocity[i][st]) * kVelocityScale;
+            }
+        }
+
+        // Steps outer, instruments inner: the ten chains are independent, so
+        // their table lookups overlap instead of forming one long dependency.
+        // Every step is written, so no separate clear pass is needed.
+        unsigned prev[NUM_INSTRUMENTS] = {};
+        uint64_t bits[NUM_INSTRUMENTS] = {};
+        for (int s = 0; s < STEPS_PER_BAR; ++s) {
+            if ((s & 3) == 0) {
+                for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                    bits[i] = Seed::randomAt(barSeed, static_cast<uint64_t>(i) * 8 +
+                                                          static_cast<uint64_t>(s >> 2));
+                }
+            }
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                const uint32_t u = static_cast<uint32_t>(bits[i] & (kCdfOne - 1));
+                bits[i] >>= 16;
+
+                const uint16_t* cdf = t.cdf[i][s][prev[i]];
+                const unsigned state = static_cast<unsigned>(u >= cdf[0]) +
+                                       static_cast<unsigned>(u >= cdf[1]) +
+                                       static_cast<unsigned>(u >= cdf[2]);
+                DrumStep& step = out.steps[i][s];
+                step.velocity = velocity[i][state];
+                step.timingOffsetMs = 0.0f;
+                step.flags = kStateFlags[state];
+                prev[i] = state;
+            }
+        }
+        return true;
+    }
+
+    /** Size in bytes of the serialized model. */
+    size_t serializedSize() const {
+        size_t size = kHeaderSize;
+        for (bool trained : trained_) {
+            if (trained) size += 1 + kGenreBlockSize;
+        }
+        return size;
+    }
+
+    /**
+     * Serialize trained tables to a little-endian byte buffer.
+     *
+     * @param out Destination buffer
+     * @param capacity Buffer size in bytes
+     * @return Bytes written, or 0 if the buffer is too small
+     */
+    size_t serialize(uint8_t* out, size_t capacity) const {
+        const size_t size = serializedSize();
+        if (capacity < size) return 0;
+
+        uint8_t* p = out;
+        p = put32(p, kMagic);
+        p = put16(p, kFormatVersion);
+        *p++ = NUM_INSTRUMENTS;
+        *p++ = STEPS_PER_BAR;
+        *p++ = NUM_STATES;
+        uint8_t count = 0;
+        for (bool trained : trained_) count = static_cast<uint8_t>(count + (trained ? 1 : 0));
+        *p++ = count;
+
+        for (int g = 0; g < NUM_GENRES; ++g) {
+            if (!trained_[g]) continue;
+            *p++ = static_cast<uint8_t>(g);
+            const GenreTables& t = tables_[g];
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                for (int st = 0; st < NUM_STATES; ++st) *p++ = t.velocity[i][st];
+            }
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                    for (int prev = 0; prev < NUM_STATES; ++prev) {
+                        for (int k = 0; k < NUM_STATES - 1; ++k) p = put16(p, t.cdf[i][s][prev][k]);
+                    }
+                }
+            }
+        }
+        return size;
+    }
+
+    /**
+     * Load tables from a buffer produced by serialize().
+     *
+     * On failure the model is left unchanged.
+     *
+     * @param data Serialized bytes
+     * @param size Number of bytes
+     * @return false if the data is truncated or has a mismatched header
+     */
+    bool deserialize(const uint8_t* data, size_t size) {
+        if (size < kHeaderSize) return false;
+        if (get32(data) != kMagic || get16(data + 4) != kFormatVersion) return false;
+        if (data[6] != NUM_INSTRUMENTS || data[7] != STEPS_PER_BAR || data[8] != NUM_STATES) {
+            return false;
+        }
+        const size_t count = data[9];
+        if (count > NUM_GENRES || size < kHeaderSize + count * (1 + kGenreBlockSize)) return false;
+
+        // Validate genre ids before touching any state
+        const uint8_t* p = data + kHeaderSize;
+        for (size_t n = 0; n < count; ++n) {
+            if (p[n * (1 + kGenreBlockSize)] >= NUM_GENRES) return false;
+        }
+
+        for (auto& t : trained_) t = false;
+        for (size_t n = 0; n < count; ++n) {
+            const int g = *p++;
+            GenreTables& t = tables_[g];
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                for (int st = 0; st < NUM_STATES; ++st) t.velocity[i][st] = *p++;
+            }
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                    for (int prev = 0; prev < NUM_STATES; ++prev) {
+                        for (int k = 0; k < NUM_STATES - 1; ++k) {
+                            t.cdf[i][s][prev][k] = get16(p);
+                            p += 2;
+                        }
+                    }
+                }
+            }
+            trained_[g] = true;
+        }
+        return true;
+    }
+
+  private:
+    static constexpr size_t kHeaderSize = 10;
+    static constexpr size_t kGenreBlockSize =
+        NUM_INSTRUMENTS * NUM_STATES +
+        NUM_INSTRUMENTS * STEPS_PER_BAR * NUM_STATES * (NUM_STATES - 1) * 2;
+
+    static uint8_t* put16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+        return p + 2;
+    }
+
+    static uint8_t* put32(uint8_t* p, uint32_t v) {
+        p = put16(p, static_cast<uint16_t>(v));
+        return put16(p, static_cast<uint16_t>(v >> 16));
+    }
+
+    static uint16_t get16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    static uint32_t get32(const uint8_t* p) {
+        return static_cast<uint32_t>(get16(p)) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+    }
+
+    GenreTables tables_[NUM_GENRES];
+    bool trained_[NUM_GENRES];
+};
+
+//------------------------------------------------------------------------
+// MarkovTrainer - offline table construction from a bar corpus
+//------------------------------------------------------------------------
+/**
+ * Accumulates transition counts from a corpus of bars and builds a
+ * MarkovPatternModel. Intended for offline use (allocates).
+ */
+class MarkovTrainer {
+  public:
+    static constexpr int NUM_GENRES = MarkovPatternModel::NUM_GENRES;
+    static constexpr int NUM_INSTRUMENTS = MarkovPatternModel::NUM_INSTRUMENTS;
+    static constexpr int STEPS_PER_BAR = MarkovPatternModel::STEPS_PER_BAR;
+    static constexpr int NUM_STATES = MarkovPatternModel::NUM_STATES;
+
+    /** Constructor - initializes zero counts. */
+    MarkovTrainer()
+        : transitions_(static_cast<size_t>(NUM_GENRES) * kContextsPerGenre * NUM_STATES, 0),
+          velocitySum_(static_cast<size_t>(NUM_GENRES) * NUM_INSTRUMENTS * NUM_STATES, 0.0),
+          velocityCount_(velocitySum_.size(), 0), barCount_(NUM_GENRES, 0) {}
+
+    /** Add one bar, using bar.genre as its genre. */
+    void addBar(const DrumBar& bar) {
+        const int g = static_cast<int>(bar.genre);
+        if (g < 0 || g >= NUM_GENRES) return;
+        ++barCount_[static_cast<size_t>(g)];
+
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            unsigned prev = MarkovPatternModel::STATE_REST;
+            for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                const DrumStep& step = bar.steps[i][s];
+                const unsigned state = MarkovPatternModel::quantize(step);
+                ++transitions_[context(g, i, s, prev) * NUM_STATES + state];
+                if (state != MarkovPatternModel::STATE_REST) {
+                    const size_t v = velocityIndex(g, i, state);
+                    velocitySum_[v] += step.velocity;
+                    ++velocityCount_[v];
+                }
+                prev = state;
+            }
+        }
+    }
+
+    /** Add a range of bars. */
+    void addBars(const DrumBar* bars, size_t count) {
+        for (size_t b = 0; b < count; ++b) addBar(bars[b]);
+    }
+
+    /** Number of bars added for a genre. */
+    size_t barCount(DrumBar::Genre genre) const {
+        return barCount_[static_cast<size_t>(genre)];
+    }
+
+    /**
+     * Build normalized tables for every genre with at least one bar.
+     *
+     * Contexts never seen in training fall back to the step's distribution
+     * over all previous states, then to rest.
+     *
+     * @param model Model to receive the tables
+     */
+    void build(MarkovPatternModel& model) const {
+        static const float kDefaultVelocity[NUM_STATES] = {0.0f, 0.3f, 0.7f, 0.95f};
+        MarkovPatternModel::GenreTables tables;
+
+        for (int g = 0; g < NUM_GENRES; ++g) {
+            if (barCount_[static_cast<size_t>(g)] == 0) continue;
+
+            for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+                for (int st = 0; st < NUM_STATES; ++st) {
+                    const size_t v = velocityIndex(g, i, static_cast<unsigned>(st));
+                    const double mean = velocityCount_[v] > 0
+                                            ? velocitySum_[v] / velocityCount_[v]
+                                            : kDefaultVelocity[st];
+                    int q = static_cast<int>(mean * 255.0 + 0.5);
+                    if (st != MarkovPatternModel::STATE_REST && q < 1) q = 1;
+                    tables.velocity[i][st] = static_cast<uint8_t>(q > 255 ? 255 : q);
+                }
+
+                for (int s = 0; s < STEPS_PER_BAR; ++s) {
+                    uint64_t marginal[NUM_STATES] = {0, 0, 0, 0};
+                    for (unsigned prev = 0; prev < NUM_STATES; ++prev) {
+                        for (int st = 0; st < NUM_STATES; ++st) {
+                            marginal[st] += transitions_[context(g, i, s, prev) * NUM_STATES + st];
+                        }
+                    }
+
+                    for (unsigned prev = 0; prev < NUM_STATES; ++prev) {
+                        const uint32_t* counts = &transitions_[context(g, i, s, prev) * NUM_STATES];
+                        uint64_t row[NUM_STATES];
+                        uint64_t total = 0;
+                        for (int st = 0; st < NUM_STATES; ++st) total += row[st] = counts[st];
+                        if (total == 0) {
+                            for (int st = 0; st < NUM_STATES; ++st) total += row[st] = marginal[st];
+                        }
+                        toCdf(row, total, tables.cdf[i][s][prev]);
+                    }
+                }
+            }
+            model.setGenreTables(static_cast<DrumBar::Genre>(g), tables);
+        }
+    }
+
+  private:
+    static constexpr size_t kContextsPerGenre =
+        static_cast<size_t>(NUM_INSTRUMENTS) * STEPS_PER_BAR * NUM_STATES;
+
+    static size_t context(int g, int i, int s, unsigned prev) {
+        return ((static_cast<size_t>(g) * NUM_INSTRUMENTS + static_cast<size_t>(i)) *
+                    STEPS_PER_BAR +
+                static_cast<size_t>(s)) *
+                   NUM_STATES +
+               prev;
+    }
+
+    static size_t velocityIndex(int g, int i, unsigned state) {
+        return (static_cast<size_t>(g) * NUM_INSTRUMENTS + static_cast<size_t>(i)) * NUM_STATES +
+               state;
+    }
+
+    // Cumulative thresholds on a 15-bit uniform; 0 total means always rest
+    static void toCdf(const uint64_t (&row)[NUM_STATES], uint64_t total,
+                      uint16_t (&cdf)[NUM_STATES - 1]) {
+        constexpr uint64_t kOne = MarkovPatternModel::kCdfOne;
+        uint64_t cumulative = 0;
+        for (int k = 0; k < NUM_STATES - 1; ++k) {
+            cumulative += row[k];
+            const uint64_t t = total == 0 ? kOne : (cumulative * kOne + total / 2) / total;
+            cdf[k] = static_cast<uint16_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> transitions_;
+    std::vector<double> velocitySum_;
+    std::vector<uint32_t> velocityCount_;
+    std::vector<size_t> barCount_;
+};
+
+}  // namespace JKDigital
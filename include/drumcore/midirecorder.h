@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Real-time MIDI input quantizer recording into DrumBars.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/kitmap.h>
+#include <drumcore/timesignature.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// MidiRecorder - live drum input to quantized DrumBars
+//------------------------------------------------------------------------
+/**
+ * Records incoming drum notes into DrumBars on the audio thread.
+ *
+ * Notes are mapped to instruments through a KitMap, quantized to the
+ * nearest 32nd-note step of the active TimeSignature, and the residual is
+ * kept in timingOffsetMs (clamped to the Constants limits). Notes played
+ * just before a downbeat land on step 0 of the following bar.
+ *
+ * Two bars are open at a time (current and next). The current bar is
+ * closed once the transport is half a step past its end, and pushed to a
+ * DrumPatternBuffer for the UI/worker thread to pop. Bars without notes
+ * are not pushed. Transport jumps and loops close both bars immediately.
+ *
+ * Real-time safe: no allocation or locking; per-event cost is constant
+ * except for the occasional bar rollover (one bar clear and copy).
+ * Single producer (audio thread), single consumer (popBar); the drop
+ * counters can be read from any thread.
+ */
+class MidiRecorder {
+  public:
+    /** Host transport state at the start of a process block. */
+    struct Transport {
+        /** Musical position of the block's first sample, in quarter notes. */
+        double ppqPosition = 0.0;
+        /** Position of the last bar start at or before ppqPosition. */
+        double barStartPpq = 0.0;
+        double tempoBpm = Constants::kDefaultTempo;
+        double sampleRate = 44100.0;
+        TimeSignature timeSig = TimeSignature::k4_4;
+    };
+
+    /** Constructor - General MIDI kit, no bar open. */
+    MidiRecorder() : kit_(KitMap::generalMidi()) { reset(); }
+
+    /** Replace the kit map used for note lookup (not while recording). */
+    void setKitMap(const KitMap& kit) { kit_ = kit; }
+
+    /** Discard open bars and counters (queued bars are kept). */
+    void reset() {
+        open_ = false;
+        current_ = 0;
+        barStartPpq_[0] = barStartPpq_[1] = 0.0;
+        bars_[0].clear();
+        bars_[1].clear();
+        blockPpq_ = 0.0;
+        ppqPerSample_ = 0.0;
+        stepMs_ = stepDurationMs(Constants::kDefaultTempo);
+        timeSig_ = TimeSignature::k4_4;
+        beatsPerBar_ = TimeSignatureUtils::getBeatsPerBar(timeSig_);
+        activeSteps_ = TimeSignatureUtils::getActiveSteps(timeSig_);
+        droppedEvents_.store(0, std::memory_order_relaxed);
+        droppedBars_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Start a process block.
+     *
+     * Closes bars the transport has moved past, and everything on a
+     * time-signature change or jump.
+     *
+     * @param transport Host transport at the first sample of the block
+     */
+    void beginBlock(const Transport& transport) {
+        if (transport.timeSig != timeSig_) {
+            flush();
+            timeSig_ = transport.timeSig;
+            beatsPerBar_ = TimeSignatureUtils::getBeatsPerBar(timeSig_);
+            activeSteps_ = TimeSignatureUtils::getActiveSteps(timeSig_);
+        }
+        const double tempo = transport.tempoBpm > 0.0 ? transport.tempoBpm
+                                                      : Constants::kDefaultTempo;
+        const double sampleRate = transport.sampleRate > 0.0 ? transport.sampleRate : 44100.0;
+        blockPpq_ = transport.ppqPosition;
+        ppqPerSample_ = tempo / (60.0 * sampleRate);
+        stepMs_ = stepDurationMs(tempo);
+
+        // Align the bar grid to the host's bar start
+        const double since = transport.ppqPosition - transport.barStartPpq;
+        const double barStart =
+            transport.barStartPpq + std::floor(since / beatsPerBar_) * beatsPerBar_;
+        advanceTo(transport.ppqPosition, barStart);
+    }
+
+    /**
+     * Record a note-on.
+     *
+     * @param sampleOffset Sample offset of the event within the block
+     * @param note MIDI note number
+     * @param velocity MIDI velocity (1-127; 0 is ignored as a note-off)
+     * @return true if the note was recorded
+     */
+    bool recordEvent(int32_t sampleOffset, int32_t note, int32_t velocity) {
+        const int instrument = kit_.instrumentFor(note);
+        if (instrument < 0 || velocity <= 0) return false;
+
+        const double ppq = blockPpq_ + static_cast<double>(sampleOffset) * ppqPerSample_;
+        const double barStart = barStartPpq_[current_] +
+                                std::floor((ppq - barStartPpq_[current_]) / beatsPerBar_) *
+                                    beatsPerBar_;
+        advanceTo(ppq, barStart);
+
+        // Position in 32nd steps relative to the current bar
+        const double stepPos = (ppq - barStartPpq_[current_]) / Constants::kBeatsPerStep;
+        int step = static_cast<int>(std::floor(stepPos + 0.5));
+        const int barSteps = static_cast<int>(beatsPerBar_ / Constants::kBeatsPerStep + 0.5);
+        int slot = current_;
+        if (step >= barSteps) {
+            step -= barSteps;
+            slot ^= 1;
+        }
+        if (step < 0 || step >= barSteps || step >= activeSteps_) {
+            bump(droppedEvents_);
+            return false;
+        }
+
+        const double nearest = static_cast<double>(step + (slot != current_ ? barSteps : 0));
+        float offset = static_cast<float>((stepPos - nearest) * stepMs_);
+        offset = offset < Constants::kMinTimingOffsetMs
+                     ? Constants::kMinTimingOffsetMs
+                     : (offset > Constants::kMaxTimingOffsetMs ? Constants::kMaxTimingOffsetMs
+                                                               : offset);
+        const float v = static_cast<float>(velocity > Constants::kMaxVelocity
+                                               ? Constants::kMaxVelocity
+                                               : velocity) /
+                        static_cast<float>(Constants::kMaxVelocity);
+
+        // Keep the louder hit when two notes quantize to the same step
+        DrumStep& target = bars_[slot].steps[instrument][step];
+        if (v <= target.velocity) return true;
+        uint8_t flags = 0;
+        if (note != kit_.note(instrument)) {
+            if (note == kit_.note(instrument, KitMap::Articulation::Ghost)) {
+                flags = DrumStep::FLAG_GHOST;
+            } else if (note == kit_.note(instrument, KitMap::Articulation::Accent)) {
+                flags = DrumStep::FLAG_ACCENT;
+            }
+        }
+        target = DrumStep(v, offset, flags);
+        return true;
+    }
+
+    /** Close both open bars, pushing any that contain notes (e.g. on stop). */
+    void flush() {
+        if (!open_) return;
+        closeBar(current_);
+        closeBar(current_ ^ 1);
+        open_ = false;
+    }
+
+    /** Pop a completed bar (consumer thread). */
+    bool popBar(DrumBar& bar) { return queue_.pop(bar); }
+
+    /** Number of completed bars waiting. */
+    size_t pendingBars() const { return queue_.size(); }
+
+    /** Notes dropped because they fell outside the active steps (any thread). */
+    uint32_t droppedEvents() const { return droppedEvents_.load(std::memory_order_relaxed); }
+
+    /** Completed bars dropped because the queue was full (any thread). */
+    uint32_t droppedBars() const { return droppedBars_.load(std::memory_order_relaxed); }
+
+  private:
+    // Single writer (audio thread): a relaxed load/store pair, no locked RMW
+    static void bump(std::atomic<uint32_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static double stepDurationMs(double tempoBpm) {
+        return 60000.0 / tempoBpm * Constants::kBeatsPerStep;
+    }
+
+    // Open a fresh current/next pair starting at barStart
+    void openAt(double barStart) {
+        current_ = 0;
+        barStartPpq_[0] = barStart;
+        barStartPpq_[1] = barStart + beatsPerBar_;
+        bars_[0].clear();
+        bars_[1].clear();
+        open_ = true;
+    }
+
+    // Close bars the position has moved past; jumps restart the pair
+    void advanceTo(double ppq, double barStart) {
+        if (!open_) {
+            openAt(barStart);
+            return;
+        }
+        const double halfStep = Constants::kBeatsPerStep * 0.5;
+        const double currentStart = barStartPpq_[current_];
+        if (ppq < currentStart - halfStep || ppq >= currentStart + 2.0 * beatsPerBar_) {
+            flush();
+            openAt(barStart);
+            return;
+        }
+        if (ppq >= currentStart + beatsPerBar_ + halfStep) {
+            closeBar(current_);
+            barStartPpq_[current_] = barStartPpq_[current_ ^ 1] + beatsPerBar_;
+            current_ ^= 1;
+        }
+    }
+
+    void closeBar(int slot) {
+        DrumBar& bar = bars_[slot];
+        if (bar.hasNotes()) {
+            bar.genre = DrumBar::Genre::Uncertain;
+            bar.barIndex =
+                static_cast<int32_t>(std::floor(barStartPpq_[slot] / beatsPerBar_ + 0.5));
+            if (!queue_.push(bar)) bump(droppedBars_);
+        }
+        bar.clear();
+    }
+
+    KitMap kit_;
+    DrumBar bars_[2];
+    double barStartPpq_[2];
+    int current_;
+    bool open_;
+
+    double blockPpq_;
+    double ppqPerSample_;
+    double stepMs_;
+    TimeSignature timeSig_;
+    double beatsPerBar_;
+    int activeSteps_;
+
+    std::atomic<uint32_t> droppedEvents_;
+    std::atomic<uint32_t> droppedBars_;
+    DrumPatternBuffer queue_;
+};
+
+}  // namespace JKDigital
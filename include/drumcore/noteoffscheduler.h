@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Real-time note-off scheduler for fixed-duration drum notes.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/constants.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace JKDigital {
+
+/** What a note-on does to a still-pending note-off of the same note. */
+enum class RetriggerPolicy : uint8_t {
+    Shorten = 0,  ///< Release the old note just before the new note-on
+    Extend = 1    ///< Drop the old note-off; one note-off ends both notes
+};
+
+//------------------------------------------------------------------------
+// NoteOffScheduler - timer wheel keyed by sample time
+//------------------------------------------------------------------------
+/**
+ * Schedules the note-off of every note-on a fixed duration later
+ * (Constants::kNoteDurationSeconds by default) and emits them in the
+ * process block they fall in, at the right sample offset.
+ *
+ * Time is the scheduler's own sample clock, advanced by advance() once per
+ * block, so host loops and jumps never strand a note-off. Call flush() at
+ * the sample of a transport stop, loop wrap or jump to release everything
+ * pending there.
+ *
+ * Each channel/note has at most one pending note-off, so storage is fixed
+ * (one node per MIDI channel and note). Nodes hang off a 256-slot hashed
+ * wheel of 32-sample slots, kept sorted by time, so a block costs one
+ * visit per slot it spans plus one per note-off due; later wheel rounds
+ * wait at the tail of their slot.
+ *
+ * Per block, in event order:
+ *
+ *   if (looped) scheduler.flush(loopOffset, emit);
+ *   for (each note-on) scheduler.noteOn(offset, channel, note, emit);  // then send it
+ *   scheduler.advance(numSamples, emit);
+ *
+ * emit receives const NoteOff& and is called in non-decreasing offset
+ * order, so appending its note-offs between the caller's note-ons keeps
+ * the block's event list sorted.
+ *
+ * Real-time safe: no allocation or locking. Single thread (audio thread).
+ */
+class NoteOffScheduler {
+  public:
+    static constexpr int NUM_CHANNELS = 16;
+    static constexpr int NUM_NOTES = 128;
+    static constexpr int NUM_SLOTS = 256;
+    static constexpr int SLOT_SHIFT = 5;
+
+    /** Samples the wheel covers in one round. */
+    static constexpr int64_t HORIZON = int64_t{NUM_SLOTS} << SLOT_SHIFT;
+
+    /** A due note-off. */
+    struct NoteOff {
+        /** Sample offset within the current block. */
+        int32_t sampleOffset;
+        uint8_t channel;
+        uint8_t note;
+    };
+
+    /** Constructor - 44.1 kHz, Shorten on retrigger, nothing pending. */
+    explicit NoteOffScheduler(double sampleRate = 44100.0,
+                              RetriggerPolicy policy = RetriggerPolicy::Shorten)
+        : policy_(policy) {
+        setSampleRate(sampleRate);
+        reset();
+    }
+
+    /** Set the default note length to kNoteDurationSeconds at a sample rate. */
+    void setSampleRate(double sampleRate) {
+        const double rate = sampleRate > 0.0 ? sampleRate : 44100.0;
+        setNoteDuration(std::llround(Constants::kNoteDurationSeconds * rate));
+    }
+
+    /** Default note length in samples (at least 1). */
+    void setNoteDuration(int64_t samples) { duration_ = samples > 0 ? samples : 1; }
+
+    int64_t noteDuration() const { return duration_; }
+
+    void setRetriggerPolicy(RetriggerPolicy policy) { policy_ = policy; }
+    RetriggerPolicy retriggerPolicy() const { return policy_; }
+
+    /** Drop everything pending without emitting and restart the clock. */
+    void reset() {
+        for (Node& n : nodes_) n = Node();
+        for (int s = 0; s < NUM_SLOTS; ++s) head_[s] = tail_[s] = kNone;
+        now_ = 0;
+        drained_ = 0;
+        pending_ = 0;
+    }
+
+    /**
+     * Schedule the note-off of a note-on.
+     *
+     * First emits note-offs due up to the note-on. If the same note is
+     * still sounding, Shorten emits its note-off at sampleOffset (send it
+     * before this note-on); Extend cancels it.
+     *
+     * @param sampleOffset Note-on offset in the current block (non-decreasing)
+     * @param channel MIDI channel 0-15
+     * @param note MIDI note 0-127
+     * @param emit Callback receiving const NoteOff&
+     * @param durationSamples Note length; 0 uses noteDuration()
+     * @return Number of note-offs emitted
+     */
+    template <typename Fn>
+    size_t noteOn(int32_t sampleOffset, int channel, int note, Fn&& emit,
+                  int64_t durationSamples = 0) {
+        if (channel < 0 || channel >= NUM_CHANNELS || note < 0 || note >= NUM_NOTES) return 0;
+        int64_t start = now_ + (sampleOffset > 0 ? sampleOffset : 0);
+        if (start < drained_ - 1) start = drained_ - 1;  // Out of order: keep emit order
+        size_t emitted = drain(start + 1, emit);
+
+        const int key = channel * NUM_NOTES + note;
+        if (nodes_[key].due != kIdle) {
+            unlink(key);
+            if (policy_ == RetriggerPolicy::Shorten) {
+                emit(noteOff(key, start));
+                ++emitted;
+            }
+        }
+        link(key, start + (durationSamples > 0 ? durationSamples : duration_));
+        return emitted;
+    }
+
+    /**
+     * Emit the note-offs due in the current block and move to the next.
+     *
+     * @param numSamples Block length
+     * @return Number of note-offs emitted
+     */
+    template <typename Fn>
+    size_t advance(int32_t numSamples, Fn&& emit) {
+        const int64_t end = now_ + (numSamples > 0 ? numSamples : 0);
+        const size_t emitted = drain(end, emit);
+        now_ = end;
+        drained_ = end;
+        return emitted;
+    }
+
+    /**
+     * Release everything pending (transport stop, loop wrap or jump).
+     *
+     * Note-offs due before sampleOffset are emitted at their own offsets,
+     * the rest at sampleOffset. Note-ons after the flush point may follow.
+     *
+     * @param sampleOffset Offset of the stop/loop point in the current block
+     * @return Number of note-offs emitted
+     */
+    template <typename Fn>
+    size_t flush(int32_t sampleOffset, Fn&& emit) {
+        const int64_t at = now_ + sampleOffset;
+        size_t emitted = drain(at, emit);
+        if (at > drained_) drained_ = at;
+        const int64_t first = drained_ >> SLOT_SHIFT;
+        for (int64_t g = first; pending_ > 0 && g < first + NUM_SLOTS; ++g) {
+            const int slot = static_cast<int>(g & (NUM_SLOTS - 1));
+            while (head_[slot] != kNone) {
+                const int key = head_[slot];
+                unlink(key);
+                emit(noteOff(key, drained_));
+                ++emitted;
+            }
+        }
+        return emitted;
+    }
+
+    /** Whether a note-off is pending for a channel/note. */
+    bool isPending(int channel, int note) const {
+        return channel >= 0 && channel < NUM_CHANNELS && note >= 0 && note < NUM_NOTES &&
+               nodes_[channel * NUM_NOTES + note].due != kIdle;
+    }
+
+    /** Number of pending note-offs. */
+    size_t pending() const { return pending_; }
+
+    /** Scheduler clock at the start of the current block. */
+    int64_t sampleTime() const { return now_; }
+
+  private:
+    static constexpr int16_t kNone = -1;
+    static constexpr int64_t kIdle = -1;
+
+    struct Node {
+        int64_t due = kIdle;
+        int16_t prev = kNone;
+        int16_t next = kNone;
+    };
+
+    static int slotOf(int64_t due) {
+        return static_cast<int>((due >> SLOT_SHIFT) & (NUM_SLOTS - 1));
+    }
+
+    NoteOff noteOff(int key, int64_t at) const {
+        return {static_cast<int32_t>(at - now_), static_cast<uint8_t>(key / NUM_NOTES),
+                static_cast<uint8_t>(key % NUM_NOTES)};
+    }
+
+    // Insert sorted by due time, after equal times (new note-offs are usually latest)
+    void link(int key, int64_t due) {
+        const int slot = slotOf(due);
+        Node& n = nodes_[key];
+        n.due = due;
+        int16_t after = tail_[slot];
+        while (after != kNone && nodes_[after].due > due) after = nodes_[after].prev;
+        n.prev = after;
+        n.next = after != kNone ? nodes_[after].next : head_[slot];
+        if (n.next != kNone) {
+            nodes_[n.next].prev = static_cast<int16_t>(key);
+        } else {
+            tail_[slot] = static_cast<int16_t>(key);
+        }
+        if (after != kNone) {
+            nodes_[after].next = static_cast<int16_t>(key);
+        } else {
+            head_[slot] = static_cast<int16_t>(key);
+        }
+        ++pending_;
+    }
+
+    void unlink(int key) {
+        Node& n = nodes_[key];
+        const int slot = slotOf(n.due);
+        if (n.prev != kNone) {
+            nodes_[n.prev].next = n.next;
+        } else {
+            head_[slot] = n.next;
+        }
+        if (n.next != kNone) {
+            nodes_[n.next].prev = n.prev;
+        } else {
+            tail_[slot] = n.prev;
+        }
+        n = Node();
+        --pending_;
+    }
+
+    // Emit note-offs due before end, in time order, one slot visit per 32 samples
+    template <typename Fn>
+    size_t drain(int64_t end, Fn& emit) {
+        if (end <= drained_) return 0;
+        size_t emitted = 0;
+        const int64_t last = (end - 1) >> SLOT_SHIFT;
+        for (int64_t g = drained_ >> SLOT_SHIFT; pending_ > 0 && g <= last; ++g) {
+            const int slot = static_cast<int>(g & (NUM_SLOTS - 1));
+            while (head_[slot] != kNone) {
+                const int key = head_[slot];
+                const int64_t due = nodes_[key].due;
+                if (due >= end || (due >> SLOT_SHIFT) != g) break;
+                unlink(key);
+                emit(noteOff(key, due));
+                ++emitted;
+            }
+        }
+        drained_ = end;
+        return emitted;
+    }
+
+    Node nodes_[NUM_CHANNELS * NUM_NOTES];
+    int16_t head_[NUM_SLOTS];
+    int16_t tail_[NUM_SLOTS];
+    int64_t now_;       // Clock at the start of the current block
+    int64_t drained_;   // Everything due before this has been emitted
+    int64_t duration_;
+    size_t pending_;
+    RetriggerPolicy policy_;
+};
+
+}  // namespace JKDigital
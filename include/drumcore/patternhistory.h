@@ -0,0 +1,322 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Copy-on-write undo/redo history with structurally shared bars.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// PatternSnapshot - immutable pattern state
+//------------------------------------------------------------------------
+/**
+ * Immutable pattern: a length and one refcounted, read-only bar per slot.
+ *
+ * Copying a snapshot copies pointers only; snapshots produced by the same
+ * PatternHistory share every bar an edit did not touch. Safe to hand to
+ * another thread, but not to the audio thread: dropping the last
+ * reference frees memory.
+ */
+class PatternSnapshot {
+  public:
+    static constexpr int MAX_BARS = Constants::kMaxPatternLength;
+
+    /** Number of bars. */
+    int numBars() const { return numBars_; }
+
+    /** Bar contents (barIndex must be in 0..numBars-1). */
+    const DrumBar& bar(int barIndex) const {
+        assert(barIndex >= 0 && barIndex < numBars_);
+        return *bars_[barIndex];
+    }
+
+    /** Shared node of a bar (nullptr if out of range). */
+    std::shared_ptr<const DrumBar> barPtr(int barIndex) const {
+        return barIndex >= 0 && barIndex < numBars_ ? bars_[barIndex] : nullptr;
+    }
+
+    /** True if both snapshots reference the same node for a bar. */
+    bool sharesBar(const PatternSnapshot& other, int barIndex) const {
+        return barIndex >= 0 && barIndex < numBars_ && barIndex < other.numBars_ &&
+               bars_[barIndex] == other.bars_[barIndex];
+    }
+
+    /** Serial number of the history state this snapshot belongs to. */
+    uint64_t id() const { return id_; }
+
+  private:
+    friend class PatternHistory;
+
+    std::shared_ptr<const DrumBar> bars_[MAX_BARS];
+    int numBars_ = 0;
+    uint64_t id_ = 0;
+};
+
+//------------------------------------------------------------------------
+// PatternHistory - persistent undo/redo history
+//------------------------------------------------------------------------
+/**
+ * Linear undo/redo history of PatternSnapshots with structural sharing.
+ *
+ * An edit clones only the bars it touches (copy-on-write); every other
+ * bar node is shared with the previous state, so the memory cost of a
+ * state is proportional to the bars it changed, not the pattern length.
+ * Undo and redo move an index: O(1), no copying.
+ *
+ * States are kept within a memory budget: when a commit pushes the total
+ * over it, the oldest states are evicted (the current state always
+ * stays). memoryUsage() counts each live bar node once.
+ *
+ * Editing API (UI/message thread, not thread-safe):
+ *
+ *   PatternHistory::Edit edit = history.beginEdit();
+ *   edit.bar(3).steps[1][8].velocity = 0.7f;   // clones bar 3 only
+ *   history.commit(std::move(edit));
+ */
+class PatternHistory {
+  public:
+    static constexpr int MAX_BARS = PatternSnapshot::MAX_BARS;
+
+    /** Approximate cost of one bar node (payload plus refcount block). */
+    static constexpr size_t kNodeBytes = sizeof(DrumBar) + 2 * sizeof(void*);
+
+    /** Default budget: room for about a thousand distinct bars. */
+    static constexpr size_t kDefaultMemoryBudget = 4u * 1024u * 1024u;
+
+    //--------------------------------------------------------------------
+    // Edit - pending change against the current state
+    //--------------------------------------------------------------------
+    /** Working copy of the current state; touched bars are cloned lazily. */
+    class Edit {
+      public:
+        /** Read a bar without cloning it. */
+        const DrumBar& read(int barIndex) const {
+            assert(barIndex >= 0 && barIndex < MAX_BARS);
+            return owned_[barIndex] ? *owned_[barIndex] : *base_.bars_[barIndex];
+        }
+
+        /** Mutable bar; clones the shared node on first access. */
+        DrumBar& bar(int barIndex) {
+            assert(barIndex >= 0 && barIndex < MAX_BARS);
+            if (!owned_[barIndex]) owned_[barIndex] = std::make_shared<DrumBar>(read(barIndex));
+            return *owned_[barIndex];
+        }
+
+        /** Number of bars in the edited pattern. */
+        int numBars() const { return numBars_; }
+
+        /**
+         * Change the pattern length (clamped to 1..MAX_BARS). Bars revealed
+         * by growing are empty, even if the slot held a bar before a shrink.
+         */
+        void setNumBars(int numBars) {
+            numBars = numBars < 1 ? 1 : (numBars > MAX_BARS ? MAX_BARS : numBars);
+            for (int b = numBars_; b < numBars; ++b) owned_[b] = std::make_shared<DrumBar>();
+            numBars_ = numBars;
+        }
+
+        /** Number of bars cloned so far. */
+        int clonedBars() const {
+            int count = 0;
+            for (int b = 0; b < MAX_BARS; ++b) count += owned_[b] ? 1 : 0;
+            return count;
+        }
+
+      private:
+        friend class PatternHistory;
+
+        explicit Edit(const PatternSnapshot& base) : base_(base), numBars_(base.numBars_) {}
+
+        PatternSnapshot base_;
+        std::shared_ptr<DrumBar> owned_[MAX_BARS];
+        int numBars_;
+    };
+
+    /**
+     * Constructor - history holding one state of empty bars.
+     *
+     * @param memoryBudgetBytes Upper bound for memoryUsage() (at least the
+     *        current state is always kept)
+     */
+    explicit PatternHistory(size_t memoryBudgetBytes = kDefaultMemoryBudget)
+        : budget_(memoryBudgetBytes) {
+        reset(nullptr, Constants::kDefaultPatternLength);
+    }
+
+    /**
+     * Drop all states and start over from a pattern.
+     *
+     * @param bars Initial bars (nullptr for empty bars)
+     * @param numBars Pattern length (clamped to 1..MAX_BARS)
+     */
+    void reset(const DrumBar* bars, int numBars) {
+        numBars = numBars < 1 ? 1 : (numBars > MAX_BARS ? MAX_BARS : numBars);
+        const std::shared_ptr<const DrumBar> empty = std::make_shared<const DrumBar>();
+        PatternSnapshot initial;
+        initial.numBars_ = numBars;
+        initial.id_ = ++nextId_;
+        for (int b = 0; b < MAX_BARS; ++b) {
+            const bool given = bars != nullptr && b < numBars;
+            initial.bars_[b] = given ? std::make_shared<const DrumBar>(bars[b]) : empty;
+        }
+        states_.clear();
+        states_.push_back({initial, countNodes(initial, nullptr)});
+        index_ = 0;
+        recountMemory();
+    }
+
+    /** The current state. */
+    const PatternSnapshot& current() const { return states_[index_].snapshot; }
+
+    /** Start an edit of the current state. */
+    Edit beginEdit() const { return Edit(current()); }
+
+    /**
+     * Commit an edit as a new state after the current one, discarding
+     * the redo tail and evicting the oldest states beyond the budget.
+     * Cloned bars left equal to their original are shared again.
+     *
+     * The edit's cloned bars move into the new state, which stays
+     * immutable; on success the edit is left as a fresh edit of it.
+     *
+     * @return false if the edit changed nothing, or if it was started
+     *         from a state that is no longer current
+     */
+    bool commit(Edit&& edit) {
+        const PatternSnapshot& base = current();
+        if (edit.base_.id_ != base.id_) return false;
+
+        PatternSnapshot next = base;
+        next.numBars_ = edit.numBars_;
+        bool changed = next.numBars_ != base.numBars_;
+        for (int b = 0; b < MAX_BARS; ++b) {
+            if (edit.owned_[b] && !barsEqual(*edit.owned_[b], *base.bars_[b])) {
+                next.bars_[b] = std::move(edit.owned_[b]);
+                changed = true;
+            }
+        }
+        if (!changed) return false;
+        for (std::shared_ptr<DrumBar>& owned : edit.owned_) owned.reset();
+
+        states_.erase(states_.begin() + static_cast<std::ptrdiff_t>(index_) + 1, states_.end());
+        next.id_ = ++nextId_;
+        const size_t introduced = countNodes(next, &base);
+        states_.push_back({next, introduced});
+        index_ = states_.size() - 1;
+        recountMemory();
+        evict();
+        edit.base_ = current();
+        return true;
+    }
+
+    /** Step back one state. Returns false at the oldest state. */
+    bool undo() {
+        if (index_ == 0) return false;
+        --index_;
+        return true;
+    }
+
+    /** Step forward one state. Returns false at the newest state. */
+    bool redo() {
+        if (index_ + 1 >= states_.size()) return false;
+        ++index_;
+        return true;
+    }
+
+    bool canUndo() const { return index_ > 0; }
+    bool canRedo() const { return index_ + 1 < states_.size(); }
+
+    /** Number of states before the current one. */
+    size_t undoDepth() const { return index_; }
+
+    /** Number of states after the current one. */
+    size_t redoDepth() const { return states_.size() - 1 - index_; }
+
+    /** Total number of retained states (including the current one). */
+    size_t numStates() const { return states_.size(); }
+
+    /** Estimated bytes held: distinct bar nodes times kNodeBytes. */
+    size_t memoryUsage() const { return liveNodes_ * kNodeBytes; }
+
+    /** Number of distinct bar nodes held by the retained states. */
+    size_t liveNodes() const { return liveNodes_; }
+
+    /** Memory budget in bytes. */
+    size_t memoryBudget() const { return budget_; }
+
+    /** Change the budget; evicts old states if now over it. */
+    void setMemoryBudget(size_t bytes) {
+        budget_ = bytes;
+        evict();
+    }
+
+  private:
+    struct State {
+        PatternSnapshot snapshot;
+        /** Nodes not shared with the previous retained state. */
+        size_t introduced;
+    };
+
+    static bool barsEqual(const DrumBar& a, const DrumBar& b) {
+        if (a.genre != b.genre || a.role != b.role || a.barIndex != b.barIndex) return false;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int j = 0; j < DrumBar::STEPS_PER_BAR; ++j) {
+                const DrumStep& x = a.steps[i][j];
+                const DrumStep& y = b.steps[i][j];
+                if (x.velocity != y.velocity || x.timingOffsetMs != y.timingOffsetMs ||
+                    x.flags != y.flags) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // States form a chain in which each derives from the one before, so a
+    // node shared by two states is shared by every state between them;
+    // distinct nodes are the sum of what each state adds to its
+    // predecessor. Slots past numBars still hold nodes and are counted.
+    static size_t countNodes(const PatternSnapshot& s, const PatternSnapshot* previous) {
+        size_t count = 0;
+        for (int b = 0; b < MAX_BARS; ++b) {
+            bool seen = previous != nullptr && s.bars_[b] == previous->bars_[b];
+            for (int c = 0; c < b && !seen; ++c) seen = s.bars_[c] == s.bars_[b];
+            count += seen ? 0 : 1;
+        }
+        return count;
+    }
+
+    void recountMemory() {
+        liveNodes_ = 0;
+        for (const State& state : states_) liveNodes_ += state.introduced;
+    }
+
+    void evict() {
+        while (memoryUsage() > budget_ && index_ > 0) {
+            states_.pop_front();
+            --index_;
+            states_.front().introduced = countNodes(states_.front().snapshot, nullptr);
+            recountMemory();
+        }
+    }
+
+    std::deque<State> states_;
+    size_t index_ = 0;
+    size_t budget_;
+    size_t liveNodes_ = 0;
+    uint64_t nextId_ = 0;
+};
+
+}  // namespace JKDigital
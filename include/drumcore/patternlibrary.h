@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Genre/role/time-signature bucketed pattern library index.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/arena.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+#include <drumcore/timesignature.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// PatternLibraryIndex - O(1) bucketed retrieval of library bars
+//------------------------------------------------------------------------
+/**
+ * Immutable index of a bar library, bucketed by (Genre, Role, TimeSignature).
+ *
+ * Bars are copied into one contiguous array sorted by bucket, so a bucket
+ * is a contiguous range: counts and seeded selection are O(1), and
+ * iterating a bucket never touches bars of other buckets.
+ *
+ * Built once (allocates); afterwards all queries are const, allocation-
+ * free and safe to share between plugin instances and threads.
+ */
+class PatternLibraryIndex {
+  public:
+    static constexpr int NUM_GENRES = DrumBar::kNumGenres;
+    static constexpr int NUM_ROLES = 4;
+    static constexpr int NUM_TIME_SIGNATURES = kNumTimeSignatures;
+    static constexpr int NUM_BUCKETS = NUM_GENRES * NUM_ROLES * NUM_TIME_SIGNATURES;
+
+    /** Contiguous view of one bucket. */
+    struct Bucket {
+        const DrumBar* bars;
+        const uint32_t* sourceIndices;
+        size_t count;
+
+        const DrumBar* begin() const { return bars; }
+        const DrumBar* end() const { return bars + count; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const DrumBar& operator[](size_t i) const { return bars[i]; }
+    };
+
+    /** Constructor - initializes an empty index. */
+    PatternLibraryIndex() : offsets_(NUM_BUCKETS + 1, 0) {}
+
+    /**
+     * Build the index from bars sharing one time signature.
+     *
+     * @param bars Library bars (genre and role are read from each bar)
+     * @param count Number of bars
+     * @param timeSig Time signature of every bar
+     */
+    void build(const DrumBar* bars, size_t count, TimeSignature timeSig = TimeSignature::k4_4) {
+        buildWith(bars, count, [timeSig](size_t) { return timeSig; });
+    }
+
+    /**
+     * Build the index from bars with per-bar time signatures.
+     *
+     * @param bars Library bars
+     * @param timeSigs Time signature of each bar
+     * @param count Number of bars
+     */
+    void build(const DrumBar* bars, const TimeSignature* timeSigs, size_t count) {
+        buildWith(bars, count, [timeSigs](size_t i) { return timeSigs[i]; });
+    }
+
+    /** Total number of indexed bars. */
+    size_t size() const { return bars_.size(); }
+
+    /** Number of bars in a bucket, O(1). */
+    size_t count(DrumBar::Genre genre, DrumBar::Role role,
+                 TimeSignature timeSig = TimeSignature::k4_4) const {
+        const int b = bucketIndex(genre, role, timeSig);
+        return b < 0 ? 0 : offsets_[b + 1] - offsets_[b];
+    }
+
+    /** View of one bucket's bars, O(1). */
+    Bucket bucket(DrumBar::Genre genre, DrumBar::Role role,
+                  TimeSignature timeSig = TimeSignature::k4_4) const {
+        const int b = bucketIndex(genre, role, timeSig);
+        if (b < 0 || offsets_[b] == offsets_[b + 1]) return {nullptr, nullptr, 0};
+        return {&bars_[offsets_[b]], &sourceIndices_[offsets_[b]], offsets_[b + 1] - offsets_[b]};
+    }
+
+    /**
+     * Deterministically select a bar from a bucket.
+     *
+     * @param genre Genre to select from
+     * @param role Role to select from
+     * @param timeSig Time signature to select from
+     * @param seed Selection seed (e.g. from Seed::deriveSeed)
+     * @return Selected bar, or nullptr if the bucket is empty
+     */
+    const DrumBar* select(DrumBar::Genre genre, DrumBar::Role role, TimeSignature timeSig,
+                          uint64_t seed) const {
+        const Bucket bkt = bucket(genre, role, timeSig);
+        if (bkt.empty()) return nullptr;
+        // Multiply-shift maps the hash to [0, count) without modulo bias
+        const uint64_t r = Seed::splitmix64(seed) >> 32;
+        return &bkt.bars[(r * static_cast<uint64_t>(bkt.count)) >> 32];
+    }
+
+    /** Index of an indexed bar in the source array passed to build(). */
+    uint32_t sourceIndex(const DrumBar* bar) const {
+        return sourceIndices_[static_cast<size_t>(bar - bars_.data())];
+    }
+
+  private:
+    static int bucketIndex(DrumBar::Genre genre, DrumBar::Role role, TimeSignature timeSig) {
+        const int g = static_cast<int>(genre);
+        const int r = static_cast<int>(role);
+        const int t = static_cast<int>(timeSig);
+        if (g < 0 || g >= NUM_GENRES || r < 0 || r >= NUM_ROLES || t < 0 ||
+            t >= NUM_TIME_SIGNATURES) {
+            return -1;
+        }
+        return (g * NUM_ROLES + r) * NUM_TIME_SIGNATURES + t;
+    }
+
+    // Counting sort: one pass computes keys and counts, one pass scatters.
+    // Keys and cursors are scratch, taken from the thread's arena
+    template <typename TimeSigFn>
+    void buildWith(const DrumBar* bars, size_t count, TimeSigFn timeSigOf) {
+        ScratchArena& scratch = threadScratch();
+        ScratchArena::Scope scope(scratch);
+        std::pmr::vector<int> keys(count, &scratch);
+        std::pmr::vector<size_t> cursor(NUM_BUCKETS + 1, 0, &scratch);
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = bucketIndex(bars[i].genre, bars[i].role, timeSigOf(i));
+            if (keys[i] >= 0) ++cursor[static_cast<size_t>(keys[i]) + 1];
+        }
+        for (int b = 0; b < NUM_BUCKETS; ++b) cursor[b + 1] += cursor[b];
+        offsets_.assign(cursor.begin(), cursor.end());
+
+        bars_.resize(offsets_[NUM_BUCKETS]);
+        sourceIndices_.resize(offsets_[NUM_BUCKETS]);
+        for (size_t i = 0; i < count; ++i) {
+            if (keys[i] < 0) continue;
+            const size_t slot = cursor[static_cast<size_t>(keys[i])]++;
+            bars_[slot] = bars[i];
+            sourceIndices_[slot] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<DrumBar> bars_;
+    std::vector<uint32_t> sourceIndices_;
+    std::vector<size_t> offsets_;
+};
+
+}  // namespace JKDigital
@@ -0,0 +1,332 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Ordered transform chain with memoized per-stage, per-bar outputs.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/seed.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace JKDigital {
+
+/** Arguments passed to a transform for one bar. */
+struct TransformContext {
+    /** Stage parameters (numParams values). */
+    const float* params;
+    int numParams;
+    /** Seed::deriveSeed(masterSeed, stageIndex, barIndex). */
+    uint64_t seed;
+    uint32_t stageIndex;
+    uint32_t barIndex;
+};
+
+/**
+ * Transform applied in place to one bar.
+ *
+ * Must be a pure function of the bar and the context: the pipeline
+ * reuses a cached result whenever both are unchanged.
+ */
+using TransformFn = void (*)(DrumBar& bar, const TransformContext& ctx);
+
+//------------------------------------------------------------------------
+// TransformPipeline - memoized transform chain
+//------------------------------------------------------------------------
+/**
+ * Ordered list of transforms applied to every bar of a pattern.
+ *
+ * Each stage caches its output for every bar, keyed on a chain hash:
+ * the hash of the input bar folded with the function, parameters and
+ * seed of every enabled stage up to and including this one. Changing a
+ * parameter of stage k changes the keys of stages k..n only, so the
+ * stages before it are served from the cache; changing the input of one
+ * bar recomputes that bar only. Moving a knob on the last stage of a
+ * ten-stage chain costs one transform call per bar.
+ *
+ * Every stage/bar slot holds two outputs (the two most recently used
+ * keys), so flipping between two states upstream - a bypass on and off,
+ * or an A/B parameter comparison - recomputes each side once.
+ *
+ * Evaluation is lazy (output) or explicit (process). The cache is
+ * allocated by addStage; evaluation itself does not allocate. Not
+ * thread-safe: use from one (non-audio) thread and hand results to the
+ * audio thread through a DrumPatternBuffer.
+ */
+class TransformPipeline {
+  public:
+    static constexpr int MAX_STAGES = 16;
+    static constexpr int MAX_PARAMS = 8;
+    static constexpr int MAX_BARS = Constants::kMaxPatternLength;
+
+    /** Constructor - no stages, one empty input bar, master seed 0. */
+    TransformPipeline() : numStages_(0), numBars_(1), masterSeed_(0), stageRuns_(0) {
+        std::memset(keys_, 0, sizeof(keys_));
+        std::memset(mru_, 0, sizeof(mru_));
+        for (int b = 0; b < MAX_BARS; ++b) {
+            inputHash_[b] = hashBar(inputs_[b]);
+            outputs_[b] = &inputs_[b];
+        }
+    }
+
+    TransformPipeline(const TransformPipeline&) = delete;
+    TransformPipeline& operator=(const TransformPipeline&) = delete;
+
+    /**
+     * Append a stage to the end of the chain.
+     *
+     * @param fn Transform function
+     * @param params Initial parameters (may be nullptr if numParams is 0)
+     * @param numParams Number of parameters (0 to MAX_PARAMS)
+     * @return Stage index, or -1 if the chain is full or the arguments are invalid
+     */
+    int addStage(TransformFn fn, const float* params = nullptr, int numParams = 0) {
+        if (fn == nullptr || numStages_ >= MAX_STAGES || numParams < 0 || numParams > MAX_PARAMS ||
+            (numParams > 0 && params == nullptr)) {
+            return -1;
+        }
+        const int index = numStages_++;
+        Stage& stage = stages_[index];
+        stage.fn = fn;
+        stage.numParams = numParams;
+        for (int i = 0; i < MAX_PARAMS; ++i) stage.params[i] = i < numParams ? params[i] : 0.0f;
+        stage.enabled = true;
+        updateStageHash(index);
+        cache_.resize(static_cast<size_t>(numStages_) * MAX_BARS * NUM_WAYS);
+        std::memset(keys_[index], 0, sizeof(keys_[index]));
+        return index;
+    }
+
+    /** Remove every stage and drop the cache (inputs are kept). */
+    void clearStages() {
+        numStages_ = 0;
+        cache_.clear();
+        std::memset(keys_, 0, sizeof(keys_));
+        for (int b = 0; b < MAX_BARS; ++b) outputs_[b] = &inputs_[b];
+    }
+
+    /** Number of stages in the chain. */
+    int numStages() const { return numStages_; }
+
+    /**
+     * Set one parameter of a stage. Invalidates that stage and the ones
+     * after it; a value equal to the current one changes nothing.
+     *
+     * @return false if the stage or parameter index is out of range
+     */
+    bool setParam(int stage, int index, float value) {
+        if (stage < 0 || stage >= numStages_ || index < 0 || index >= stages_[stage].numParams) {
+            return false;
+        }
+        stages_[stage].params[index] = value;
+        updateStageHash(stage);
+        return true;
+    }
+
+    /** Replace all parameters of a stage (numParams must match addStage). */
+    bool setParams(int stage, const float* params, int numParams) {
+        if (stage < 0 || stage >= numStages_ || params == nullptr ||
+            numParams != stages_[stage].numParams) {
+            return false;
+        }
+        for (int i = 0; i < numParams; ++i) stages_[stage].params[i] = params[i];
+        updateStageHash(stage);
+        return true;
+    }
+
+    /** Current value of a stage parameter (0.0f if out of range). */
+    float param(int stage, int index) const {
+        if (stage < 0 || stage >= numStages_ || index < 0 || index >= stages_[stage].numParams) {
+            return 0.0f;
+        }
+        return stages_[stage].params[index];
+    }
+
+    /**
+     * Bypass or re-enable a stage. A bypassed stage passes its input
+     * through and keeps its cache. The stages after it keep the outputs
+     * of both chains, so with unchanged upstream input each direction
+     * recomputes them once and later toggles recompute nothing.
+     */
+    bool setEnabled(int stage, bool enabled) {
+        if (stage < 0 || stage >= numStages_) return false;
+        stages_[stage].enabled = enabled;
+        return true;
+    }
+
+    /** True if the stage exists and is not bypassed. */
+    bool isEnabled(int stage) const {
+        return stage >= 0 && stage < numStages_ && stages_[stage].enabled;
+    }
+
+    /** Set the master seed; every stage is recomputed on next evaluation. */
+    void setMasterSeed(uint64_t masterSeed) {
+        if (masterSeed == masterSeed_) return;
+        masterSeed_ = masterSeed;
+        for (int k = 0; k < numStages_; ++k) updateStageHash(k);
+    }
+
+    uint64_t masterSeed() const { return masterSeed_; }
+
+    /**
+     * Set the input of one bar. Only that bar is recomputed, and only if
+     * its contents changed.
+     *
+     * @return false if barIndex is out of range
+     */
+    bool setInput(int barIndex, const DrumBar& bar) {
+        if (barIndex < 0 || barIndex >= MAX_BARS) return false;
+        if (barIndex >= numBars_) numBars_ = barIndex + 1;
+        const uint64_t hash = hashBar(bar);
+        if (hash == inputHash_[barIndex]) return true;
+        inputs_[barIndex] = bar;
+        inputHash_[barIndex] = hash;
+        return true;
+    }
+
+    /**
+     * Set the inputs of a whole pattern (bars whose contents are
+     * unchanged keep their cached outputs).
+     *
+     * @return Number of bars set (clamped to MAX_BARS)
+     */
+    int setInput(const DrumBar* bars, int numBars) {
+        if (bars == nullptr || numBars <= 0) return 0;
+        if (numBars > MAX_BARS) numBars = MAX_BARS;
+        numBars_ = numBars;
+        for (int b = 0; b < numBars; ++b) setInput(b, bars[b]);
+        return numBars;
+    }
+
+    /** Number of bars in the pattern. */
+    int numBars() const { return numBars_; }
+
+    /** Input of a bar (barIndex must be in range). */
+    const DrumBar& input(int barIndex) const { return inputs_[barIndex]; }
+
+    /**
+     * Output of the last enabled stage for one bar, evaluating stale
+     * stages first (barIndex must be in range).
+     */
+    const DrumBar& output(int barIndex) {
+        evaluate(barIndex);
+        return *outputs_[barIndex];
+    }
+
+    /** Evaluate every bar; returns the number of transform calls made. */
+    uint64_t process() {
+        const uint64_t before = stageRuns_;
+        for (int b = 0; b < numBars_; ++b) evaluate(b);
+        return stageRuns_ - before;
+    }
+
+    /** Drop all cached stage outputs (forces a full recompute). */
+    void invalidate() { std::memset(keys_, 0, sizeof(keys_)); }
+
+    /** Total transform calls since construction (cache misses). */
+    uint64_t stageRuns() const { return stageRuns_; }
+
+    /**
+     * Content hash of a bar: every step field, genre, role and barIndex.
+     * Padding is never read, so equal bars always hash equal.
+     */
+    static uint64_t hashBar(const DrumBar& bar) {
+        uint64_t h = Seed::splitmix64((static_cast<uint64_t>(bar.genre) << 40) ^
+                                      (static_cast<uint64_t>(bar.role) << 32) ^
+                                      static_cast<uint32_t>(bar.barIndex));
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int j = 0; j < DrumBar::STEPS_PER_BAR; ++j) {
+                const DrumStep& step = bar.steps[i][j];
+                uint32_t velocity, offset;
+                std::memcpy(&velocity, &step.velocity, sizeof(velocity));
+                std::memcpy(&offset, &step.timingOffsetMs, sizeof(offset));
+                h = Seed::splitmix64(h ^ ((static_cast<uint64_t>(velocity) << 32) | offset));
+                h ^= step.flags;
+            }
+        }
+        return h;
+    }
+
+  private:
+    struct Stage {
+        TransformFn fn = nullptr;
+        float params[MAX_PARAMS] = {};
+        int numParams = 0;
+        bool enabled = true;
+        /** Hash of fn, params, stage index and master seed. */
+        uint64_t hash = 0;
+    };
+
+    void updateStageHash(int k) {
+        Stage& stage = stages_[k];
+        uint64_t h = Seed::splitmix64(reinterpret_cast<uintptr_t>(stage.fn));
+        h = Seed::splitmix64(h ^ masterSeed_);
+        h = Seed::splitmix64(h ^ static_cast<uint64_t>(k));
+        for (int i = 0; i < stage.numParams; ++i) {
+            uint32_t bits;
+            std::memcpy(&bits, &stage.params[i], sizeof(bits));
+            h = Seed::splitmix64(h ^ bits);
+        }
+        stage.hash = h;
+    }
+
+    void evaluate(int b) {
+        uint64_t key = inputHash_[b];
+        const DrumBar* src = &inputs_[b];
+        for (int k = 0; k < numStages_; ++k) {
+            const Stage& stage = stages_[k];
+            if (!stage.enabled) continue;
+
+            key = Seed::splitmix64(key ^ stage.hash);
+            key |= 1;  // 0 marks an empty slot
+            uint64_t* keys = keys_[k][b];
+            int way = keys[0] == key ? 0 : (keys[1] == key ? 1 : -1);
+            const bool hit = way >= 0;
+            if (!hit) way = mru_[k][b] ^ 1;  // Replace the least recently used
+            mru_[k][b] = static_cast<uint8_t>(way);
+            DrumBar& out = cache_[(static_cast<size_t>(k) * MAX_BARS + static_cast<size_t>(b)) *
+                                      NUM_WAYS +
+                                  static_cast<size_t>(way)];
+            if (!hit) {
+                out = *src;
+                const TransformContext ctx = {
+                    stage.params, stage.numParams,
+                    Seed::deriveSeed(masterSeed_, static_cast<uint32_t>(k),
+                                     static_cast<uint32_t>(b)),
+                    static_cast<uint32_t>(k), static_cast<uint32_t>(b)};
+                stage.fn(out, ctx);
+                keys[way] = key;
+                ++stageRuns_;
+            }
+            src = &out;
+        }
+        outputs_[b] = src;
+    }
+
+    Stage stages_[MAX_STAGES];
+    int numStages_;
+    int numBars_;
+    uint64_t masterSeed_;
+    uint64_t stageRuns_;
+
+    DrumBar inputs_[MAX_BARS];
+    uint64_t inputHash_[MAX_BARS];
+    const DrumBar* outputs_[MAX_BARS];
+
+    /** Outputs kept per stage/bar slot. */
+    static constexpr int NUM_WAYS = 2;
+
+    /** Cached outputs, [(stage * MAX_BARS + bar) * NUM_WAYS + way]. */
+    std::vector<DrumBar> cache_;
+    /** Chain key of each cached output (0 = empty). */
+    uint64_t keys_[MAX_STAGES][MAX_BARS][NUM_WAYS];
+    /** Most recently used way of each slot. */
+    uint8_t mru_[MAX_STAGES][MAX_BARS];
+};
+
+}  // namespace JKDigital
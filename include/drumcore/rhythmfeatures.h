@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Fast rhythmic feature extraction from occupancy bitmasks.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+#include <drumcore/bitutils.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/timesignature.h>
+
+#include <cstdint>
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// RhythmFeatures - fixed-length rhythmic descriptor of one bar
+//------------------------------------------------------------------------
+/**
+ * Fixed-length rhythmic feature vector for one bar.
+ *
+ * Layout (all values roughly 0.0-1.0):
+ * - [0..9]  onset density per instrument (onsets / active steps)
+ * - [10]    syncopation index
+ * - [11]    backbeat strength
+ * - [12]    off-beat ratio
+ * - [13]    velocity variance
+ * - [14]    overall onset density
+ * - [15]    ride share of timekeeping (ride / (ride + hats))
+ */
+struct RhythmFeatures {
+    static constexpr int NUM_FEATURES = 16;
+
+    static constexpr int kDensity = 0;
+    static constexpr int kSyncopation = 10;
+    static constexpr int kBackbeat = 11;
+    static constexpr int kOffbeat = 12;
+    static constexpr int kVelocityVariance = 13;
+    static constexpr int kTotalDensity = 14;
+    static constexpr int kRideShare = 15;
+
+    float values[NUM_FEATURES] = {};
+
+    /** Total number of onsets in the bar's active steps. */
+    int onsetCount = 0;
+};
+
+/**
+ * Feature extraction working on per-instrument occupancy bitmasks.
+ *
+ * One pass over the velocity plane builds the masks and velocity moments
+ * (four steps at a time with SSE2: a compare and movemask per group);
+ * everything else is popcounts against the TimeSignatureDescriptor's
+ * precomputed metric-position masks. Allocation-free.
+ */
+namespace RhythmAnalysis {
+
+// Instrument rows used by the rhythmic features
+constexpr int kSnare = 1;
+constexpr int kClosedHat = 2;
+constexpr int kOpenHat = 3;
+constexpr int kRim = 4;
+constexpr int kRide = 8;
+
+/** Step masks per metric role for one time signature. */
+struct MetricMasks {
+    uint32_t active = 0;
+    uint32_t backbeat = 0;   // Starts of odd-numbered beats (2 and 4 in 4/4)
+    uint32_t offbeat = 0;    // 8th-note positions between beats
+    uint32_t weak = 0;       // 16th and 32nd positions
+    uint32_t stronger[TimeSignatureDescriptor::STEPS_PER_BAR] = {};  // Next stronger step
+    int activeSteps = 32;
+};
+
+/** Build metric masks from a time-signature descriptor. */
+constexpr MetricMasks makeMetricMasks(const TimeSignatureDescriptor& d) {
+    MetricMasks m;
+    m.active = d.activeMask;
+    m.activeSteps = d.activeSteps;
+    for (int s = 0; s < d.activeSteps; ++s) {
+        const uint32_t bit = 1u << s;
+        const uint8_t w = d.metricWeight[s];
+        if (w == TimeSignatureDescriptor::WEIGHT_BEAT && (d.beatIndex[s] & 1) != 0) {
+            m.backbeat |= bit;
+        }
+        if (w == TimeSignatureDescriptor::WEIGHT_8TH) m.offbeat |= bit;
+        if (w <= TimeSignatureDescriptor::WEIGHT_16TH) m.weak |= bit;
+
+        // Next position (wrapping to the downbeat) that is metrically stronger
+        for (int k = 1; k <= d.activeSteps; ++k) {
+            const int next = (s + k) % d.activeSteps;
+            if (d.metricWeight[next] > w) {
+                m.stronger[s] = 1u << next;
+                break;
+            }
+        }
+    }
+    return m;
+}
+
+/** Precomputed metric masks for the TimeSignature enum. */
+inline constexpr MetricMasks kMetricMasks[kNumTimeSignatures] = {
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[0]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[1]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[2]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[3]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[4]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[5]),
+    makeMetricMasks(TimeSignatureUtils::kDescriptors[6])};
+
+/**
+ * Extract features from a bar.
+ *
+ * @param bar Bar to analyze
+ * @param masks Metric masks for the bar's time signature
+ * @param out Feature vector to fill
+ */
+DRUMCORE_DECL void extract(const DrumBar& bar, const MetricMasks& masks, RhythmFeatures& out);
+
+/** Extract features from a bar in one of the enum time signatures. */
+inline RhythmFeatures extract(const DrumBar& bar, TimeSignature timeSig = TimeSignature::k4_4) {
+    const int t = static_cast<int>(timeSig);
+    RhythmFeatures features;
+    extract(bar, kMetricMasks[(t >= 0 && t < kNumTimeSignatures) ? t : 0], features);
+    return features;
+}
+
+}  // namespace RhythmAnalysis
+}  // namespace JKDigital
+
+#if !defined(DRUMCORE_SEPARATE_COMPILATION)
+#include <drumcore/impl/rhythmfeatures.ipp>
+#endif
@@ -0,0 +1,354 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Audio-callback profiling scopes with budget tracking and histograms.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/bitutils.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// RtHistogram - lock-free log-bucketed duration histogram
+//------------------------------------------------------------------------
+/**
+ * Log-bucketed histogram of durations in nanoseconds.
+ *
+ * Each power-of-two octave is split into 4 linear sub-buckets, so any
+ * recorded value is known to within 25%. Values of 2^41 ns (about 37
+ * minutes) and above share the last bucket.
+ *
+ * Single writer (the audio thread) with any number of concurrent readers:
+ * the writer uses relaxed load/store pairs instead of read-modify-write
+ * instructions, readers see a slightly stale but consistent-enough view.
+ */
+class RtHistogram {
+  public:
+    static constexpr int SUB_BUCKETS = 4;
+    static constexpr int MAX_OCTAVE = 40;
+    static constexpr int NUM_BUCKETS = MAX_OCTAVE * SUB_BUCKETS;
+
+    RtHistogram() { reset(); }
+
+    RtHistogram(const RtHistogram&) = delete;
+    RtHistogram& operator=(const RtHistogram&) = delete;
+
+    /** Bucket index of a duration. */
+    static int bucketOf(uint64_t ns) {
+        if (ns < SUB_BUCKETS) return static_cast<int>(ns);
+        const int msb = BitUtils::highestBit64(ns);
+        if (msb > MAX_OCTAVE) return NUM_BUCKETS - 1;
+        const int sub = static_cast<int>((ns >> (msb - 2)) & (SUB_BUCKETS - 1));
+        return (msb - 1) * SUB_BUCKETS + sub;
+    }
+
+    /** Smallest duration falling in a bucket. */
+    static uint64_t bucketLowerBound(int bucket) {
+        if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+        const int msb = bucket / SUB_BUCKETS + 1;
+        const uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+        return (SUB_BUCKETS + sub) << (msb - 2);
+    }
+
+    /** Largest duration falling in a bucket. */
+    static uint64_t bucketUpperBound(int bucket) {
+        if (bucket >= NUM_BUCKETS - 1) return UINT64_MAX;
+        return bucketLowerBound(bucket + 1) - 1;
+    }
+
+    /** Record a duration (writer thread only). */
+    void record(uint64_t ns) {
+        bump(buckets_[bucketOf(ns)]);
+        bump(count_);
+        sum_.store(sum_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > max_.load(std::memory_order_relaxed)) max_.store(ns, std::memory_order_relaxed);
+    }
+
+    /** Clear all data (writer thread only, or while the writer is idle). */
+    void reset() {
+        for (int b = 0; b < NUM_BUCKETS; ++b) buckets_[b].store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /** Number of recorded durations. */
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    /** Largest recorded duration. */
+    uint64_t maxNs() const { return max_.load(std::memory_order_relaxed); }
+
+    /** Mean recorded duration (0 if empty). */
+    double meanNs() const {
+        const uint64_t n = count();
+        return n > 0 ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    /** Count in one bucket. */
+    uint64_t bucketCount(int bucket) const {
+        return buckets_[bucket].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Duration at or below which a fraction of recorded durations fall.
+     *
+     * Returns the upper bound of the bucket holding the percentile, capped
+     * at the recorded maximum.
+     *
+     * @param fraction Percentile as a fraction (e.g. 0.99)
+     * @return Duration in ns (0 if empty)
+     */
+    uint64_t percentileNs(double fraction) const {
+        uint64_t total = 0;
+        uint64_t counts[NUM_BUCKETS];
+        for (int b = 0; b < NUM_BUCKETS; ++b) {
+            counts[b] = bucketCount(b);
+            total += counts[b];
+        }
+        if (total == 0) return 0;
+        fraction = fraction < 0.0 ? 0.0 : (fraction > 1.0 ? 1.0 : fraction);
+        uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5);
+        rank = rank < 1 ? 1 : rank;
+
+        const uint64_t maxValue = maxNs();
+        uint64_t seen = 0;
+        for (int b = 0; b < NUM_BUCKETS; ++b) {
+            seen += counts[b];
+            if (seen >= rank) {
+                const uint64_t upper = bucketUpperBound(b);
+                return upper < maxValue ? upper : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+  private:
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> buckets_[NUM_BUCKETS];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+//------------------------------------------------------------------------
+// RtProfiler - per-callback budget tracking with named stages
+//------------------------------------------------------------------------
+/**
+ * Profiles an audio callback against its real-time budget.
+ *
+ * The budget is one block's duration (blockSize / sampleRate). Each
+ * CallbackScope records the callback duration in a histogram and counts
+ * overruns; StageScopes record named sub-stages (pattern pop, render,
+ * humanize, ...) in their own histograms and may nest.
+ *
+ * Stages are registered up front from a non-real-time thread. Recording is
+ * lock-free and allocation-free from one audio thread; statistics can be
+ * read concurrently from a UI or monitoring thread. Timestamps come from
+ * std::chrono::steady_clock (vDSO clock_gettime on Linux, QPC on Windows).
+ *
+ *   void process(ProcessData& data) {
+ *       RtProfiler::CallbackScope cb(profiler);
+ *       { RtProfiler::StageScope s(profiler, popStage); ... }
+ *       { RtProfiler::StageScope s(profiler, renderStage); ... }
+ *   }
+ */
+class RtProfiler {
+  public:
+    static constexpr int MAX_STAGES = 8;
+    static constexpr int MAX_NAME_LENGTH = 31;
+
+    /** Snapshot of one histogram. */
+    struct Stats {
+        uint64_t count = 0;
+        uint64_t overruns = 0;
+        uint64_t budgetNs = 0;
+        uint64_t worstNs = 0;
+        double meanNs = 0.0;
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+        uint64_t p999Ns = 0;
+    };
+
+    /** Monotonic timestamp in nanoseconds. */
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /** Constructor - 512-sample blocks at 44.1 kHz, no stages. */
+    RtProfiler() : numStages_(0), budgetNs_(0), overruns_(0), lastNs_(0), resetRequested_(false) {
+        for (int s = 0; s < MAX_STAGES; ++s) names_[s][0] = '\0';
+        setBlockConfig(512, 44100.0);
+    }
+
+    RtProfiler(const RtProfiler&) = delete;
+    RtProfiler& operator=(const RtProfiler&) = delete;
+
+    /**
+     * Set the callback budget from the host block configuration.
+     *
+     * @param blockSize Maximum samples per process call
+     * @param sampleRate Sample rate in Hz
+     */
+    void setBlockConfig(int blockSize, double sampleRate) {
+        const double ns = sampleRate > 0.0 && blockSize > 0 ? blockSize * 1e9 / sampleRate : 0.0;
+        budgetNs_.store(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+    }
+
+    /** Callback budget in nanoseconds. */
+    uint64_t budgetNs() const { return budgetNs_.load(std::memory_order_relaxed); }
+
+    /**
+     * Register a named stage (not from the audio thread).
+     *
+     * @param name Stage name (truncated to MAX_NAME_LENGTH characters)
+     * @return Stage index, the existing index if the name is registered,
+     *         or -1 if all MAX_STAGES slots are used
+     */
+    int addStage(const char* name) {
+        const int existing = findStage(name);
+        if (existing >= 0) return existing;
+        const int index = numStages_.load(std::memory_order_relaxed);
+        if (index >= MAX_STAGES) return -1;
+        std::strncpy(names_[index], name, MAX_NAME_LENGTH);
+        names_[index][MAX_NAME_LENGTH] = '\0';
+        numStages_.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    /** Index of a registered stage, or -1. */
+    int findStage(const char* name) const {
+        const int n = numStages_.load(std::memory_order_acquire);
+        for (int s = 0; s < n; ++s) {
+            if (std::strncmp(names_[s], name, MAX_NAME_LENGTH) == 0) return s;
+        }
+        return -1;
+    }
+
+    /** Number of registered stages. */
+    int numStages() const { return numStages_.load(std::memory_order_acquire); }
+
+    /** Name of a registered stage. */
+    const char* stageName(int stage) const { return names_[stage]; }
+
+    /** Record a callback duration (normally done by CallbackScope). */
+    void recordCallback(uint64_t ns) {
+        if (resetRequested_.load(std::memory_order_acquire)) reset();
+        callback_.record(ns);
+        lastNs_.store(ns, std::memory_order_relaxed);
+        if (ns > budgetNs_.load(std::memory_order_relaxed)) {
+            overruns_.store(overruns_.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        }
+    }
+
+    /** Record a stage duration (normally done by StageScope). */
+    void recordStage(int stage, uint64_t ns) {
+        if (stage >= 0 && stage < MAX_STAGES) stages_[stage].record(ns);
+    }
+
+    /** Callback statistics. */
+    Stats callbackStats() const {
+        Stats stats = statsOf(callback_);
+        stats.overruns = overruns_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /** Statistics of one stage (overruns are not tracked per stage). */
+    Stats stageStats(int stage) const {
+        return (stage >= 0 && stage < MAX_STAGES) ? statsOf(stages_[stage]) : Stats();
+    }
+
+    /** Callback histogram. */
+    const RtHistogram& callbackHistogram() const { return callback_; }
+
+    /** Stage histogram. */
+    const RtHistogram& stageHistogram(int stage) const { return stages_[stage]; }
+
+    /** Last callback duration as a fraction of the budget (1.0 = full). */
+    double lastLoad() const {
+        const uint64_t budget = budgetNs();
+        return budget > 0
+                   ? static_cast<double>(lastNs_.load(std::memory_order_relaxed)) / budget
+                   : 0.0;
+    }
+
+    /** Request a reset; applied by the audio thread at its next callback. */
+    void requestReset() { resetRequested_.store(true, std::memory_order_release); }
+
+    /** Reset immediately (only while the audio thread is not recording). */
+    void reset() {
+        callback_.reset();
+        for (int s = 0; s < MAX_STAGES; ++s) stages_[s].reset();
+        overruns_.store(0, std::memory_order_relaxed);
+        lastNs_.store(0, std::memory_order_relaxed);
+        resetRequested_.store(false, std::memory_order_relaxed);
+    }
+
+    /** RAII scope timing one audio callback. */
+    class CallbackScope {
+      public:
+        explicit CallbackScope(RtProfiler& profiler) : profiler_(profiler), start_(now()) {}
+        ~CallbackScope() { profiler_.recordCallback(now() - start_); }
+
+        CallbackScope(const CallbackScope&) = delete;
+        CallbackScope& operator=(const CallbackScope&) = delete;
+
+      private:
+        RtProfiler& profiler_;
+        uint64_t start_;
+    };
+
+    /** RAII scope timing one named stage. */
+    class StageScope {
+      public:
+        StageScope(RtProfiler& profiler, int stage)
+            : profiler_(profiler), stage_(stage), start_(now()) {}
+        ~StageScope() { profiler_.recordStage(stage_, now() - start_); }
+
+        StageScope(const StageScope&) = delete;
+        StageScope& operator=(const StageScope&) = delete;
+
+      private:
+        RtProfiler& profiler_;
+        int stage_;
+        uint64_t start_;
+    };
+
+  private:
+    Stats statsOf(const RtHistogram& h) const {
+        Stats stats;
+        stats.count = h.count();
+        stats.budgetNs = budgetNs();
+        stats.worstNs = h.maxNs();
+        stats.meanNs = h.meanNs();
+        stats.p50Ns = h.percentileNs(0.5);
+        stats.p90Ns = h.percentileNs(0.9);
+        stats.p99Ns = h.percentileNs(0.99);
+        stats.p999Ns = h.percentileNs(0.999);
+        return stats;
+    }
+
+    RtHistogram callback_;
+    RtHistogram stages_[MAX_STAGES];
+    char names_[MAX_STAGES][MAX_NAME_LENGTH + 1];
+    std::atomic<int> numStages_;
+    std::atomic<uint64_t> budgetNs_;
+    std::atomic<uint64_t> overruns_;
+    std::atomic<uint64_t> lastNs_;
+    std::atomic<bool> resetRequested_;
+};
+
+}  // namespace JKDigital
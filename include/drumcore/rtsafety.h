@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Opt-in real-time safety checker for audio-thread scopes.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(DRUMCORE_RT_CHECKS)
+#include <atomic>
+#endif
+
+namespace JKDigital {
+
+/**
+ * Real-time safety checking for audio-thread code.
+ *
+ * With DRUMCORE_RT_CHECKS defined (set by linking the drumcore_rtcheck
+ * target, Linux/glibc only), an RtScope marks the current thread real-time
+ * and interposed hooks report heap allocation/free, pthread_mutex_lock,
+ * sleeps and file I/O made while it is active. Each violation is counted
+ * and passed to the handler; the default handler prints the call and a
+ * stack trace to stderr.
+ *
+ * Without DRUMCORE_RT_CHECKS everything here compiles to nothing.
+ */
+namespace RtSafety {
+
+/** Kinds of real-time violations. */
+enum class Violation { Allocation = 0, Deallocation = 1, MutexLock = 2, Sleep = 3, FileIo = 4 };
+
+/** Number of values in the Violation enum. */
+constexpr int kNumViolations = 5;
+
+/**
+ * Violation callback.
+ *
+ * Runs on the offending thread with checking suspended; it must not throw.
+ *
+ * @param violation Kind of violation
+ * @param function Name of the intercepted function
+ */
+using Handler = void (*)(Violation violation, const char* function);
+
+#if defined(DRUMCORE_RT_CHECKS)
+
+namespace detail {
+inline thread_local int rtDepth = 0;
+inline thread_local int reporting = 0;
+inline std::atomic<uint32_t> counts[kNumViolations] = {};
+inline std::atomic<Handler> handler{nullptr};
+}  // namespace detail
+
+/** Default handler: prints the violation and a backtrace (defined by drumcore_rtcheck). */
+void defaultHandler(Violation violation, const char* function);
+
+/** True when checking is compiled in. */
+constexpr bool enabled() {
+    return true;
+}
+
+/** True while the calling thread is inside an RtScope. */
+inline bool isRealtimeThread() {
+    return detail::rtDepth > 0;
+}
+
+/** Called by the hooks: counts and reports a violation on real-time threads. */
+inline void check(Violation violation, const char* function) {
+    if (detail::rtDepth <= 0 || detail::reporting != 0) return;
+    detail::reporting = 1;
+    detail::counts[static_cast<int>(violation)].fetch_add(1, std::memory_order_relaxed);
+    const Handler h = detail::handler.load(std::memory_order_acquire);
+    (h != nullptr ? h : defaultHandler)(violation, function);
+    detail::reporting = 0;
+}
+
+/** Replace the violation handler (nullptr restores the default). */
+inline void setHandler(Handler h) {
+    detail::handler.store(h, std::memory_order_release);
+}
+
+/** Number of violations of one kind since the last reset. */
+inline uint32_t violationCount(Violation violation) {
+    return detail::counts[static_cast<int>(violation)].load(std::memory_order_relaxed);
+}
+
+/** Number of violations of all kinds since the last reset. */
+inline uint32_t totalViolations() {
+    uint32_t total = 0;
+    for (int v = 0; v < kNumViolations; ++v) {
+        total += detail::counts[v].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/** Reset all violation counters. */
+inline void resetCounts() {
+    for (int v = 0; v < kNumViolations; ++v) detail::counts[v].store(0, std::memory_order_relaxed);
+}
+
+#else
+
+constexpr bool enabled() {
+    return false;
+}
+inline bool isRealtimeThread() {
+    return false;
+}
+inline void check(Violation, const char*) {}
+inline void setHandler(Handler) {}
+inline uint32_t violationCount(Violation) {
+    return 0;
+}
+inline uint32_t totalViolations() {
+    return 0;
+}
+inline void resetCounts() {}
+
+#endif
+
+}  // namespace RtSafety
+
+/**
+ * RAII guard marking the current thread real-time for its lifetime.
+ *
+ * Scopes nest. Use at the top of the audio process() callback, next to
+ * DenormalGuard:
+ *   void process(float** out, int frames) {
+ *       DenormalGuard guard;
+ *       RtScope rt;
+ *       // ... any malloc/lock/sleep/file I/O here is reported
+ *   }
+ */
+class RtScope {
+  public:
+#if defined(DRUMCORE_RT_CHECKS)
+    RtScope() noexcept { ++RtSafety::detail::rtDepth; }
+    ~RtScope() noexcept { --RtSafety::detail::rtDepth; }
+#else
+    RtScope() noexcept {}
+#endif
+
+    RtScope(const RtScope&) = delete;
+    RtScope& operator=(const RtScope&) = delete;
+    RtScope(RtScope&&) = delete;
+    RtScope& operator=(RtScope&&) = delete;
+};
+
+/**
+ * RAII guard suspending checks inside an RtScope (e.g. for deliberate,
+ * reviewed exceptions or test assertions).
+ */
+class RtAllowScope {
+  public:
+#if defined(DRUMCORE_RT_CHECKS)
+    RtAllowScope() noexcept { ++RtSafety::detail::reporting; }
+    ~RtAllowScope() noexcept { --RtSafety::detail::reporting; }
+#else
+    RtAllowScope() noexcept {}
+#endif
+
+    RtAllowScope(const RtAllowScope&) = delete;
+    RtAllowScope& operator=(const RtAllowScope&) = delete;
+    RtAllowScope(RtAllowScope&&) = delete;
+    RtAllowScope& operator=(RtAllowScope&&) = delete;
+};
+
+}  // namespace JKDigital
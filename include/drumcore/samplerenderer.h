@@ -0,0 +1,632 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Offline one-shot sample renderer for pattern previews and bounces.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/arena.h>
+#include <drumcore/config.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/kitmap.h>
+#include <drumcore/threadpool.h>
+#include <drumcore/timesignature.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// Sample - decoded one-shot
+//------------------------------------------------------------------------
+/** Decoded audio: one or two de-interleaved float channels. */
+struct Sample {
+    std::vector<float> channels[2];
+    int numChannels = 0;
+    double sampleRate = 0.0;
+
+    /** Length in frames. */
+    size_t frames() const { return numChannels > 0 ? channels[0].size() : 0; }
+
+    bool empty() const { return frames() == 0; }
+
+    /** Channel data (mono samples return the single channel for both). */
+    const float* channel(int c) const { return channels[c > 0 && numChannels > 1 ? 1 : 0].data(); }
+};
+
+//------------------------------------------------------------------------
+// Wav - RIFF/WAVE reading and writing
+//------------------------------------------------------------------------
+/**
+ * Minimal WAV codec for one-shots and rendered previews.
+ *
+ * Reads PCM 8/16/24/32-bit and IEEE float 32/64-bit, plain or
+ * WAVE_FORMAT_EXTENSIBLE; channels beyond the first two are dropped.
+ * Writes 16-bit PCM or 32-bit float.
+ */
+namespace Wav {
+
+enum class Format : uint8_t { Pcm16 = 0, Float32 = 1 };
+
+namespace detail {
+
+inline uint32_t u16(const uint8_t* p) { return static_cast<uint32_t>(p[0] | p[1] << 8); }
+
+inline uint32_t u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline void put16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+inline void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, v & 0xFFFFu);
+    put16(out, v >> 16);
+}
+
+inline float decodeFrame(const uint8_t* p, int bits, bool isFloat) {
+    if (isFloat) {
+        if (bits == 64) {
+            uint64_t raw = u32(p) | static_cast<uint64_t>(u32(p + 4)) << 32;
+            double d;
+            std::memcpy(&d, &raw, sizeof(d));
+            return static_cast<float>(d);
+        }
+        const uint32_t raw = u32(p);
+        float f;
+        std::memcpy(&f, &raw, sizeof(f));
+        return f;
+    }
+    switch (bits) {
+    case 8:
+        return (static_cast<float>(p[0]) - 128.0f) / 128.0f;
+    case 16:
+        return static_cast<float>(static_cast<int16_t>(u16(p))) / 32768.0f;
+    case 24: {
+        const uint32_t raw = u16(p) << 8 | static_cast<uint32_t>(p[2]) << 24;
+        const int32_t v = static_cast<int32_t>(raw) >> 8;
+        return static_cast<float>(v) / 8388608.0f;
+    }
+    default:
+        return static_cast<float>(static_cast<int32_t>(u32(p))) / 2147483648.0f;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Decode a WAV file image.
+ *
+ * @param data File contents
+ * @param size Size in bytes
+ * @param out Receives the sample (unchanged on failure)
+ * @return false if the data is not a supported WAV file
+ */
+inline bool parse(const void* data, size_t size, Sample& out) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+    uint32_t format = 0, channels = 0, rate = 0, blockAlign = 0, bits = 0;
+    const uint8_t* pcm = nullptr;
+    size_t pcmBytes = 0;
+    for (size_t pos = 12; pos + 8 <= size;) {
+        const uint8_t* chunk = bytes + pos;
+        const size_t chunkSize = detail::u32(chunk + 4);
+        const size_t available = std::min(chunkSize, size - pos - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            format = detail::u16(chunk + 8);
+            channels = detail::u16(chunk + 10);
+            rate = detail::u32(chunk + 12);
+            blockAlign = detail::u16(chunk + 20);
+            bits = detail::u16(chunk + 22);
+            if (format == 0xFFFEu && available >= 26) format = detail::u16(chunk + 32);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            pcm = chunk + 8;
+            pcmBytes = available;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+    const bool isFloat = format == 3;
+    const bool supported = (format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+                           (isFloat && (bits == 32 || bits == 64));
+    if (!supported || pcm == nullptr || channels == 0 || rate == 0 ||
+        blockAlign < channels * (bits / 8)) {
+        return false;
+    }
+
+    const size_t frames = pcmBytes / blockAlign;
+    const int kept = channels > 1 ? 2 : 1;
+    Sample sample;
+    sample.numChannels = kept;
+    sample.sampleRate = rate;
+    for (int c = 0; c < kept; ++c) {
+        sample.channels[c].resize(frames);
+        for (size_t f = 0; f < frames; ++f) {
+            const uint8_t* p = pcm + f * blockAlign + static_cast<size_t>(c) * (bits / 8);
+            sample.channels[c][f] = detail::decodeFrame(p, static_cast<int>(bits), isFloat);
+        }
+    }
+    out = std::move(sample);
+    return true;
+}
+
+/**
+ * Load a WAV file from disk.
+ *
+ * @return false if the file cannot be read or is not a supported WAV file
+ */
+inline bool load(const char* path, Sample& out) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[64 * 1024];
+    for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+    return parse(bytes.data(), bytes.size(), out);
+}
+
+/**
+ * Encode planar float audio as a WAV file image.
+ *
+ * @param channels numChannels pointers to frames floats (PCM16 clips to -1..1)
+ * @param out Receives the file contents
+ */
+inline void encode(const float* const* channels, int numChannels, size_t frames,
+                   uint32_t sampleRate, Format format, std::vector<uint8_t>& out) {
+    const uint32_t bytesPerSample = format == Format::Pcm16 ? 2 : 4;
+    const uint32_t blockAlign = bytesPerSample * static_cast<uint32_t>(numChannels);
+    const uint32_t dataBytes = static_cast<uint32_t>(frames) * blockAlign;
+    out.clear();
+    out.reserve(44 + dataBytes);
+    out.insert(out.end(), {'R', 'I', 'F', 'F'});
+    detail::put32(out, 36 + dataBytes);
+    out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    detail::put32(out, 16);
+    detail::put16(out, format == Format::Pcm16 ? 1 : 3);
+    detail::put16(out, static_cast<uint32_t>(numChannels));
+    detail::put32(out, sampleRate);
+    detail::put32(out, sampleRate * blockAlign);
+    detail::put16(out, blockAlign);
+    detail::put16(out, bytesPerSample * 8);
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    detail::put32(out, dataBytes);
+    for (size_t f = 0; f < frames; ++f) {
+        for (int c = 0; c < numChannels; ++c) {
+            const float x = channels[c][f];
+            if (format == Format::Pcm16) {
+                const float clipped = x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+                const long v = std::lround(clipped * 32767.0f);
+                detail::put16(out, static_cast<uint32_t>(v) & 0xFFFFu);
+            } else {
+                uint32_t raw;
+                std::memcpy(&raw, &x, sizeof(raw));
+                detail::put32(out, raw);
+            }
+        }
+    }
+}
+
+/**
+ * Write planar float audio to a WAV file.
+ *
+ * @return false if the file cannot be written
+ */
+inline bool save(const char* path, const float* const* channels, int numChannels, size_t frames,
+                 uint32_t sampleRate, Format format = Format::Pcm16) {
+    std::vector<uint8_t> bytes;
+    encode(channels, numChannels, frames, sampleRate, format, bytes);
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace Wav
+
+//------------------------------------------------------------------------
+// GainCurve - velocity to linear gain
+//------------------------------------------------------------------------
+/**
+ * 256-level velocity-to-gain lookup with ghost/accent scaling folded in,
+ * quantized and selected exactly like VelocityCurve, so a preview plays
+ * each hit at the level the MIDI path would send.
+ */
+class GainCurve {
+  public:
+    static constexpr int LUT_SIZE = VelocityCurve::LUT_SIZE;
+
+    /** Constructor - linear curve. */
+    GainCurve() { build([](float x) { return x; }); }
+
+    /** Gain proportional to velocity. */
+    static GainCurve linear() { return GainCurve(); }
+
+    /** gain = velocity^gamma. */
+    static GainCurve power(float gamma) {
+        GainCurve curve;
+        if (gamma <= 0.0f) gamma = 1.0f;
+        curve.build([gamma](float x) { return std::pow(x, gamma); });
+        return curve;
+    }
+
+    /**
+     * Velocity spans a fixed range in decibels: 1.0 is 0 dB, values near 0
+     * approach -rangeDb.
+     */
+    static GainCurve decibels(float rangeDb) {
+        GainCurve curve;
+        curve.build([rangeDb](float x) { return std::pow(10.0f, (x - 1.0f) * rangeDb / 20.0f); });
+        return curve;
+    }
+
+    /** Custom curve: fn maps 0..1 to a gain (evaluated 768 times, not per hit). */
+    template <typename Fn>
+    static GainCurve custom(Fn fn) {
+        GainCurve curve;
+        curve.build(fn);
+        return curve;
+    }
+
+    /** Gain of a hit (0 when silent). */
+    float gain(float velocity, uint8_t flags = 0) const {
+        return lut_[VelocityCurve::tableForFlags(flags)][VelocityCurve::indexOf(velocity)];
+    }
+
+  private:
+    template <typename Fn>
+    void build(Fn fn) {
+        constexpr float kScale[VelocityCurve::NUM_TABLES] = {
+            1.0f, Constants::kGhostVelocityMultiplier, Constants::kAccentVelocityMultiplier};
+        for (int t = 0; t < VelocityCurve::NUM_TABLES; ++t) {
+            lut_[t][0] = 0.0f;
+            for (int i = 1; i < LUT_SIZE; ++i) {
+                const float x = static_cast<float>(i) / static_cast<float>(LUT_SIZE - 1);
+                const float v = std::min(1.0f, x * kScale[t]);
+                lut_[t][i] = std::max(0.0f, static_cast<float>(fn(v)));
+            }
+        }
+    }
+
+    float lut_[VelocityCurve::NUM_TABLES][LUT_SIZE];
+};
+
+//------------------------------------------------------------------------
+// SampleKit - one-shot per instrument
+//------------------------------------------------------------------------
+/**
+ * One one-shot per grid instrument, resampled to the render rate, plus
+ * per-instrument level, choke masks and the velocity-to-gain curve.
+ *
+ * Default choke: closed hi-hat (2) cuts open hi-hat (3).
+ *
+ * Read-only during rendering, so one kit can serve every worker thread.
+ */
+class SampleKit {
+  public:
+    static constexpr int NUM_INSTRUMENTS = DrumBar::NUM_INSTRUMENTS;
+
+    /** Constructor - empty kit rendering at a sample rate. */
+    explicit SampleKit(double sampleRate = 48000.0) : sampleRate_(sampleRate) {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            level_[i] = 1.0f;
+            chokes_[i] = 0;
+        }
+        chokes_[2] = 1u << 3;
+    }
+
+    double sampleRate() const { return sampleRate_; }
+
+    /**
+     * Assign a sample to an instrument (linearly resampled if its rate
+     * differs from the kit's).
+     *
+     * @return false if the instrument is out of range or the sample is empty
+     */
+    bool setSample(int instrument, const Sample& sample) {
+        if (instrument < 0 || instrument >= NUM_INSTRUMENTS || sample.empty()) return false;
+        Sample& dst = samples_[instrument];
+        dst.numChannels = sample.numChannels;
+        dst.sampleRate = sampleRate_;
+        const double rate = sample.sampleRate > 0.0 ? sample.sampleRate : sampleRate_;
+        const double step = rate / sampleRate_;
+        const size_t inFrames = sample.frames();
+        const size_t outFrames =
+            static_cast<size_t>(std::ceil(static_cast<double>(inFrames) / step));
+        for (int c = 0; c < sample.numChannels; ++c) {
+            const std::vector<float>& in = sample.channels[c];
+            std::vector<float>& out = dst.channels[c];
+            if (rate == sampleRate_) {
+                out = in;
+                continue;
+            }
+            out.resize(outFrames);
+            for (size_t f = 0; f < outFrames; ++f) {
+                const double pos = static_cast<double>(f) * step;
+                const size_t k = static_cast<size_t>(pos);
+                const float frac = static_cast<float>(pos - static_cast<double>(k));
+                const float a = in[std::min(k, inFrames - 1)];
+                const float b = k + 1 < inFrames ? in[k + 1] : 0.0f;
+                out[f] = a + (b - a) * frac;
+            }
+        }
+        for (int c = sample.numChannels; c < 2; ++c) dst.channels[c].clear();
+        return true;
+    }
+
+    /**
+     * Load a WAV file for an instrument.
+     *
+     * @return false if the file cannot be loaded (the previous sample is kept)
+     */
+    bool loadSample(int instrument, const char* path) {
+        Sample sample;
+        return Wav::load(path, sample) && setSample(instrument, sample);
+    }
+
+    void clearSample(int instrument) {
+        if (instrument >= 0 && instrument < NUM_INSTRUMENTS) samples_[instrument] = Sample();
+    }
+
+    bool hasSample(int instrument) const {
+        return instrument >= 0 && instrument < NUM_INSTRUMENTS && !samples_[instrument].empty();
+    }
+
+    /** Sample of an instrument (instrument must be in 0..9). */
+    const Sample& sample(int instrument) const { return samples_[instrument]; }
+
+    /** Linear level applied on top of the gain curve. */
+    void setLevel(int instrument, float gain) {
+        if (instrument >= 0 && instrument < NUM_INSTRUMENTS) level_[instrument] = gain;
+    }
+
+    float level(int instrument) const { return level_[instrument]; }
+
+    /**
+     * Instruments cut off when this instrument plays.
+     *
+     * @param mask Bit n set to choke instrument n
+     */
+    void setChokes(int instrument, uint16_t mask) {
+        if (instrument >= 0 && instrument < NUM_INSTRUMENTS) chokes_[instrument] = mask;
+    }
+
+    uint16_t chokes(int instrument) const { return chokes_[instrument]; }
+
+    /** Mutual choke group: every member cuts every other member. */
+    void setChokeGroup(uint16_t members) {
+        for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+            if ((members >> i & 1u) != 0) {
+                chokes_[i] = static_cast<uint16_t>(chokes_[i] | (members & ~(1u << i)));
+            }
+        }
+    }
+
+    void setGainCurve(const GainCurve& curve) { curve_ = curve; }
+    const GainCurve& gainCurve() const { return curve_; }
+
+    /** Longest sample in frames (the render tail). */
+    size_t longestSample() const {
+        size_t longest = 0;
+        for (const Sample& s : samples_) longest = std::max(longest, s.frames());
+        return longest;
+    }
+
+  private:
+    Sample samples_[NUM_INSTRUMENTS];
+    float level_[NUM_INSTRUMENTS];
+    uint16_t chokes_[NUM_INSTRUMENTS];
+    GainCurve curve_;
+    double sampleRate_;
+};
+
+/** Tempo, meter and tail handling for SampleRenderer. */
+struct RenderSettings {
+    /** Quarter-note tempo. */
+    double tempoBpm = Constants::kDefaultTempo;
+
+    TimeSignature timeSig = TimeSignature::k4_4;
+
+    /** Extend the output by the longest sample so the last hits ring out. */
+    bool includeTail = true;
+
+    /** Fade applied to a choked voice. */
+    float chokeFadeMs = 2.0f;
+};
+
+//------------------------------------------------------------------------
+// SampleRenderer - offline bar/pattern to PCM
+//------------------------------------------------------------------------
+/**
+ * Offline one-shot sampler: renders bars to planar float buffers.
+ *
+ * Each hit on an active step starts its instrument's sample at
+ * step PPQ position + timingOffsetMs, rounded to the nearest frame, at
+ * the kit's gain-curve gain times the instrument level. Hits are
+ * processed in time order; a hit cuts the still-sounding voices of the
+ * instruments in its choke mask with a short fade. Voices are summed with
+ * SSE2 where available; the output is not clipped.
+ *
+ * Scratch event lists come from threadScratch(), so steady-state renders
+ * do not allocate. renderBatch() spreads previews over a ThreadPool.
+ */
+namespace SampleRenderer {
+
+namespace detail {
+
+struct Voice {
+    int64_t start;
+    int64_t end;
+    int64_t fadeStart;
+    uint32_t order;
+    uint8_t instrument;
+    float gain;
+};
+
+// dst[k] += src[k] * gain
+inline void mixAdd(float* dst, const float* src, size_t n, float gain) {
+    size_t k = 0;
+#if defined(DRUMCORE_HAS_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; k + 4 <= n; k += 4) {
+        const __m128 x = _mm_mul_ps(_mm_loadu_ps(src + k), g);
+        _mm_storeu_ps(dst + k, _mm_add_ps(_mm_loadu_ps(dst + k), x));
+    }
+#endif
+    for (; k < n; ++k) dst[k] += src[k] * gain;
+}
+
+inline double framesPerQuarter(const SampleKit& kit, const RenderSettings& settings) {
+    const double tempo = settings.tempoBpm > 0.0 ? settings.tempoBpm : Constants::kDefaultTempo;
+    return 60.0 / tempo * kit.sampleRate();
+}
+
+// Mix one voice into [0, frames) of a channel
+inline void mixVoice(const Voice& v, const float* src, size_t srcFrames, float* dst, size_t frames,
+                     float gain, int64_t fadeFrames) {
+    const int64_t end = std::min<int64_t>(
+        {v.end, v.start + static_cast<int64_t>(srcFrames), static_cast<int64_t>(frames)});
+    const int64_t from = std::max<int64_t>(v.start, 0);
+    const int64_t fade = std::min(v.fadeStart, end);
+    if (fade > from) {
+        mixAdd(dst + from, src + (from - v.start), static_cast<size_t>(fade - from), gain);
+    }
+    for (int64_t t = std::max(fade, from); t < end; ++t) {
+        const float ramp = 1.0f - static_cast<float>(t - v.fadeStart + 1) /
+                                      static_cast<float>(fadeFrames + 1);
+        dst[t] += src[t - v.start] * gain * ramp;
+    }
+}
+
+}  // namespace detail
+
+/** Length of one bar in frames. */
+inline size_t barFrames(const SampleKit& kit, const RenderSettings& settings) {
+    const double beats = TimeSignatureUtils::getDescriptor(settings.timeSig).beatsPerBar;
+    return static_cast<size_t>(std::llround(beats * detail::framesPerQuarter(kit, settings)));
+}
+
+/** Frames render() produces for a number of bars (bars plus tail). */
+inline size_t renderFrames(const SampleKit& kit, size_t numBars, const RenderSettings& settings) {
+    const double beats = TimeSignatureUtils::getDescriptor(settings.timeSig).beatsPerBar;
+    const double length = static_cast<double>(numBars) * beats *
+                          detail::framesPerQuarter(kit, settings);
+    return static_cast<size_t>(std::llround(length)) +
+           (settings.includeTail ? kit.longestSample() : 0);
+}
+
+/**
+ * Render consecutive bars.
+ *
+ * @param left Left (or mono) output, frames floats; overwritten
+ * @param right Right output, or nullptr for a mono mix
+ * @param frames Output length (see renderFrames); later audio is dropped
+ * @return Number of hits rendered
+ */
+inline size_t render(const SampleKit& kit, const DrumBar* bars, size_t numBars,
+                     const RenderSettings& settings, float* left, float* right, size_t frames) {
+    std::fill(left, left + frames, 0.0f);
+    if (right != nullptr) std::fill(right, right + frames, 0.0f);
+
+    const TimeSignatureDescriptor& desc = TimeSignatureUtils::getDescriptor(settings.timeSig);
+    const double perQuarter = detail::framesPerQuarter(kit, settings);
+    const double perMs = kit.sampleRate() / 1000.0;
+    const double barLength = desc.beatsPerBar * perQuarter;
+
+    ScratchArena& arena = threadScratch();
+    ScratchArena::Scope scope(arena);
+    std::pmr::vector<detail::Voice> voices(&arena);
+    voices.reserve(64 * numBars);
+    for (size_t b = 0; b < numBars; ++b) {
+        const double barStart = static_cast<double>(b) * barLength;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            if (!kit.hasSample(i)) continue;
+            const int64_t length = static_cast<int64_t>(kit.sample(i).frames());
+            for (uint32_t m = bars[b].noteMask(i) & desc.activeMask; m != 0; m &= m - 1) {
+                const int s = BitUtils::countTrailingZeros32(m);
+                const DrumStep& step = bars[b].steps[i][s];
+                const float gain = kit.gainCurve().gain(step.velocity, step.flags) * kit.level(i);
+                if (!(gain > 0.0f)) continue;
+                const double at = barStart + desc.ppq[s] * perQuarter + step.timingOffsetMs * perMs;
+                const int64_t start = std::llround(at);
+                const uint32_t order = static_cast<uint32_t>(voices.size());
+                voices.push_back({start, start + length, start + length, order,
+                                  static_cast<uint8_t>(i), gain});
+            }
+        }
+    }
+    std::sort(voices.begin(), voices.end(), [](const detail::Voice& a, const detail::Voice& b) {
+        return a.start < b.start || (a.start == b.start && a.order < b.order);
+    });
+
+    // Chokes: only voices started within the longest sample can still sound
+    const int64_t fadeFrames = std::max<int64_t>(0, std::llround(settings.chokeFadeMs * perMs));
+    const int64_t longest = static_cast<int64_t>(kit.longestSample());
+    for (size_t k = 0; k < voices.size(); ++k) {
+        const uint16_t mask = kit.chokes(voices[k].instrument);
+        if (mask == 0) continue;
+        const int64_t t = voices[k].start;
+        for (size_t j = k; j-- > 0 && voices[j].start + longest > t;) {
+            detail::Voice& v = voices[j];
+            if ((mask >> v.instrument & 1u) == 0 || v.fadeStart <= t) continue;
+            v.fadeStart = t;
+            v.end = std::min(v.end, t + fadeFrames);
+        }
+    }
+
+    for (const detail::Voice& v : voices) {
+        const Sample& sample = kit.sample(v.instrument);
+        const size_t n = sample.frames();
+        if (right != nullptr) {
+            detail::mixVoice(v, sample.channel(0), n, left, frames, v.gain, fadeFrames);
+            detail::mixVoice(v, sample.channel(1), n, right, frames, v.gain, fadeFrames);
+        } else if (sample.numChannels > 1) {
+            detail::mixVoice(v, sample.channel(0), n, left, frames, 0.5f * v.gain, fadeFrames);
+            detail::mixVoice(v, sample.channel(1), n, left, frames, 0.5f * v.gain, fadeFrames);
+        } else {
+            detail::mixVoice(v, sample.channel(0), n, left, frames, v.gain, fadeFrames);
+        }
+    }
+    return voices.size();
+}
+
+/**
+ * Render one preview per bar in parallel.
+ *
+ * Preview p, channel c starts at out + (p * numChannels + c) * framesPerPreview.
+ *
+ * @param numChannels 1 (mono mix) or 2
+ * @param framesPerPreview Length of each preview, e.g. renderFrames(kit, 1, settings)
+ */
+inline void renderBatch(ThreadPool& pool, const SampleKit& kit, const DrumBar* bars, size_t count,
+                        const RenderSettings& settings, float* out, int numChannels,
+                        size_t framesPerPreview) {
+    const size_t stride = static_cast<size_t>(numChannels) * framesPerPreview;
+    Parallel::forEach(pool, 0, count, 4, [&](size_t p) {
+        float* left = out + p * stride;
+        float* right = numChannels > 1 ? left + framesPerPreview : nullptr;
+        render(kit, bars + p, 1, settings, left, right, framesPerPreview);
+    });
+}
+
+}  // namespace SampleRenderer
+
+}  // namespace JKDigital
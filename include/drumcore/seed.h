@@ -82,5 +82,110 @@ inline float randomFloat(uint64_t& state) {
     return static_cast<float>(nextRandom(state) >> 40) / static_cast<float>(1ULL << 24);
 }
 
+//------------------------------------------------------------------------
+// Counter-based (random-access) generation
+//------------------------------------------------------------------------
+
+/**
+ * Pack an (instrument, step, draw) coordinate into a 64-bit counter.
+ *
+ * The draw index distinguishes multiple values consumed by the same
+ * transform at the same grid cell (e.g. velocity and timing jitter).
+ *
+ * @param instrument Instrument index in the grid (0-9)
+ * @param step Step index in the bar (0-31)
+ * @param draw Draw index at this cell
+ * @return Counter value unique to this coordinate
+ */
+constexpr uint64_t stepCounter(uint32_t instrument, uint32_t step, uint32_t draw = 0) {
+    return (static_cast<uint64_t>(draw) << 32) | (static_cast<uint64_t>(instrument) << 16) |
+           static_cast<uint64_t>(step & 0xFFFFu);
+}
+
+/**
+ * Random value at a given counter position of a bar seed.
+ *
+ * Equivalent to the (counter + 1)-th output of a SplitMix64 stream started
+ * at barSeed, but reachable in O(1) without running the earlier outputs.
+ * Stateless, so any thread or SIMD lane can evaluate any position.
+ *
+ * @param barSeed Seed from deriveSeed() for the current transform and bar
+ * @param counter Counter position (see stepCounter())
+ * @return Random value
+ */
+constexpr uint64_t randomAt(uint64_t barSeed, uint64_t counter) {
+    uint64_t x = barSeed + counter * 0x9E3779B97F4A7C15ULL;
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Random value for one grid cell of a bar, keyed on the full coordinate.
+ *
+ * Same result as randomAt(deriveSeed(masterSeed, transformIndex, barIndex),
+ * stepCounter(instrument, step, draw)).
+ *
+ * @param masterSeed The global master seed
+ * @param transformIndex Index of the transform in the chain
+ * @param barIndex Index of the current bar
+ * @param instrument Instrument index in the grid (0-9)
+ * @param step Step index in the bar (0-31)
+ * @param draw Draw index at this cell
+ * @return Random value
+ */
+inline uint64_t counterRandom(uint64_t masterSeed, uint32_t transformIndex, uint32_t barIndex,
+                              uint32_t instrument, uint32_t step, uint32_t draw = 0) {
+    return randomAt(deriveSeed(masterSeed, transformIndex, barIndex),
+                    stepCounter(instrument, step, draw));
+}
+
+/**
+ * Convert a random value to a float in [0.0, 1.0).
+ *
+ * Uses the same top-24-bit mapping as randomFloat().
+ *
+ * @param value Random value
+ * @return Float in [0.0, 1.0)
+ */
+constexpr float toUnitFloat(uint64_t value) {
+    return static_cast<float>(value >> 40) / static_cast<float>(1ULL << 24);
+}
+
+/**
+ * Random float in [0.0, 1.0) for one grid cell of a bar.
+ *
+ * @param barSeed Seed from deriveSeed() for the current transform and bar
+ * @param instrument Instrument index in the grid (0-9)
+ * @param step Step index in the bar (0-31)
+ * @param draw Draw index at this cell
+ * @return Random float in [0.0, 1.0)
+ */
+constexpr float floatAt(uint64_t barSeed, uint32_t instrument, uint32_t step, uint32_t draw = 0) {
+    return toUnitFloat(randomAt(barSeed, stepCounter(instrument, step, draw)));
+}
+
+/**
+ * Fill a run of consecutive steps for one instrument with random floats.
+ *
+ * out[i] == floatAt(barSeed, instrument, firstStep + i, draw). The loop has
+ * no carried state, so the compiler is free to vectorize it.
+ *
+ * @param barSeed Seed from deriveSeed() for the current transform and bar
+ * @param instrument Instrument index in the grid (0-9)
+ * @param draw Draw index at each cell
+ * @param out Destination array
+ * @param count Number of steps to fill
+ * @param firstStep Step index of out[0]
+ */
+inline void fillFloats(uint64_t barSeed, uint32_t instrument, uint32_t draw, float* out, int count,
+                       uint32_t firstStep = 0) {
+    const uint64_t base = stepCounter(instrument, firstStep, draw);
+    for (int i = 0; i < count; ++i) {
+        out[i] = toUnitFloat(randomAt(barSeed, base + static_cast<uint64_t>(i)));
+    }
+}
+
 }  // namespace Seed
 }  // namespace JKDigital
@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Fused decode of model output tensors into DrumBars.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/bitutils.h>
+#include <drumcore/config.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/tensorpack.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+/** Settings for TensorDecode. */
+struct DecodeParams {
+    /** A cell is a hit candidate when its probability is at least this. */
+    float hitThreshold = 0.5f;
+
+    /** Most hits kept per instrument (top-k by probability). */
+    int32_t maxHits[DrumBar::NUM_INSTRUMENTS] = {32, 32, 32, 32, 32, 32, 32, 32, 32, 32};
+
+    /** Hits below this velocity are flagged as ghost notes. */
+    float ghostBelow = 0.35f;
+
+    /** Hits at or above this velocity are flagged as accents. */
+    float accentAbove = 0.85f;
+
+    /** Final gate: hits whose velocity is below this are dropped (see DrumBar::gateVelocity). */
+    float gateThreshold = 0.05f;
+
+    /** Steps that may hold hits (see TimeSignatureDescriptor::activeMask). */
+    uint32_t activeMask = 0xFFFFFFFFu;
+
+    /** Same hit limit on every instrument. */
+    void setMaxHits(int32_t k) {
+        for (int32_t& m : maxHits) m = k;
+    }
+};
+
+/**
+ * Model output -> DrumBar decoding, the inverse of TensorPack.
+ *
+ * The input has the shape of a packed bar with the flags channel replaced
+ * by a hit probability:
+ *   channel 0  velocity (clamped to 0..1)
+ *   channel 1  timing offset in -1..1 (scaled by 20 ms and clamped)
+ *   channel 2  hit probability
+ *
+ * Per instrument row, fused into one kernel:
+ *   1. threshold the probabilities (active steps only),
+ *   2. keep the maxHits most probable hits (ties go to the earlier step),
+ *   3. flag ghosts and accents from the velocity bands,
+ *   4. denormalize and clamp the offsets,
+ *   5. gate: drop hits whose velocity is below gateThreshold.
+ *
+ * Every step of the output is written (non-hits are cleared); genre, role
+ * and bar index are left as they are. With SSE2 a row is processed four
+ * steps at a time: one sweep builds the hit and gate masks (movemask),
+ * a second sweep over the same, L1-resident row writes the steps
+ * (interleaved back with shuffles). Top-k falls back to a partial sort
+ * only when a row exceeds its limit. The scalar path produces the same
+ * bars.
+ */
+namespace TensorDecode {
+
+constexpr int kVelocityChannel = TensorPack::kVelocityChannel;
+constexpr int kOffsetChannel = TensorPack::kOffsetChannel;
+constexpr int kHitChannel = 2;
+
+namespace detail {
+
+constexpr int kRows = TensorPack::kRows;
+constexpr int kSteps = TensorPack::kSteps;
+constexpr int kPlane = kRows * kSteps;
+
+// Index of a channel value in one bar's tensor
+inline size_t at(TensorLayout layout, int channel, int cell) {
+    return layout == TensorLayout::NHWC ? static_cast<size_t>(cell) * 3 + channel
+                                        : static_cast<size_t>(channel) * kPlane + cell;
+}
+
+inline float clampVelocity(float v) { return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f; }
+
+inline float denormalizeOffset(float o) {
+    const float ms = o * Constants::kMaxTimingOffsetMs;
+    return ms > Constants::kMinTimingOffsetMs
+               ? (ms < Constants::kMaxTimingOffsetMs ? ms : Constants::kMaxTimingOffsetMs)
+               : Constants::kMinTimingOffsetMs;
+}
+
+// Keep the k most probable hits of a row (ties: lower step first)
+inline uint32_t topK(const float* tensor, TensorLayout layout, int row, uint32_t hits, int k) {
+    if (k <= 0) return 0;
+    if (BitUtils::popcount32(hits) <= k) return hits;
+    struct Candidate {
+        float p;
+        int step;
+    };
+    Candidate c[kSteps];
+    int n = 0;
+    for (uint32_t m = hits; m != 0; m &= m - 1) {
+        const int s = BitUtils::countTrailingZeros32(m);
+        c[n++] = {tensor[at(layout, kHitChannel, row * kSteps + s)], s};
+    }
+    std::nth_element(c, c + (k - 1), c + n, [](const Candidate& a, const Candidate& b) {
+        return a.p > b.p || (a.p == b.p && a.step < b.step);
+    });
+    uint32_t kept = 0;
+    for (int j = 0; j < k; ++j) kept |= 1u << c[j].step;
+    return kept;
+}
+
+inline int decodeBarScalar(const float* tensor, DrumBar& out, const DecodeParams& params,
+                           TensorLayout layout) {
+    int total = 0;
+    for (int i = 0; i < kRows; ++i) {
+        uint32_t hits = 0;
+        for (int s = 0; s < kSteps; ++s) {
+            const bool hit = tensor[at(layout, kHitChannel, i * kSteps + s)] >= params.hitThreshold;
+            hits |= static_cast<uint32_t>(hit) << s;
+        }
+        hits = topK(tensor, layout, i, hits & params.activeMask, params.maxHits[i]);
+        for (int s = 0; s < kSteps; ++s) {
+            const int cell = i * kSteps + s;
+            const float v = clampVelocity(tensor[at(layout, kVelocityChannel, cell)]);
+            DrumStep& step = out.steps[i][s];
+            if ((hits >> s & 1u) == 0 || !(v >= params.gateThreshold) || !(v > 0.0f)) {
+                step = DrumStep();
+                continue;
+            }
+            step.velocity = v;
+            step.timingOffsetMs = denormalizeOffset(tensor[at(layout, kOffsetChannel, cell)]);
+            const int ghost = v < params.ghostBelow ? DrumStep::FLAG_GHOST : 0;
+            const int accent = v >= params.accentAbove ? DrumStep::FLAG_ACCENT : 0;
+            step.flags = static_cast<uint8_t>(ghost | accent);
+            ++total;
+        }
+    }
+    return total;
+}
+
+#if defined(DRUMCORE_HAS_SSE2)
+
+static_assert(sizeof(DrumStep) == 3 * sizeof(float), "DrumStep must be three 32-bit fields");
+
+// Velocity, offset and probability of four consecutive cells
+inline void load4(const float* tensor, TensorLayout layout, int cell, __m128& v, __m128& o,
+                  __m128& p) {
+    if (layout == TensorLayout::NCHW) {
+        v = _mm_loadu_ps(tensor + kVelocityChannel * kPlane + cell);
+        o = _mm_loadu_ps(tensor + kOffsetChannel * kPlane + cell);
+        p = _mm_loadu_ps(tensor + kHitChannel * kPlane + cell);
+        return;
+    }
+    const __m128 a = _mm_loadu_ps(tensor + cell * 3);
+    const __m128 b = _mm_loadu_ps(tensor + cell * 3 + 4);
+    const __m128 c = _mm_loadu_ps(tensor + cell * 3 + 8);
+    const __m128 bc21 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    v = _mm_shuffle_ps(a, bc21, _MM_SHUFFLE(2, 0, 3, 0));
+    const __m128 ab10 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 bc32 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    o = _mm_shuffle_ps(ab10, bc32, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 ab21 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    p = _mm_shuffle_ps(ab21, c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+inline int decodeBarSse2(const float* tensor, DrumBar& out, const DecodeParams& params,
+                         TensorLayout layout) {
+    const __m128 threshold = _mm_set1_ps(params.hitThreshold);
+    const __m128 gate = _mm_set1_ps(params.gateThreshold);
+    const __m128 ghostBelow = _mm_set1_ps(params.ghostBelow);
+    const __m128 accentAbove = _mm_set1_ps(params.accentAbove);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 offsetScale = _mm_set1_ps(Constants::kMaxTimingOffsetMs);
+    const __m128 offsetMin = _mm_set1_ps(Constants::kMinTimingOffsetMs);
+    const __m128 offsetMax = _mm_set1_ps(Constants::kMaxTimingOffsetMs);
+    const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+    const __m128i ghostFlag = _mm_set1_epi32(DrumStep::FLAG_GHOST);
+    const __m128i accentFlag = _mm_set1_epi32(DrumStep::FLAG_ACCENT);
+
+    int total = 0;
+    for (int i = 0; i < kRows; ++i) {
+        const int row = i * kSteps;
+        // Pass 1: threshold and gate masks for the row
+        uint32_t hits = 0;
+        uint32_t loud = 0;
+        for (int s = 0; s < kSteps; s += 4) {
+            __m128 v, o, p;
+            load4(tensor, layout, row + s, v, o, p);
+            v = _mm_min_ps(_mm_max_ps(v, zero), one);
+            const __m128 kept = _mm_and_ps(_mm_cmpge_ps(v, gate), _mm_cmpgt_ps(v, zero));
+            hits |= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(p, threshold))) << s;
+            loud |= static_cast<uint32_t>(_mm_movemask_ps(kept)) << s;
+        }
+        hits = topK(tensor, layout, i, hits & params.activeMask, params.maxHits[i]) & loud;
+        total += BitUtils::popcount32(hits);
+
+        // Pass 2: write the steps, four at a time
+        float* dst = reinterpret_cast<float*>(&out.steps[i][0]);
+        for (int s = 0; s < kSteps; s += 4) {
+            __m128 v, o, p;
+            load4(tensor, layout, row + s, v, o, p);
+            const __m128i bits = _mm_set1_epi32(static_cast<int>(hits >> s & 0xFu));
+            const __m128 on =
+                _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(bits, laneBits), laneBits));
+            v = _mm_and_ps(_mm_min_ps(_mm_max_ps(v, zero), one), on);
+            o = _mm_min_ps(_mm_max_ps(_mm_mul_ps(o, offsetScale), offsetMin), offsetMax);
+            o = _mm_and_ps(o, on);
+            const __m128i ghost = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(v, ghostBelow)),
+                                                ghostFlag);
+            const __m128i accent = _mm_and_si128(_mm_castps_si128(_mm_cmpge_ps(v, accentAbove)),
+                                                 accentFlag);
+            const __m128 f = _mm_and_ps(_mm_castsi128_ps(_mm_or_si128(ghost, accent)), on);
+            // Interleave to v0 o0 f0 v1 | o1 f1 v2 o2 | f2 v3 o3 f3
+            const __m128 vo = _mm_unpacklo_ps(v, o);
+            const __m128 fv10 = _mm_shuffle_ps(f, v, _MM_SHUFFLE(1, 1, 0, 0));
+            const __m128 of11 = _mm_shuffle_ps(o, f, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 vo22 = _mm_shuffle_ps(v, o, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 fv23 = _mm_shuffle_ps(f, v, _MM_SHUFFLE(3, 3, 2, 2));
+            const __m128 of33 = _mm_shuffle_ps(o, f, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_ps(dst + s * 3, _mm_shuffle_ps(vo, fv10, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(dst + s * 3 + 4, _mm_shuffle_ps(of11, vo22, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(dst + s * 3 + 8, _mm_shuffle_ps(fv23, of33, _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+    }
+    return total;
+}
+
+#endif
+
+}  // namespace detail
+
+/**
+ * Decode one bar.
+ *
+ * @param tensor TensorPack::kFloatsPerBar floats in the given layout
+ * @param out Destination bar (every step is overwritten)
+ * @return Number of hits written
+ */
+inline int decodeBar(const float* tensor, DrumBar& out, const DecodeParams& params = {},
+                     TensorLayout layout = TensorLayout::NCHW) {
+#if defined(DRUMCORE_HAS_SSE2)
+    return detail::decodeBarSse2(tensor, out, params, layout);
+#else
+    return detail::decodeBarScalar(tensor, out, params, layout);
+#endif
+}
+
+/**
+ * Decode a batch, e.g. many sampled latents for the next bar.
+ *
+ * @param tensor TensorPack::floatsFor(count) floats
+ * @param count Number of bars
+ * @param out count destination bars
+ * @return Total number of hits written
+ */
+inline size_t decode(const float* tensor, size_t count, DrumBar* out,
+                     const DecodeParams& params = {}, TensorLayout layout = TensorLayout::NCHW) {
+    size_t total = 0;
+    for (size_t b = 0; b < count; ++b) {
+        total += static_cast<size_t>(
+            decodeBar(tensor + b * TensorPack::kFloatsPerBar, out[b], params, layout));
+    }
+    return total;
+}
+
+}  // namespace TensorDecode
+
+}  // namespace JKDigital
@@ -0,0 +1,304 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Batch packing of DrumBars into float tensors for model inference.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/config.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(DRUMCORE_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace JKDigital {
+
+/**
+ * Memory order of a packed batch.
+ *
+ * NCHW: [bar][channel][instrument][step] - one 10x32 plane per channel.
+ * NHWC: [bar][instrument][step][channel] - channels interleaved per step.
+ */
+enum class TensorLayout : uint8_t { NCHW = 0, NHWC = 1 };
+
+/**
+ * DrumBar <-> tensor packing (matching the VAE input format).
+ *
+ * Each bar becomes 3 x 10 x 32 floats:
+ *   channel 0  velocity, as stored (0..1)
+ *   channel 1  timing offset / 20 ms, clamped to -1..1
+ *   channel 2  flag bits (ghost | accent | fill candidate) as a float, 0..7
+ *
+ * Packing reads the steps four at a time and transposes them to planes
+ * (NCHW) or converts them in place (NHWC) with SSE2 where available; the
+ * scalar path produces the same output. Output goes straight into a
+ * caller buffer, e.g. the input tensor of an inference runtime; allocate
+ * it with TensorBuffer (or any kAlignment-aligned storage) to meet
+ * runtime alignment requirements.
+ */
+namespace TensorPack {
+
+constexpr int kNumChannels = 3;
+constexpr int kVelocityChannel = 0;
+constexpr int kOffsetChannel = 1;
+constexpr int kFlagsChannel = 2;
+
+constexpr int kRows = DrumBar::NUM_INSTRUMENTS;
+constexpr int kSteps = DrumBar::STEPS_PER_BAR;
+
+/** Floats per packed bar. */
+constexpr size_t kFloatsPerBar = static_cast<size_t>(kNumChannels) * kRows * kSteps;
+
+/** Flag bits carried by the flags channel. */
+constexpr uint8_t kFlagMask =
+    DrumStep::FLAG_GHOST | DrumStep::FLAG_ACCENT | DrumStep::FLAG_FILL_CANDIDATE;
+
+/** Recommended buffer alignment in bytes (cache line / AVX-512). */
+constexpr size_t kAlignment = 64;
+
+/** Offset channel scale: milliseconds to -1..1. */
+constexpr float kOffsetScale = 1.0f / Constants::kMaxTimingOffsetMs;
+
+/** Floats needed for a batch. */
+constexpr size_t floatsFor(size_t count) { return count * kFloatsPerBar; }
+
+/**
+ * Tensor dimensions of a batch, outermost first.
+ *
+ * @param dims Receives {N, 3, 10, 32} (NCHW) or {N, 10, 32, 3} (NHWC)
+ */
+inline void shape(size_t count, TensorLayout layout, int64_t dims[4]) {
+    dims[0] = static_cast<int64_t>(count);
+    if (layout == TensorLayout::NHWC) {
+        dims[1] = kRows;
+        dims[2] = kSteps;
+        dims[3] = kNumChannels;
+    } else {
+        dims[1] = kNumChannels;
+        dims[2] = kRows;
+        dims[3] = kSteps;
+    }
+}
+
+/** Offset channel value for a step offset in ms. */
+inline float normalizeOffset(float offsetMs) {
+    const float v = offsetMs * kOffsetScale;
+    return v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+}
+
+namespace detail {
+
+inline void packBarScalar(const DrumBar& bar, float* out, TensorLayout layout) {
+    for (int i = 0; i < kRows; ++i) {
+        for (int s = 0; s < kSteps; ++s) {
+            const DrumStep& step = bar.steps[i][s];
+            const float v = step.velocity;
+            const float o = normalizeOffset(step.timingOffsetMs);
+            const float f = static_cast<float>(step.flags & kFlagMask);
+            if (layout == TensorLayout::NHWC) {
+                float* dst = out + (i * kSteps + s) * kNumChannels;
+                dst[0] = v;
+                dst[1] = o;
+                dst[2] = f;
+            } else {
+                const int cell = i * kSteps + s;
+                out[kVelocityChannel * kRows * kSteps + cell] = v;
+                out[kOffsetChannel * kRows * kSteps + cell] = o;
+                out[kFlagsChannel * kRows * kSteps + cell] = f;
+            }
+        }
+    }
+}
+
+#if defined(DRUMCORE_HAS_SSE2)
+
+// Four DrumSteps are 12 floats: a = v0 o0 f0 v1, b = o1 f1 v2 o2,
+// c = f2 v3 o3 f3 (f = flag byte plus padding, read as an integer).
+static_assert(sizeof(DrumStep) == 3 * sizeof(float), "DrumStep must be three 32-bit fields");
+static_assert(offsetof(DrumStep, timingOffsetMs) == sizeof(float), "unexpected DrumStep layout");
+static_assert(offsetof(DrumStep, flags) == 2 * sizeof(float), "unexpected DrumStep layout");
+
+inline __m128 offsetLanes(__m128 x) {
+    x = _mm_mul_ps(x, _mm_set1_ps(kOffsetScale));
+    return _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+}
+
+inline __m128 flagLanes(__m128 x) {
+    const __m128i bits = _mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(kFlagMask));
+    return _mm_cvtepi32_ps(bits);
+}
+
+// Per-lane select: mask lanes from y, others from x
+inline __m128 blend(__m128 mask, __m128 x, __m128 y) {
+    return _mm_or_ps(_mm_and_ps(mask, y), _mm_andnot_ps(mask, x));
+}
+
+inline void packBarSse2(const DrumBar& bar, float* out, TensorLayout layout) {
+    const float* src = reinterpret_cast<const float*>(&bar.steps[0][0]);
+    constexpr int kPlane = kRows * kSteps;
+    if (layout == TensorLayout::NCHW) {
+        for (int cell = 0; cell < kPlane; cell += 4) {
+            const __m128 a = _mm_loadu_ps(src + cell * 3);
+            const __m128 b = _mm_loadu_ps(src + cell * 3 + 4);
+            const __m128 c = _mm_loadu_ps(src + cell * 3 + 8);
+            // v = a0 a3 b2 c1, o = a1 b0 b3 c2, f = a2 b1 c0 c3
+            const __m128 bc21 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+            const __m128 v = _mm_shuffle_ps(a, bc21, _MM_SHUFFLE(2, 0, 3, 0));
+            const __m128 ab10 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+            const __m128 bc32 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+            const __m128 o = _mm_shuffle_ps(ab10, bc32, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 ab21 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+            const __m128 f = _mm_shuffle_ps(ab21, c, _MM_SHUFFLE(3, 0, 2, 0));
+            _mm_storeu_ps(out + kVelocityChannel * kPlane + cell, v);
+            _mm_storeu_ps(out + kOffsetChannel * kPlane + cell, offsetLanes(o));
+            _mm_storeu_ps(out + kFlagsChannel * kPlane + cell, flagLanes(f));
+        }
+        return;
+    }
+    // NHWC is the step layout itself: convert each lane by its channel.
+    // Lane channels per vector: V O F V | O F V O | F V O F
+    const __m128 isOffset[3] = {_mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0)),
+                                _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, -1)),
+                                _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0))};
+    const __m128 isFlags[3] = {_mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0)),
+                               _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0)),
+                               _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, -1))};
+    for (int k = 0; k < 3 * kPlane; k += 12) {
+        for (int v = 0; v < 3; ++v) {
+            const __m128 x = _mm_loadu_ps(src + k + v * 4);
+            const __m128 o = blend(isOffset[v], x, offsetLanes(x));
+            _mm_storeu_ps(out + k + v * 4, blend(isFlags[v], o, flagLanes(x)));
+        }
+    }
+}
+
+#endif
+
+}  // namespace detail
+
+/**
+ * Pack one bar (kFloatsPerBar floats).
+ *
+ * @param out Destination, kFloatsPerBar floats
+ */
+inline void packBar(const DrumBar& bar, float* out, TensorLayout layout = TensorLayout::NCHW) {
+#if defined(DRUMCORE_HAS_SSE2)
+    detail::packBarSse2(bar, out, layout);
+#else
+    detail::packBarScalar(bar, out, layout);
+#endif
+}
+
+/**
+ * Pack a batch of bars into one contiguous tensor.
+ *
+ * @param bars Source bars
+ * @param count Number of bars
+ * @param out Destination, floatsFor(count) floats
+ * @param layout Memory order of each bar
+ */
+inline void pack(const DrumBar* bars, size_t count, float* out,
+                 TensorLayout layout = TensorLayout::NCHW) {
+    for (size_t b = 0; b < count; ++b) packBar(bars[b], out + b * kFloatsPerBar, layout);
+}
+
+/**
+ * Pack a batch given as pointers (e.g. bars gathered from several
+ * patterns without copying them together first).
+ */
+inline void pack(const DrumBar* const* bars, size_t count, float* out,
+                 TensorLayout layout = TensorLayout::NCHW) {
+    for (size_t b = 0; b < count; ++b) packBar(*bars[b], out + b * kFloatsPerBar, layout);
+}
+
+}  // namespace TensorPack
+
+//------------------------------------------------------------------------
+// TensorBuffer - aligned float storage for packed batches
+//------------------------------------------------------------------------
+/**
+ * Owning, kAlignment-aligned float buffer sized for a batch of bars.
+ *
+ * Grows on demand and never shrinks, so one buffer can be reused across
+ * batches; data() can be handed to an inference runtime as tensor memory.
+ * Contents are uninitialized after growth.
+ */
+class TensorBuffer {
+  public:
+    TensorBuffer() = default;
+
+    /** Buffer with room for a batch of bars. */
+    explicit TensorBuffer(size_t bars) { reserveBars(bars); }
+
+    ~TensorBuffer() { release(); }
+
+    TensorBuffer(TensorBuffer&& other) noexcept : data_(other.data_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+    }
+
+    TensorBuffer& operator=(TensorBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    TensorBuffer(const TensorBuffer&) = delete;
+    TensorBuffer& operator=(const TensorBuffer&) = delete;
+
+    /** Ensure room for a batch of bars (reallocates only to grow). */
+    void reserveBars(size_t bars) {
+        const size_t floats = TensorPack::floatsFor(bars);
+        if (floats <= capacity_) return;
+        release();
+        data_ = static_cast<float*>(
+            ::operator new(floats * sizeof(float), std::align_val_t(TensorPack::kAlignment)));
+        capacity_ = floats;
+    }
+
+    float* data() { return data_; }
+    const float* data() const { return data_; }
+
+    /** Capacity in floats. */
+    size_t capacity() const { return capacity_; }
+
+    /** Capacity in bars. */
+    size_t capacityBars() const { return capacity_ / TensorPack::kFloatsPerBar; }
+
+    /**
+     * Pack a batch into the buffer, growing it if needed.
+     *
+     * @return Pointer to the packed tensor (floatsFor(count) floats)
+     */
+    float* pack(const DrumBar* bars, size_t count, TensorLayout layout = TensorLayout::NCHW) {
+        reserveBars(count);
+        TensorPack::pack(bars, count, data_, layout);
+        return data_;
+    }
+
+  private:
+    void release() {
+        if (data_ != nullptr) {
+            ::operator delete(data_, std::align_val_t(TensorPack::kAlignment));
+        }
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    float* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+}  // namespace JKDigital
@@ -0,0 +1,376 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Work-stealing thread pool, task groups and parallel loops for offline batches.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// ThreadPool - work-stealing scheduler
+//------------------------------------------------------------------------
+/**
+ * Fixed set of worker threads with one task deque each.
+ *
+ * A worker pushes and pops tasks at the back of its own deque (LIFO, so
+ * recently split work stays in cache) and, when that is empty, steals
+ * from the front of the other deques (FIFO, so thieves take the largest
+ * remaining pieces). Tasks submitted from outside the pool are spread
+ * over the deques round-robin. Idle workers sleep on a condition
+ * variable.
+ *
+ * Intended for offline work (preset rendering, corpus processing,
+ * variation search): tasks are std::function objects and queues take a
+ * mutex, so nothing here is real-time safe. Tasks must not throw.
+ *
+ * Threads that wait on a TaskGroup run pending tasks while they wait,
+ * so a pool with zero workers executes everything on the waiting thread
+ * (useful for debugging and as the serial reference).
+ *
+ * The destructor finishes every queued task before joining the workers.
+ */
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    /** Scheduler counters (approximate while tasks are running). */
+    struct Metrics {
+        uint64_t tasksExecuted = 0;
+        /** Tasks taken from another worker's deque. */
+        uint64_t steals = 0;
+    };
+
+    /** One worker per hardware thread, less the thread that waits on the work. */
+    static unsigned defaultWorkerCount() {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 1;
+    }
+
+    /**
+     * Constructor - starts the workers.
+     *
+     * @param numWorkers Worker threads (0 runs every task on waiting threads)
+     */
+    explicit ThreadPool(unsigned numWorkers = defaultWorkerCount()) : numWorkers_(numWorkers) {
+        const unsigned numQueues = numWorkers > 0 ? numWorkers : 1;
+        queues_.reserve(numQueues);
+        for (unsigned i = 0; i < numQueues; ++i) queues_.push_back(std::make_unique<Queue>());
+        threads_.reserve(numWorkers);
+        for (unsigned i = 0; i < numWorkers; ++i) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : threads_) t.join();
+        // Without workers, anything never waited on still runs here
+        while (runPendingTask()) {
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Number of worker threads. */
+    unsigned numWorkers() const { return numWorkers_; }
+
+    /**
+     * Queue a task. From a worker of this pool the task goes to that
+     * worker's own deque; from any other thread it goes to the next deque
+     * round-robin.
+     */
+    void submit(Task task) {
+        const Local& local = localState();
+        size_t index = local.index;
+        if (local.pool != this) {
+            index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        }
+        {
+            Queue& q = *queues_[index];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        pending_.fetch_add(1);
+        if (sleeping_.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * Run one queued task on the calling thread, if there is one.
+     *
+     * @return false if every deque was empty
+     */
+    bool runPendingTask() {
+        const Local& local = localState();
+        const size_t home = local.pool == this ? local.index : 0;
+        Task task;
+        if (!take(home, local.pool == this, task)) return false;
+        task();
+        tasksExecuted_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Scheduler counters (see Metrics). */
+    Metrics metrics() const {
+        Metrics m;
+        m.tasksExecuted = tasksExecuted_.load(std::memory_order_relaxed);
+        m.steals = steals_.load(std::memory_order_relaxed);
+        return m;
+    }
+
+  private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /** Pool and deque index of the calling thread, if it is a worker. */
+    struct Local {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static Local& localState() {
+        static thread_local Local local;
+        return local;
+    }
+
+    // Own deque from the back, then the others from the front
+    bool take(size_t home, bool isWorker, Task& out) {
+        const size_t n = queues_.size();
+        for (size_t k = 0; k < n; ++k) {
+            const size_t index = (home + k) % n;
+            Queue& q = *queues_[index];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            const bool own = isWorker && k == 0;
+            if (own) {
+                out = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                out = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                steals_.fetch_add(1, std::memory_order_relaxed);
+            }
+            pending_.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index) {
+        Local& local = localState();
+        local.pool = this;
+        local.index = index;
+        for (;;) {
+            if (runPendingTask()) continue;
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleeping_.fetch_add(1);
+            wake_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+            sleeping_.fetch_sub(1);
+            if (stop_ && pending_.load() == 0) return;
+        }
+    }
+
+    unsigned numWorkers_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<uint64_t> tasksExecuted_{0};
+    std::atomic<uint64_t> steals_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<unsigned> sleeping_{0};
+    bool stop_ = false;
+};
+
+//------------------------------------------------------------------------
+// TaskGroup - fork/join scope
+//------------------------------------------------------------------------
+/**
+ * Set of tasks that can be waited on together.
+ *
+ * wait() runs queued tasks (of any group) on the calling thread until
+ * every task of this group has finished, so groups nest freely: a task
+ * may create its own group and wait on it without tying up a worker.
+ * The destructor waits.
+ *
+ *   TaskGroup group(pool);
+ *   group.run([&] { left = render(a); });
+ *   group.run([&] { right = render(b); });
+ *   group.wait();
+ */
+class TaskGroup {
+  public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /** Queue a callable taking no arguments. */
+    template <typename Fn> void run(Fn&& fn) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, f = std::forward<Fn>(fn)]() mutable {
+            f();
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    /** Block until every task of the group has finished, helping meanwhile. */
+    void wait() {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.runPendingTask()) std::this_thread::yield();
+        }
+    }
+
+    ThreadPool& pool() { return pool_; }
+
+  private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_{0};
+};
+
+//------------------------------------------------------------------------
+// Parallel loops
+//------------------------------------------------------------------------
+namespace Parallel {
+
+/**
+ * Number of chunks a range is cut into: ceil(count / grain).
+ *
+ * Chunk c covers [begin + c * grain, min(begin + (c + 1) * grain, end)).
+ * The cut depends only on the range and the grain, never on the pool, so
+ * per-chunk results can be combined in a fixed order.
+ */
+inline size_t numChunks(size_t begin, size_t end, size_t grain) {
+    if (end <= begin) return 0;
+    grain = grain > 0 ? grain : 1;
+    return (end - begin + grain - 1) / grain;
+}
+
+namespace detail {
+
+// Split the chunk range in halves: the upper half becomes a stealable
+// task, the lower half is processed (and split further) in place.
+template <typename ChunkFn>
+void splitChunks(TaskGroup& group, size_t first, size_t last, const ChunkFn& chunkFn) {
+    while (last - first > 1) {
+        const size_t mid = first + (last - first) / 2;
+        group.run([&group, mid, last, &chunkFn] { splitChunks(group, mid, last, chunkFn); });
+        last = mid;
+    }
+    chunkFn(first);
+}
+
+template <typename ChunkFn>
+void forEachChunk(ThreadPool& pool, size_t chunks, const ChunkFn& chunkFn) {
+    if (chunks == 0) return;
+    if (chunks == 1) {
+        chunkFn(0);
+        return;
+    }
+    TaskGroup group(pool);
+    splitChunks(group, 0, chunks, chunkFn);
+    group.wait();
+}
+
+}  // namespace detail
+
+/**
+ * Call fn(chunkBegin, chunkEnd) for every chunk of [begin, end).
+ *
+ * @param grain Indices per chunk (the unit of work stealing)
+ */
+template <typename RangeFn>
+void forRange(ThreadPool& pool, size_t begin, size_t end, size_t grain, const RangeFn& fn) {
+    grain = grain > 0 ? grain : 1;
+    detail::forEachChunk(pool, numChunks(begin, end, grain), [&](size_t c) {
+        const size_t b = begin + c * grain;
+        fn(b, std::min(b + grain, end));
+    });
+}
+
+/**
+ * Call fn(i) for every i in [begin, end).
+ *
+ * The result matches a serial loop as long as fn(i) only depends on i
+ * and writes only to slot i: derive per-item randomness with
+ * Seed::deriveSeed(master, transform, i), never from a shared generator.
+ *
+ *   std::vector<DrumBar> bars(count);
+ *   Parallel::forEach(pool, 0, count, 64, [&](size_t i) {
+ *       FillEngine::generate(source, params, Seed::deriveSeed(master, 0, i), bars[i]);
+ *   });
+ */
+template <typename IndexFn>
+void forEach(ThreadPool& pool, size_t begin, size_t end, size_t grain, const IndexFn& fn) {
+    forRange(pool, begin, end, grain, [&fn](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) fn(i);
+    });
+}
+
+/**
+ * Map each chunk of [begin, end) to a value and fold the values in chunk
+ * order. The result is identical for every pool size (including zero
+ * workers), even for non-associative combines such as float addition.
+ *
+ * Per-chunk values are held in threadScratch() of the calling thread.
+ *
+ * @param identity Initial value of the fold
+ * @param map T(chunkBegin, chunkEnd)
+ * @param combine T(T accumulated, T chunkValue)
+ */
+template <typename T, typename MapFn, typename CombineFn>
+T reduce(ThreadPool& pool, size_t begin, size_t end, size_t grain, T identity, const MapFn& map,
+         const CombineFn& combine) {
+    static_assert(!std::is_same<T, bool>::value,
+                  "vector<bool> slots cannot be written concurrently");
+    grain = grain > 0 ? grain : 1;
+    const size_t chunks = numChunks(begin, end, grain);
+    // Partials live in the caller's scratch arena; tasks the caller helps
+    // with while waiting finish before the scope closes
+    ScratchArena& arena = threadScratch();
+    ScratchArena::Scope scope(arena);
+    std::pmr::vector<T> partial(chunks, identity, &arena);
+    detail::forEachChunk(pool, chunks, [&](size_t c) {
+        const size_t b = begin + c * grain;
+        partial[c] = map(b, std::min(b + grain, end));
+    });
+    T result = std::move(identity);
+    for (size_t c = 0; c < chunks; ++c) result = combine(std::move(result), std::move(partial[c]));
+    return result;
+}
+
+}  // namespace Parallel
+
+}  // namespace JKDigital
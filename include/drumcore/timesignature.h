@@ -6,11 +6,73 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace JKDigital {
 
 /** Supported time signatures. */
 enum class TimeSignature { k4_4 = 0, k3_4 = 1, k6_8 = 2, k5_4 = 3, k7_4 = 4, k7_8 = 5, k12_8 = 6 };
 
+/** Number of values in the TimeSignature enum. */
+constexpr int kNumTimeSignatures = 7;
+
+//------------------------------------------------------------------------
+// TimeSignatureDescriptor - general N/D meter with per-step lookup tables
+//------------------------------------------------------------------------
+/**
+ * General N/D time signature with precomputed per-step tables.
+ *
+ * Steps are 32nd notes (0.125 PPQ) and a bar holds at most 32 of them, so
+ * meters longer than 4/4 are truncated to 32 active steps, matching
+ * TimeSignatureUtils::getActiveSteps().
+ *
+ * The beat is the denominator note, except for compound meters (6/8, 9/8,
+ * 12/8, ...) where it is the dotted note grouping three of them.
+ */
+struct TimeSignatureDescriptor {
+    static constexpr int STEPS_PER_BAR = 32;
+
+    /** Metric weights per step. */
+    static constexpr uint8_t WEIGHT_32ND = 0;
+    static constexpr uint8_t WEIGHT_16TH = 1;
+    static constexpr uint8_t WEIGHT_8TH = 2;
+    static constexpr uint8_t WEIGHT_BEAT = 3;
+    static constexpr uint8_t WEIGHT_DOWNBEAT = 4;
+
+    int numerator = 4;
+    int denominator = 4;
+
+    /** True for compound meters (beat = three denominator notes). */
+    bool compound = false;
+
+    /** Quarter-note beats per bar (PPQ length). */
+    double beatsPerBar = 4.0;
+
+    /** Steps per beat. */
+    int stepsPerBeat = 8;
+
+    /** Number of active steps (at most 32). */
+    int activeSteps = 32;
+
+    /** Bit n set if step n is active. */
+    uint32_t activeMask = 0xFFFFFFFFu;
+
+    /** Beat number of each step (0-based). */
+    uint8_t beatIndex[STEPS_PER_BAR] = {};
+
+    /** Step offset within its beat. */
+    uint8_t subdivision[STEPS_PER_BAR] = {};
+
+    /** Metric weight of each step (WEIGHT_*; 0 for inactive steps). */
+    uint8_t metricWeight[STEPS_PER_BAR] = {};
+
+    /** PPQ position of each step from the bar start. */
+    double ppq[STEPS_PER_BAR] = {};
+
+    /** Check if a step is active. */
+    constexpr bool isActive(int step) const { return ((activeMask >> step) & 1u) != 0; }
+};
+
 /**
  * Utility functions for time signature-aware step calculations.
  *
@@ -19,18 +81,78 @@ enum class TimeSignature { k4_4 = 0, k3_4 = 1, k6_8 = 2, k5_4 = 3, k7_4 = 4, k7_
  */
 namespace TimeSignatureUtils {
 
+/** Check whether an N/D pair can be described (N 1-32, D a power of 2 up to 32). */
+constexpr bool isValid(int numerator, int denominator) {
+    return numerator >= 1 && numerator <= 32 &&
+           (denominator == 1 || denominator == 2 || denominator == 4 || denominator == 8 ||
+            denominator == 16 || denominator == 32);
+}
+
+/**
+ * Build a descriptor for an arbitrary N/D time signature.
+ *
+ * Usable at compile time. Invalid pairs produce a 4/4 descriptor.
+ *
+ * @param numerator Beats per bar (1-32)
+ * @param denominator Beat note value (1, 2, 4, 8, 16 or 32)
+ * @return Descriptor with per-step tables filled
+ */
+constexpr TimeSignatureDescriptor makeDescriptor(int numerator, int denominator) {
+    TimeSignatureDescriptor d;
+    if (!isValid(numerator, denominator)) {
+        numerator = 4;
+        denominator = 4;
+    }
+    constexpr int kSteps = TimeSignatureDescriptor::STEPS_PER_BAR;
+    const int noteSteps = kSteps / denominator;
+
+    d.numerator = numerator;
+    d.denominator = denominator;
+    d.compound = denominator >= 8 && numerator > 3 && numerator % 3 == 0;
+    d.beatsPerBar = static_cast<double>(numerator) * 4.0 / static_cast<double>(denominator);
+    d.stepsPerBeat = d.compound ? noteSteps * 3 : noteSteps;
+
+    const int barSteps = numerator * noteSteps;
+    d.activeSteps = barSteps < kSteps ? barSteps : kSteps;
+    d.activeMask = d.activeSteps >= kSteps ? 0xFFFFFFFFu : ((1u << d.activeSteps) - 1u);
+
+    for (int s = 0; s < kSteps; ++s) {
+        const int beat = s / d.stepsPerBeat;
+        const int offset = s % d.stepsPerBeat;
+        d.beatIndex[s] = static_cast<uint8_t>(beat);
+        d.subdivision[s] = static_cast<uint8_t>(offset);
+        d.ppq[s] = static_cast<double>(s) * 0.125;
+
+        uint8_t weight = TimeSignatureDescriptor::WEIGHT_32ND;
+        if (s >= d.activeSteps) weight = 0;
+        else if (s == 0) weight = TimeSignatureDescriptor::WEIGHT_DOWNBEAT;
+        else if (offset == 0) weight = TimeSignatureDescriptor::WEIGHT_BEAT;
+        else if (offset % 4 == 0) weight = TimeSignatureDescriptor::WEIGHT_8TH;
+        else if (offset % 2 == 0) weight = TimeSignatureDescriptor::WEIGHT_16TH;
+        d.metricWeight[s] = weight;
+    }
+    return d;
+}
+
+/** Precomputed descriptors for the TimeSignature enum, indexed by value. */
+inline constexpr TimeSignatureDescriptor kDescriptors[kNumTimeSignatures] = {
+    makeDescriptor(4, 4), makeDescriptor(3, 4), makeDescriptor(6, 8), makeDescriptor(5, 4),
+    makeDescriptor(7, 4), makeDescriptor(7, 8), makeDescriptor(12, 8)};
+
+/** Get the precomputed descriptor for a time signature (4/4 if out of range). */
+constexpr const TimeSignatureDescriptor& getDescriptor(TimeSignature timeSig) {
+    const int index = static_cast<int>(timeSig);
+    return kDescriptors[(index >= 0 && index < kNumTimeSignatures) ? index : 0];
+}
+
 /** Get the number of active steps for a time signature. */
 constexpr int getActiveSteps(TimeSignature timeSig) {
-    switch (timeSig) {
-    case TimeSignature::k4_4: return 32;
-    case TimeSignature::k3_4: return 24;
-    case TimeSignature::k6_8: return 24;
-    case TimeSignature::k5_4: return 32;
-    case TimeSignature::k7_4: return 32;
-    case TimeSignature::k7_8: return 28;
-    case TimeSignature::k12_8: return 32;
-    default: return 32;
-    }
+    return getDescriptor(timeSig).activeSteps;
+}
+
+/** Get the active-step mask for a time signature (bit n set if step n is active). */
+constexpr uint32_t getActiveMask(TimeSignature timeSig) {
+    return getDescriptor(timeSig).activeMask;
 }
 
 /** Get the constant beats per step value (always 0.125). */
@@ -40,30 +162,12 @@ constexpr double getBeatsPerStep() {
 
 /** Get the numerator of a time signature. */
 constexpr double getNumerator(TimeSignature timeSig) {
-    switch (timeSig) {
-    case TimeSignature::k4_4: return 4.0;
-    case TimeSignature::k3_4: return 3.0;
-    case TimeSignature::k6_8: return 6.0;
-    case TimeSignature::k5_4: return 5.0;
-    case TimeSignature::k7_4: return 7.0;
-    case TimeSignature::k7_8: return 7.0;
-    case TimeSignature::k12_8: return 12.0;
-    default: return 4.0;
-    }
+    return static_cast<double>(getDescriptor(timeSig).numerator);
 }
 
 /** Get the denominator of a time signature. */
 constexpr double getDenominator(TimeSignature timeSig) {
-    switch (timeSig) {
-    case TimeSignature::k4_4: return 4.0;
-    case TimeSignature::k3_4: return 4.0;
-    case TimeSignature::k6_8: return 8.0;
-    case TimeSignature::k5_4: return 4.0;
-    case TimeSignature::k7_4: return 4.0;
-    case TimeSignature::k7_8: return 8.0;
-    case TimeSignature::k12_8: return 8.0;
-    default: return 4.0;
-    }
+    return static_cast<double>(getDescriptor(timeSig).denominator);
 }
 
 /** Get the number of quarter-note beats per bar (PPQ length). */
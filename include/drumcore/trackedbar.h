@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Change tracking for bars and patterns with per-consumer deltas.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/bitutils.h>
+#include <drumcore/constants.h>
+#include <drumcore/drumgrid.h>
+
+#include <cassert>
+#include <cstdint>
+
+namespace JKDigital {
+
+//------------------------------------------------------------------------
+// DirtyRegion - what changed in one bar
+//------------------------------------------------------------------------
+/** Instruments and steps of a bar changed since a consumer last looked. */
+struct DirtyRegion {
+    /** Bit i set if instrument row i has any changed step. */
+    uint32_t instrumentMask = 0;
+
+    /** Changed steps of each row (bit n = step n). */
+    uint32_t stepMasks[DrumBar::NUM_INSTRUMENTS] = {};
+
+    /** Genre, role or barIndex changed. */
+    bool metadata = false;
+
+    /** True if nothing changed. */
+    bool empty() const { return instrumentMask == 0 && !metadata; }
+
+    /** True if instrument row i changed. */
+    bool rowDirty(int instrument) const { return (instrumentMask >> instrument) & 1u; }
+
+    /** Union of the step masks of all rows. */
+    uint32_t stepUnion() const {
+        uint32_t mask = 0;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) mask |= stepMasks[i];
+        return mask;
+    }
+
+    /** First changed step on any row, or -1. */
+    int firstStep() const {
+        const uint32_t mask = stepUnion();
+        return mask != 0 ? BitUtils::countTrailingZeros32(mask) : -1;
+    }
+
+    /** Last changed step on any row, or -1. */
+    int lastStep() const {
+        const uint32_t mask = stepUnion();
+        return mask != 0 ? BitUtils::highestBit64(mask) : -1;
+    }
+};
+
+//------------------------------------------------------------------------
+// TrackedBar - DrumBar with change tracking
+//------------------------------------------------------------------------
+/**
+ * DrumBar whose mutating accessors record which steps changed.
+ *
+ * Every mutation that actually changes a step stamps it with a new
+ * generation. Consumers keep their own Cursor (the generation they last
+ * saw), so any number of independent consumers - event rendering,
+ * hashing, serialization, UI repaint - each get exactly their own delta
+ * and never clear each other's state. Writes that leave a step unchanged
+ * are not reported.
+ *
+ * Reads go through bar(); writing through anything other than the
+ * accessors below bypasses tracking (use markDirty afterwards).
+ * No allocation; not thread-safe (one writer, consumers on the same
+ * thread or synchronized externally).
+ */
+class TrackedBar {
+  public:
+    /** Consumer position; a default Cursor sees the whole bar as changed. */
+    struct Cursor {
+        uint32_t seen = 0;
+    };
+
+    /** Constructor - empty bar, all steps dirty for new consumers. */
+    TrackedBar() { markAllDirty(); }
+
+    /** Constructor - copy of a bar, all steps dirty for new consumers. */
+    explicit TrackedBar(const DrumBar& bar) : bar_(bar) { markAllDirty(); }
+
+    /** Current contents (read-only). */
+    const DrumBar& bar() const { return bar_; }
+
+    /** Read one step. */
+    const DrumStep& step(int instrument, int step) const {
+        return bar_.getStep(instrument, step);
+    }
+
+    /** Generation of the most recent change. */
+    uint32_t generation() const { return generation_; }
+
+    /** Replace one step. Returns true if it changed. */
+    bool setStep(int instrument, int step, const DrumStep& value) {
+        DrumStep& current = bar_.getStep(instrument, step);
+        if (current.velocity == value.velocity && current.timingOffsetMs == value.timingOffsetMs &&
+            current.flags == value.flags) {
+            return false;
+        }
+        current = value;
+        stamp(instrument, step);
+        return true;
+    }
+
+    /** Set the velocity of one step. Returns true if it changed. */
+    bool setVelocity(int instrument, int step, float velocity) {
+        DrumStep value = bar_.getStep(instrument, step);
+        value.velocity = velocity;
+        return setStep(instrument, step, value);
+    }
+
+    /** Set the timing offset of one step. Returns true if it changed. */
+    bool setTimingOffset(int instrument, int step, float offsetMs) {
+        DrumStep value = bar_.getStep(instrument, step);
+        value.timingOffsetMs = offsetMs;
+        return setStep(instrument, step, value);
+    }
+
+    /** Set the flags of one step. Returns true if it changed. */
+    bool setFlags(int instrument, int step, uint8_t flags) {
+        DrumStep value = bar_.getStep(instrument, step);
+        value.flags = flags;
+        return setStep(instrument, step, value);
+    }
+
+    /** Clear one step. Returns true if it changed. */
+    bool clearStep(int instrument, int step) { return setStep(instrument, step, DrumStep()); }
+
+    /** Clear one instrument row; only non-empty steps are reported. */
+    void clearRow(int instrument) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) clearStep(instrument, s);
+    }
+
+    /** Clear the whole bar; only non-empty steps are reported. */
+    void clear() {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) clearRow(i);
+    }
+
+    /**
+     * Replace the contents with another bar, reporting only the steps
+     * (and metadata) that differ.
+     *
+     * @return Number of steps that changed
+     */
+    int assign(const DrumBar& other) {
+        int changed = 0;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                changed += setStep(i, s, other.steps[i][s]) ? 1 : 0;
+            }
+        }
+        setGenre(other.genre);
+        setRole(other.role);
+        setBarIndex(other.barIndex);
+        return changed;
+    }
+
+    /** Set the genre (metadata change). */
+    void setGenre(DrumBar::Genre genre) {
+        if (bar_.genre == genre) return;
+        bar_.genre = genre;
+        metadataGen_ = ++generation_;
+    }
+
+    /** Set the role (metadata change). */
+    void setRole(DrumBar::Role role) {
+        if (bar_.role == role) return;
+        bar_.role = role;
+        metadataGen_ = ++generation_;
+    }
+
+    /** Set the phrase position (metadata change). */
+    void setBarIndex(int32_t barIndex) {
+        if (bar_.barIndex == barIndex) return;
+        bar_.barIndex = barIndex;
+        metadataGen_ = ++generation_;
+    }
+
+    /**
+     * Record a change made outside the accessors.
+     *
+     * @param instrument Instrument row
+     * @param stepMask Steps that changed (bit n = step n)
+     */
+    void markDirty(int instrument, uint32_t stepMask = DrumBar::ALL_STEPS) {
+        assert(instrument >= 0 && instrument < DrumBar::NUM_INSTRUMENTS);
+        if (stepMask == 0) return;
+        const uint32_t gen = ++generation_;
+        rowGen_[instrument] = gen;
+        for (uint32_t m = stepMask; m != 0; m &= m - 1) {
+            stepGen_[instrument][BitUtils::countTrailingZeros32(m)] = gen;
+        }
+    }
+
+    /** Mark every step and the metadata as changed. */
+    void markAllDirty() {
+        const uint32_t gen = ++generation_;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            rowGen_[i] = gen;
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) stepGen_[i][s] = gen;
+        }
+        metadataGen_ = gen;
+    }
+
+    /**
+     * Everything changed after a generation. Only rows changed since
+     * then are scanned.
+     */
+    DirtyRegion changesSince(uint32_t generation) const {
+        DirtyRegion region;
+        region.metadata = metadataGen_ > generation;
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            if (rowGen_[i] <= generation) continue;
+            uint32_t mask = 0;
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                mask |= static_cast<uint32_t>(stepGen_[i][s] > generation) << s;
+            }
+            region.stepMasks[i] = mask;
+            region.instrumentMask |= 1u << i;
+        }
+        return region;
+    }
+
+    /** True if anything changed since the cursor's last consume. */
+    bool hasChanges(const Cursor& cursor) const { return generation_ > cursor.seen; }
+
+    /** Changes since the cursor's last consume; advances the cursor. */
+    DirtyRegion consume(Cursor& cursor) const {
+        const DirtyRegion region = changesSince(cursor.seen);
+        cursor.seen = generation_;
+        return region;
+    }
+
+  private:
+    void stamp(int instrument, int step) {
+        const uint32_t gen = ++generation_;
+        rowGen_[instrument] = gen;
+        stepGen_[instrument][step] = gen;
+    }
+
+    DrumBar bar_;
+    uint32_t generation_ = 0;
+    uint32_t metadataGen_ = 0;
+    uint32_t rowGen_[DrumBar::NUM_INSTRUMENTS] = {};
+    uint32_t stepGen_[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR] = {};
+};
+
+//------------------------------------------------------------------------
+// TrackedPattern - multi-bar pattern with change tracking
+//------------------------------------------------------------------------
+/**
+ * Up to Constants::kMaxPatternLength TrackedBars plus a length.
+ *
+ * A pattern Cursor remembers one generation per bar and the pattern
+ * length it last saw, so consume() reports which bars changed and the
+ * DirtyRegion of each. Bars beyond a shrink are not reported; bars
+ * revealed by a grow are reported in full.
+ */
+class TrackedPattern {
+  public:
+    static constexpr int MAX_BARS = Constants::kMaxPatternLength;
+
+    /** Consumer position; a default Cursor sees every bar as changed. */
+    struct Cursor {
+        TrackedBar::Cursor bars[MAX_BARS];
+        int numBars = 0;
+    };
+
+    /** Constructor - pattern of the given length (clamped to 1..MAX_BARS). */
+    explicit TrackedPattern(int numBars = Constants::kDefaultPatternLength) {
+        setNumBars(numBars);
+    }
+
+    /** Number of bars in the pattern. */
+    int numBars() const { return numBars_; }
+
+    /**
+     * Change the pattern length (clamped to 1..MAX_BARS). Bars past the
+     * old end are marked fully dirty.
+     */
+    void setNumBars(int numBars) {
+        numBars = numBars < 1 ? 1 : (numBars > MAX_BARS ? MAX_BARS : numBars);
+        for (int b = numBars_; b < numBars; ++b) bars_[b].markAllDirty();
+        numBars_ = numBars;
+    }
+
+    /** Tracked bar (barIndex must be in 0..MAX_BARS-1). */
+    TrackedBar& operator[](int barIndex) {
+        assert(barIndex >= 0 && barIndex < MAX_BARS);
+        return bars_[barIndex];
+    }
+
+    const TrackedBar& operator[](int barIndex) const {
+        assert(barIndex >= 0 && barIndex < MAX_BARS);
+        return bars_[barIndex];
+    }
+
+    /**
+     * Replace the pattern from plain bars, reporting only the steps that
+     * differ.
+     *
+     * @return Number of steps that changed
+     */
+    int assign(const DrumBar* bars, int numBars) {
+        setNumBars(numBars);
+        int changed = 0;
+        for (int b = 0; b < numBars_; ++b) changed += bars_[b].assign(bars[b]);
+        return changed;
+    }
+
+    /** Bit b set if bar b changed since the cursor's last consume. */
+    uint32_t changedBars(const Cursor& cursor) const {
+        uint32_t mask = 0;
+        for (int b = 0; b < numBars_; ++b) {
+            const bool grown = b >= cursor.numBars;
+            mask |= static_cast<uint32_t>(grown || bars_[b].hasChanges(cursor.bars[b])) << b;
+        }
+        return mask;
+    }
+
+    /**
+     * Changes since the cursor's last consume; advances the cursor.
+     *
+     * @param cursor Consumer cursor
+     * @param regions Receives one DirtyRegion per bar (numBars entries; bars
+     *        outside the returned mask are empty). May be nullptr.
+     * @return Bit b set if bar b changed
+     */
+    uint32_t consume(Cursor& cursor, DirtyRegion* regions) const {
+        const uint32_t mask = changedBars(cursor);
+        for (int b = 0; b < numBars_; ++b) {
+            if (b >= cursor.numBars) cursor.bars[b].seen = 0;
+            const DirtyRegion region = bars_[b].consume(cursor.bars[b]);
+            if (regions != nullptr) regions[b] = region;
+        }
+        cursor.numBars = numBars_;
+        return mask;
+    }
+
+  private:
+    TrackedBar bars_[MAX_BARS];
+    int numBars_ = 0;
+};
+
+}  // namespace JKDigital
@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// C++20 named module exporting the drumcore public API.
+//
+// `import drumcore;` is equivalent to including drumcore.h, but the
+// headers are parsed once when the module interface is built. Macros
+// (DRUMCORE_VERSION_*, DRUMCORE_DECL) are not exported; include the
+// headers that define them where they are needed.
+//------------------------------------------------------------------------
+
+module;
+
+#include <drumcore/drumcore.h>
+
+export module drumcore;
+
+export namespace JKDigital {
+
+// Grid, change tracking and buffers
+using JKDigital::DirtyRegion;
+using JKDigital::DrumBar;
+using JKDigital::DrumPatternBuffer;
+using JKDigital::DrumStep;
+using JKDigital::TrackedBar;
+using JKDigital::TrackedPattern;
+using JKDigital::LockFreeQueue;
+
+// Time signatures
+using JKDigital::kNumTimeSignatures;
+using JKDigital::TimeSignature;
+using JKDigital::TimeSignatureDescriptor;
+
+// Sampling, generation and analysis
+using JKDigital::AliasTable;
+using JKDigital::BarSampler;
+using JKDigital::GenreClassifier;
+using JKDigital::MarkovPatternModel;
+using JKDigital::MarkovTrainer;
+using JKDigital::PatternHistory;
+using JKDigital::PatternLibraryIndex;
+using JKDigital::PatternSnapshot;
+using JKDigital::RhythmFeatures;
+using JKDigital::TransformContext;
+using JKDigital::TransformFn;
+using JKDigital::TransformPipeline;
+
+// Fills, groove and humanization
+using JKDigital::FillCandidates;
+using JKDigital::FillLength;
+using JKDigital::FillParams;
+using JKDigital::FillVoicing;
+using JKDigital::kNumFillLengths;
+using JKDigital::GrooveTemplate;
+using JKDigital::GrooveUnit;
+using JKDigital::HumanizeInstrumentProfile;
+using JKDigital::HumanizeProfile;
+using JKDigital::JitterDistribution;
+using JKDigital::SwingResolution;
+
+// MIDI
+using JKDigital::KitMap;
+using JKDigital::MidiRecorder;
+using JKDigital::NoteOffScheduler;
+using JKDigital::RetriggerPolicy;
+using JKDigital::VelocityCurve;
+
+// Real-time support and memory
+using JKDigital::BoundedPool;
+using JKDigital::DenormalGuard;
+using JKDigital::RtAllowScope;
+using JKDigital::RtHistogram;
+using JKDigital::RtProfiler;
+using JKDigital::RtScope;
+using JKDigital::ScratchArena;
+using JKDigital::ScopedDenormalDisable;
+using JKDigital::threadScratch;
+
+// Offline batch processing and model I/O
+using JKDigital::DecodeParams;
+using JKDigital::GainCurve;
+using JKDigital::RenderSettings;
+using JKDigital::Sample;
+using JKDigital::SampleKit;
+using JKDigital::TaskGroup;
+using JKDigital::TensorBuffer;
+using JKDigital::TensorLayout;
+using JKDigital::ThreadPool;
+
+namespace BitUtils {
+using JKDigital::BitUtils::countTrailingZeros32;
+using JKDigital::BitUtils::highestBit64;
+using JKDigital::BitUtils::lowMask32;
+using JKDigital::BitUtils::popcount32;
+}  // namespace BitUtils
+
+namespace Constants {
+using JKDigital::Constants::kAccentVelocityMultiplier;
+using JKDigital::Constants::kBeatsPerStep;
+using JKDigital::Constants::kDefaultPatternLength;
+using JKDigital::Constants::kDefaultTempo;
+using JKDigital::Constants::kGhostVelocityMultiplier;
+using JKDigital::Constants::kMaxPatternLength;
+using JKDigital::Constants::kMaxTempo;
+using JKDigital::Constants::kMaxTimingOffsetMs;
+using JKDigital::Constants::kMaxVelocity;
+using JKDigital::Constants::kMinPatternLength;
+using JKDigital::Constants::kMinTempo;
+using JKDigital::Constants::kMinTimingOffsetMs;
+using JKDigital::Constants::kMinVelocity;
+using JKDigital::Constants::kNoteDurationSeconds;
+using JKDigital::Constants::kNumInstruments;
+using JKDigital::Constants::kStepsPerBar;
+}  // namespace Constants
+
+namespace FillEngine {
+using JKDigital::FillEngine::findCandidates;
+using JKDigital::FillEngine::generate;
+using JKDigital::FillEngine::genreVoicing;
+using JKDigital::FillEngine::land;
+}  // namespace FillEngine
+
+namespace GMDrumMap {
+using JKDigital::GMDrumMap::CLOSED_HH;
+using JKDigital::GMDrumMap::CRASH;
+using JKDigital::GMDrumMap::getNote;
+using JKDigital::GMDrumMap::HIGH_TOM;
+using JKDigital::GMDrumMap::KICK;
+using JKDigital::GMDrumMap::LOW_TOM;
+using JKDigital::GMDrumMap::MID_TOM;
+using JKDigital::GMDrumMap::OPEN_HH;
+using JKDigital::GMDrumMap::PERCUSSION;
+using JKDigital::GMDrumMap::RIDE;
+using JKDigital::GMDrumMap::RIM;
+using JKDigital::GMDrumMap::SNARE;
+using JKDigital::GMDrumMap::toMidiVelocity;
+}  // namespace GMDrumMap
+
+namespace GenreMapper {
+using JKDigital::GenreMapper::fromIndex;
+using JKDigital::GenreMapper::fromNormalizedValue;
+using JKDigital::GenreMapper::kNumGenres;
+using JKDigital::GenreMapper::toDisplayString;
+using JKDigital::GenreMapper::toGenreString;
+using JKDigital::GenreMapper::toIndex;
+using JKDigital::GenreMapper::toNormalizedValue;
+}  // namespace GenreMapper
+
+namespace Groove {
+using JKDigital::Groove::apply;
+using JKDigital::Groove::extract;
+using JKDigital::Groove::kMinVelocity;
+}  // namespace Groove
+
+namespace Humanizer {
+using JKDigital::Humanizer::genreProfile;
+using JKDigital::Humanizer::humanizeBar;
+using JKDigital::Humanizer::humanizePattern;
+using JKDigital::Humanizer::jitter;
+using JKDigital::Humanizer::kMinHumanizedVelocity;
+using JKDigital::Humanizer::phraseDrift;
+}  // namespace Humanizer
+
+namespace Parallel {
+using JKDigital::Parallel::forEach;
+using JKDigital::Parallel::forRange;
+using JKDigital::Parallel::numChunks;
+using JKDigital::Parallel::reduce;
+}  // namespace Parallel
+
+namespace RhythmAnalysis {
+using JKDigital::RhythmAnalysis::extract;
+using JKDigital::RhythmAnalysis::kMetricMasks;
+using JKDigital::RhythmAnalysis::makeMetricMasks;
+using JKDigital::RhythmAnalysis::MetricMasks;
+}  // namespace RhythmAnalysis
+
+namespace RtSafety {
+using JKDigital::RtSafety::check;
+using JKDigital::RtSafety::enabled;
+using JKDigital::RtSafety::Handler;
+using JKDigital::RtSafety::isRealtimeThread;
+using JKDigital::RtSafety::kNumViolations;
+using JKDigital::RtSafety::resetCounts;
+using JKDigital::RtSafety::setHandler;
+using JKDigital::RtSafety::totalViolations;
+using JKDigital::RtSafety::Violation;
+using JKDigital::RtSafety::violationCount;
+}  // namespace RtSafety
+
+namespace SampleRenderer {
+using JKDigital::SampleRenderer::barFrames;
+using JKDigital::SampleRenderer::render;
+using JKDigital::SampleRenderer::renderBatch;
+using JKDigital::SampleRenderer::renderFrames;
+}  // namespace SampleRenderer
+
+namespace Seed {
+using JKDigital::Seed::counterRandom;
+using JKDigital::Seed::deriveSeed;
+using JKDigital::Seed::fillFloats;
+using JKDigital::Seed::floatAt;
+using JKDigital::Seed::fromNormalized;
+using JKDigital::Seed::nextRandom;
+using JKDigital::Seed::randomAt;
+using JKDigital::Seed::randomFloat;
+using JKDigital::Seed::splitmix64;
+using JKDigital::Seed::stepCounter;
+using JKDigital::Seed::toUnitFloat;
+}  // namespace Seed
+
+namespace TensorDecode {
+using JKDigital::TensorDecode::decode;
+using JKDigital::TensorDecode::decodeBar;
+using JKDigital::TensorDecode::kHitChannel;
+using JKDigital::TensorDecode::kOffsetChannel;
+using JKDigital::TensorDecode::kVelocityChannel;
+}  // namespace TensorDecode
+
+namespace TensorPack {
+using JKDigital::TensorPack::floatsFor;
+using JKDigital::TensorPack::kAlignment;
+using JKDigital::TensorPack::kFlagMask;
+using JKDigital::TensorPack::kFlagsChannel;
+using JKDigital::TensorPack::kFloatsPerBar;
+using JKDigital::TensorPack::kNumChannels;
+using JKDigital::TensorPack::kOffsetChannel;
+using JKDigital::TensorPack::kOffsetScale;
+using JKDigital::TensorPack::kRows;
+using JKDigital::TensorPack::kSteps;
+using JKDigital::TensorPack::kVelocityChannel;
+using JKDigital::TensorPack::normalizeOffset;
+using JKDigital::TensorPack::pack;
+using JKDigital::TensorPack::packBar;
+using JKDigital::TensorPack::shape;
+}  // namespace TensorPack
+
+namespace TimeSignatureUtils {
+using JKDigital::TimeSignatureUtils::getActiveMask;
+using JKDigital::TimeSignatureUtils::getActiveSteps;
+using JKDigital::TimeSignatureUtils::getBeatsPerBar;
+using JKDigital::TimeSignatureUtils::getBeatsPerStep;
+using JKDigital::TimeSignatureUtils::getDenominator;
+using JKDigital::TimeSignatureUtils::getDescriptor;
+using JKDigital::TimeSignatureUtils::getNumerator;
+using JKDigital::TimeSignatureUtils::isValid;
+using JKDigital::TimeSignatureUtils::kDescriptors;
+using JKDigital::TimeSignatureUtils::makeDescriptor;
+}  // namespace TimeSignatureUtils
+
+namespace Wav {
+using JKDigital::Wav::encode;
+using JKDigital::Wav::Format;
+using JKDigital::Wav::load;
+using JKDigital::Wav::parse;
+using JKDigital::Wav::save;
+}  // namespace Wav
+
+}  // namespace JKDigital
@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Separately compiled definitions for the drumcore_impl library.
+//
+// Built with DRUMCORE_SEPARATE_COMPILATION: the headers only declare the
+// functions marked DRUMCORE_DECL, and this translation unit provides their
+// single definition plus the explicit LockFreeQueue instantiations that
+// lockfreequeue.h declares extern.
+//------------------------------------------------------------------------
+
+#if !defined(DRUMCORE_SEPARATE_COMPILATION)
+#error "drumcore_impl.cpp must be built with DRUMCORE_SEPARATE_COMPILATION"
+#endif
+
+#include <drumcore/drumcore.h>
+
+#include <drumcore/impl/genreclassifier.ipp>
+#include <drumcore/impl/groove.ipp>
+#include <drumcore/impl/humanizer.ipp>
+#include <drumcore/impl/rhythmfeatures.ipp>
+
+namespace JKDigital {
+
+template class LockFreeQueue<float, 16>;
+template class LockFreeQueue<int32_t, 16>;
+
+}  // namespace JKDigital
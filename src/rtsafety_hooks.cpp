@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Interposed allocation, lock, sleep and file I/O hooks for RtSafety.
+//
+// Linux/glibc only. Linked into an executable, these definitions take
+// precedence over libc's, so calls from shared libraries (libstdc++'s
+// operator new, std::mutex, ...) are seen too. Allocation forwards to
+// glibc's __libc_* entry points; everything else to the next definition
+// found with dlsym(RTLD_NEXT), resolved once at load time.
+//------------------------------------------------------------------------
+
+#include <drumcore/rtsafety.h>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+using JKDigital::RtSafety::Violation;
+using JKDigital::RtSafety::check;
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void __libc_free(void* ptr);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+namespace {
+
+using MutexLockFn = int (*)(pthread_mutex_t*);
+using SleepFn = unsigned int (*)(unsigned int);
+using UsleepFn = int (*)(useconds_t);
+using NanosleepFn = int (*)(const timespec*, timespec*);
+using ClockNanosleepFn = int (*)(clockid_t, int, const timespec*, timespec*);
+using OpenFn = int (*)(const char*, int, ...);
+using FopenFn = FILE* (*)(const char*, const char*);
+using ReadFn = ssize_t (*)(int, void*, size_t);
+using WriteFn = ssize_t (*)(int, const void*, size_t);
+using FreadFn = size_t (*)(void*, size_t, size_t, FILE*);
+using FwriteFn = size_t (*)(const void*, size_t, size_t, FILE*);
+
+struct NextFunctions {
+    MutexLockFn mutexLock = nullptr;
+    SleepFn sleep = nullptr;
+    UsleepFn usleep = nullptr;
+    NanosleepFn nanosleep = nullptr;
+    ClockNanosleepFn clockNanosleep = nullptr;
+    OpenFn open = nullptr;
+    FopenFn fopen = nullptr;
+    ReadFn read = nullptr;
+    WriteFn write = nullptr;
+    FreadFn fread = nullptr;
+    FwriteFn fwrite = nullptr;
+};
+
+NextFunctions next;
+
+template <typename Fn>
+void resolve(Fn& fn, const char* name) {
+    if (fn == nullptr) fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+}
+
+void resolveAll() {
+    resolve(next.mutexLock, "pthread_mutex_lock");
+    resolve(next.sleep, "sleep");
+    resolve(next.usleep, "usleep");
+    resolve(next.nanosleep, "nanosleep");
+    resolve(next.clockNanosleep, "clock_nanosleep");
+    resolve(next.open, "open");
+    resolve(next.fopen, "fopen");
+    resolve(next.read, "read");
+    resolve(next.write, "write");
+    resolve(next.fread, "fread");
+    resolve(next.fwrite, "fwrite");
+}
+
+// Resolve the forwarding table and load the unwinder before any RtScope
+// exists: both allocate on first use
+__attribute__((constructor)) void initialize() {
+    resolveAll();
+    void* frames[4];
+    backtrace(frames, 4);
+}
+
+// Write directly through the syscall so reporting never re-enters the hooks
+void writeStderr(const char* text) {
+    syscall(SYS_write, STDERR_FILENO, text, std::strlen(text));
+}
+
+}  // namespace
+
+namespace JKDigital {
+namespace RtSafety {
+
+void defaultHandler(Violation violation, const char* function) {
+    static const char* const kNames[kNumViolations] = {"allocation", "deallocation", "mutex lock",
+                                                       "sleep", "file I/O"};
+    writeStderr("drumcore RT violation: ");
+    writeStderr(kNames[static_cast<int>(violation)]);
+    writeStderr(" (");
+    writeStderr(function);
+    writeStderr(") on a real-time thread\n");
+
+    void* frames[32];
+    const int depth = backtrace(frames, 32);
+    backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+}
+
+}  // namespace RtSafety
+}  // namespace JKDigital
+
+extern "C" {
+
+//------------------------------------------------------------------------
+// Heap
+//------------------------------------------------------------------------
+void* malloc(size_t size) {
+    check(Violation::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+void free(void* ptr) {
+    if (ptr != nullptr) check(Violation::Deallocation, "free");
+    __libc_free(ptr);
+}
+
+void* calloc(size_t count, size_t size) {
+    check(Violation::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    check(Violation::Allocation, "realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    check(Violation::Allocation, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    check(Violation::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    check(Violation::Allocation, "posix_memalign");
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+//------------------------------------------------------------------------
+// Locks
+//------------------------------------------------------------------------
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    check(Violation::MutexLock, "pthread_mutex_lock");
+    resolve(next.mutexLock, "pthread_mutex_lock");
+    return next.mutexLock(mutex);
+}
+
+//------------------------------------------------------------------------
+// Sleeps
+//------------------------------------------------------------------------
+unsigned int sleep(unsigned int seconds) {
+    check(Violation::Sleep, "sleep");
+    resolve(next.sleep, "sleep");
+    return next.sleep(seconds);
+}
+
+int usleep(useconds_t usec) {
+    check(Violation::Sleep, "usleep");
+    resolve(next.usleep, "usleep");
+    return next.usleep(usec);
+}
+
+int nanosleep(const timespec* req, timespec* rem) {
+    check(Violation::Sleep, "nanosleep");
+    resolve(next.nanosleep, "nanosleep");
+    return next.nanosleep(req, rem);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const timespec* req, timespec* rem) {
+    check(Violation::Sleep, "clock_nanosleep");
+    resolve(next.clockNanosleep, "clock_nanosleep");
+    return next.clockNanosleep(clock, flags, req, rem);
+}
+
+//------------------------------------------------------------------------
+// File I/O
+//------------------------------------------------------------------------
+int open(const char* path, int flags, ...) {
+    check(Violation::FileIo, "open");
+    resolve(next.open, "open");
+    mode_t mode = 0;
+    // O_TMPFILE includes the O_DIRECTORY bit: test the whole value
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE) {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, int));
+        va_end(args);
+    }
+    return next.open(path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode) {
+    check(Violation::FileIo, "fopen");
+    resolve(next.fopen, "fopen");
+    return next.fopen(path, mode);
+}
+
+ssize_t read(int fd, void* buffer, size_t count) {
+    check(Violation::FileIo, "read");
+    resolve(next.read, "read");
+    return next.read(fd, buffer, count);
+}
+
+ssize_t write(int fd, const void* buffer, size_t count) {
+    check(Violation::FileIo, "write");
+    resolve(next.write, "write");
+    return next.write(fd, buffer, count);
+}
+
+size_t fread(void* buffer, size_t size, size_t count, FILE* file) {
+    check(Violation::FileIo, "fread");
+    resolve(next.fread, "fread");
+    return next.fread(buffer, size, count, file);
+}
+
+size_t fwrite(const void* buffer, size_t size, size_t count, FILE* file) {
+    check(Violation::FileIo, "fwrite");
+    resolve(next.fwrite, "fwrite");
+    return next.fwrite(buffer, size, count, file);
+}
+
+}  // extern "C"
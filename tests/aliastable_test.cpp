@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/aliastable.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace JKDigital;
+
+TEST(AliasTable, InitiallyEmpty) {
+    AliasTable<8> table;
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(table.sample(12345), -1);
+}
+
+TEST(AliasTable, Build_RejectsInvalidInput) {
+    AliasTable<4> table;
+    const float zeros[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    const float weights[5] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    EXPECT_FALSE(table.build(zeros, 4));
+    EXPECT_FALSE(table.build(weights, 5));
+    EXPECT_FALSE(table.build(weights, 0));
+    EXPECT_TRUE(table.isEmpty());
+}
+
+TEST(AliasTable, ZeroWeightNeverDrawn) {
+    AliasTable<4> table;
+    const float weights[4] = {1.0f, 0.0f, 3.0f, 0.0f};
+    ASSERT_TRUE(table.build(weights, 4));
+    uint64_t state = 42;
+    for (int k = 0; k < 10000; ++k) {
+        const int v = table.draw(state);
+        EXPECT_TRUE(v == 0 || v == 2);
+    }
+}
+
+TEST(AliasTable, MatchesDistribution) {
+    AliasTable<4> table;
+    const float weights[4] = {0.1f, 0.2f, 0.3f, 0.4f};
+    ASSERT_TRUE(table.build(weights, 4));
+    int counts[4] = {0, 0, 0, 0};
+    constexpr int kDraws = 100000;
+    const uint64_t seed = Seed::deriveSeed(1, 0, 0);
+    for (int k = 0; k < kDraws; ++k) {
+        ++counts[table.sample(Seed::randomAt(seed, static_cast<uint64_t>(k)))];
+    }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(static_cast<double>(counts[i]) / kDraws, weights[i], 0.01);
+    }
+}
+
+TEST(AliasTable, SingleOutcome) {
+    AliasTable<4> table;
+    const float weight = 2.0f;
+    ASSERT_TRUE(table.build(&weight, 1));
+    EXPECT_EQ(table.sample(0), 0);
+    EXPECT_EQ(table.sample(UINT64_MAX), 0);
+}
+
+TEST(AliasTable, LargeTableBuildsFromThreadScratch) {
+    // 768 KB of worklists would not fit a 512 KB secondary-thread stack
+    using Large = AliasTable<65536>;
+    auto table = std::make_unique<Large>();
+    std::vector<float> weights(Large::MAX_SIZE, 0.0f);
+    weights[7] = 1.0f;
+    weights[60000] = 3.0f;
+
+    const ScratchArena& arena = threadScratch();
+    const size_t inUse = arena.metrics().bytesInUse;
+    const uint64_t allocations = arena.metrics().allocations;
+    ASSERT_TRUE(table->build(weights.data(), Large::MAX_SIZE));
+    EXPECT_GT(arena.metrics().allocations, allocations);
+    EXPECT_EQ(arena.metrics().bytesInUse, inUse);  // Rewound after the build
+
+    int counts[2] = {0, 0};
+    uint64_t state = 9;
+    for (int k = 0; k < 4000; ++k) {
+        const int v = table->draw(state);
+        ASSERT_TRUE(v == 7 || v == 60000);
+        ++counts[v == 60000];
+    }
+    EXPECT_NEAR(counts[1] / 4000.0, 0.75, 0.03);
+}
+
+TEST(BarSampler, DrawCell_OnlyWeightedCells) {
+    float grid[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR] = {};
+    grid[0][0] = 1.0f;
+    grid[1][8] = 0.5f;
+    BarSampler sampler;
+    ASSERT_TRUE(sampler.setHitGrid(grid));
+    uint64_t state = 9;
+    for (int k = 0; k < 1000; ++k) {
+        const int cell = sampler.drawCell(Seed::nextRandom(state));
+        EXPECT_TRUE(cell == 0 || cell == 1 * 32 + 8);
+    }
+    EXPECT_EQ(sampler.drawStep(1, 123456789), 8);
+    EXPECT_EQ(sampler.drawStep(2, 123456789), -1);
+}
+
+TEST(BarSampler, SetHitGrid_EmptyFails) {
+    DrumBar empty;
+    BarSampler sampler;
+    EXPECT_FALSE(sampler.setHitGrid(empty));
+}
+
+TEST(BarSampler, VelocityLevels) {
+    BarSampler sampler;
+    const float weights[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    ASSERT_TRUE(sampler.setVelocityDistribution(0, weights, 4));
+    EXPECT_FLOAT_EQ(sampler.drawVelocity(0, 777), 1.0f);
+    EXPECT_FLOAT_EQ(sampler.drawVelocity(1, 777), BarSampler::kDefaultVelocity);
+    EXPECT_FALSE(sampler.setVelocityDistribution(10, weights, 4));
+}
+
+TEST(BarSampler, DrawBar_DeterministicAndOnGrid) {
+    DrumBar source;
+    source.getStep(0, 0).velocity = 1.0f;
+    source.getStep(0, 16).velocity = 1.0f;
+    source.getStep(1, 8).velocity = 1.0f;
+    source.getStep(2, 4).velocity = 0.5f;
+    BarSampler sampler;
+    ASSERT_TRUE(sampler.setHitGrid(source));
+
+    DrumBar a;
+    DrumBar b;
+    sampler.drawBar(a, Seed::deriveSeed(5, 1, 2), 8);
+    sampler.drawBar(b, Seed::deriveSeed(5, 1, 2), 8);
+    EXPECT_TRUE(a.hasNotes());
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            EXPECT_EQ(a.getStep(i, s).velocity, b.getStep(i, s).velocity);
+            if (a.getStep(i, s).hasNote()) {
+                EXPECT_TRUE(source.getStep(i, s).hasNote());
+            }
+        }
+    }
+}
+
+TEST(BarSampler, DrawBarIndependent_RespectsProbabilities) {
+    float grid[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR] = {};
+    grid[0][0] = 1.0f;
+    grid[1][8] = 0.25f;
+    BarSampler sampler;
+    ASSERT_TRUE(sampler.setHitGrid(grid));
+
+    int snareHits = 0;
+    constexpr int kBars = 4000;
+    for (uint32_t bar = 0; bar < kBars; ++bar) {
+        DrumBar out;
+        sampler.drawBarIndependent(out, Seed::deriveSeed(3, 0, bar));
+        EXPECT_TRUE(out.getStep(0, 0).hasNote());
+        EXPECT_FALSE(out.getStep(2, 0).hasNote());
+        if (out.getStep(1, 8).hasNote()) ++snareHits;
+    }
+    EXPECT_NEAR(static_cast<double>(snareHits) / kBars, 0.25, 0.03);
+}
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/arena.h>
+#include <drumcore/drumgrid.h>
+#include <drumcore/fillengine.h>
+#include <drumcore/rtsafety.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+bool aligned(const void* p, size_t alignment) {
+    return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+// One generation pass: scratch candidate bars, fills and a pick list
+float generationPass(ScratchArena& arena, uint64_t seed) {
+    ScratchArena::Scope scope(arena);
+    std::pmr::vector<DrumBar> candidates(16, &arena);
+    std::pmr::vector<uint32_t> picks(&arena);
+    FillParams params;
+    params.length = FillLength::HalfBar;
+    float total = 0.0f;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        FillEngine::generate(candidates[i], params, Seed::deriveSeed(seed, 0, i), candidates[i]);
+        picks.push_back(candidates[i].noteMask(1));
+        total += candidates[i].steps[5][30].velocity;
+    }
+    return total + static_cast<float>(picks.size());
+}
+
+void ignoreViolation(RtSafety::Violation, const char*) {}
+
+}  // namespace
+
+TEST(ScratchArena, NoChunkUntilFirstAllocation) {
+    ScratchArena arena;
+    EXPECT_EQ(arena.metrics().capacity, 0u);
+    EXPECT_EQ(arena.metrics().upstreamAllocations, 0u);
+}
+
+TEST(ScratchArena, AllocationsAreAlignedAndDistinct) {
+    ScratchArena arena(1024);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(64, 64);
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(aligned(b, 8));
+    EXPECT_TRUE(aligned(c, 64));
+    EXPECT_GE(static_cast<char*>(c) - static_cast<char*>(b), 8);
+    EXPECT_EQ(arena.metrics().allocations, 3u);
+    EXPECT_GE(arena.metrics().bytesInUse, 75u);
+}
+
+TEST(ScratchArena, RewindReusesMemory) {
+    ScratchArena arena(4096);
+    (void)arena.allocate(100, 8);
+    const ScratchArena::Checkpoint mark = arena.checkpoint();
+    const size_t used = arena.metrics().bytesInUse;
+
+    void* first = arena.allocate(256, 16);
+    arena.rewind(mark);
+    EXPECT_EQ(arena.metrics().bytesInUse, used);
+    EXPECT_EQ(arena.allocate(256, 16), first);
+    EXPECT_EQ(arena.metrics().rewinds, 1u);
+}
+
+TEST(ScratchArena, GrowsAndKeepsChunksAcrossRewinds) {
+    ScratchArena arena(1024);
+    {
+        ScratchArena::Scope scope(arena);
+        for (int i = 0; i < 64; ++i) (void)arena.allocate(200, 8);
+    }
+    const uint64_t chunks = arena.metrics().upstreamAllocations;
+    EXPECT_GT(chunks, 1u);
+    EXPECT_EQ(arena.metrics().bytesInUse, 0u);
+    EXPECT_GE(arena.metrics().peakBytes, 64u * 200u);
+
+    {
+        ScratchArena::Scope scope(arena);
+        for (int i = 0; i < 64; ++i) (void)arena.allocate(200, 8);
+    }
+    EXPECT_EQ(arena.metrics().upstreamAllocations, chunks);
+}
+
+TEST(ScratchArena, OversizedRequestGetsItsOwnChunk) {
+    ScratchArena arena(1024);
+    (void)arena.allocate(16, 8);
+    void* big = arena.allocate(100000, 16);
+    ASSERT_NE(big, nullptr);
+    EXPECT_TRUE(aligned(big, 16));
+    EXPECT_GE(arena.metrics().capacity, 100000u);
+    arena.reset();
+    EXPECT_EQ(arena.metrics().bytesInUse, 0u);
+    arena.release();
+    EXPECT_EQ(arena.metrics().capacity, 0u);
+}
+
+TEST(ScratchArena, WorksWithPmrContainers) {
+    ScratchArena arena;
+    std::pmr::vector<DrumBar> bars(8, &arena);
+    bars[3].steps[0][0].velocity = 1.0f;
+    bars.resize(32);
+    EXPECT_FLOAT_EQ(bars[3].steps[0][0].velocity, 1.0f);
+    EXPECT_TRUE(aligned(bars.data(), alignof(DrumBar)));
+    EXPECT_GE(arena.metrics().bytesInUse, 40 * sizeof(DrumBar));
+}
+
+TEST(ScratchArena, ThreadScratchIsPerThread) {
+    ScratchArena* mine = &threadScratch();
+    EXPECT_EQ(&threadScratch(), mine);
+    ScratchArena* other = nullptr;
+    std::thread([&] { other = &threadScratch(); }).join();
+    EXPECT_NE(other, mine);
+}
+
+TEST(ScratchArena, RepeatedPassMakesNoUpstreamAllocations) {
+    ScratchArena arena;
+    const float first = generationPass(arena, 1);
+    const uint64_t chunks = arena.metrics().upstreamAllocations;
+    arena.resetMetrics();
+    EXPECT_EQ(generationPass(arena, 1), first);
+    EXPECT_EQ(arena.metrics().upstreamAllocations, 0u);
+    EXPECT_GT(arena.metrics().allocations, 0u);
+    EXPECT_EQ(chunks, 1u);
+}
+
+TEST(ScratchArena, WarmPassDoesNotTouchTheGlobalHeap) {
+    if (!RtSafety::enabled()) GTEST_SKIP() << "built without DRUMCORE_RT_CHECKS";
+    RtSafety::setHandler(ignoreViolation);
+    ScratchArena arena;
+    volatile float sink = 0.0f;
+
+    // Control: the cold pass must be seen fetching its chunk, so a zero
+    // below cannot come from the hooks missing the path or the pass being
+    // optimized away
+    RtSafety::resetCounts();
+    {
+        RtScope rt;
+        sink = generationPass(arena, 2);
+    }
+    ASSERT_GE(RtSafety::violationCount(RtSafety::Violation::Allocation), 1u);
+
+    RtSafety::resetCounts();
+    {
+        RtScope rt;
+        sink = generationPass(arena, 3);
+    }
+    (void)sink;
+    EXPECT_EQ(RtSafety::violationCount(RtSafety::Violation::Allocation), 0u);
+    EXPECT_EQ(RtSafety::violationCount(RtSafety::Violation::Deallocation), 0u);
+    RtSafety::setHandler(nullptr);
+}
+
+TEST(BoundedPool, ServesBlocksFromTheSlab) {
+    BoundedPool pool(40, 4);
+    EXPECT_EQ(pool.blockSize() % alignof(std::max_align_t), 0u);
+    void* a = pool.allocate(40, 8);
+    void* b = pool.allocate(16, 8);
+    EXPECT_TRUE(pool.owns(a));
+    EXPECT_TRUE(pool.owns(b));
+    EXPECT_EQ(pool.metrics().blocksInUse, 2u);
+
+    pool.deallocate(a, 40, 8);
+    EXPECT_EQ(pool.allocate(40, 8), a);
+    EXPECT_EQ(pool.metrics().peakBlocks, 2u);
+    EXPECT_EQ(pool.metrics().overflowAllocations, 0u);
+}
+
+TEST(BoundedPool, OverflowIsCounted) {
+    BoundedPool pool(32, 2);
+    void* a = pool.allocate(32, 8);
+    void* b = pool.allocate(32, 8);
+    void* c = pool.allocate(32, 8);   // exhausted
+    void* d = pool.allocate(512, 8);  // too large
+    EXPECT_FALSE(pool.owns(c));
+    EXPECT_FALSE(pool.owns(d));
+    EXPECT_EQ(pool.metrics().overflowAllocations, 2u);
+    EXPECT_EQ(pool.metrics().blocksInUse, 2u);
+    pool.deallocate(d, 512, 8);
+    pool.deallocate(c, 32, 8);
+    pool.deallocate(b, 32, 8);
+    pool.deallocate(a, 32, 8);
+    EXPECT_EQ(pool.metrics().blocksInUse, 0u);
+}
+
+TEST(BoundedPool, BacksPmrNodeContainers) {
+    BoundedPool pool(64, 32);
+    {
+        std::pmr::vector<int> values(&pool);
+        values.push_back(1);
+        values.push_back(2);
+        EXPECT_TRUE(pool.owns(values.data()));
+    }
+    EXPECT_EQ(pool.metrics().blocksInUse, 0u);
+}
@@ -0,0 +1,34 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/bitutils.h>
+#include <gtest/gtest.h>
+
+using namespace JKDigital;
+
+TEST(BitUtils, Popcount) {
+    EXPECT_EQ(BitUtils::popcount32(0u), 0);
+    EXPECT_EQ(BitUtils::popcount32(0xFFFFFFFFu), 32);
+    EXPECT_EQ(BitUtils::popcount32(0x01010101u), 4);
+}
+
+TEST(BitUtils, CountTrailingZeros) {
+    EXPECT_EQ(BitUtils::countTrailingZeros32(1u), 0);
+    EXPECT_EQ(BitUtils::countTrailingZeros32(0x80000000u), 31);
+    EXPECT_EQ(BitUtils::countTrailingZeros32(0x00000100u), 8);
+}
+
+TEST(BitUtils, HighestBit) {
+    EXPECT_EQ(BitUtils::highestBit64(1u), 0);
+    EXPECT_EQ(BitUtils::highestBit64(0x0000000100000000ull), 32);
+    EXPECT_EQ(BitUtils::highestBit64(0xFFFFFFFFFFFFFFFFull), 63);
+    EXPECT_EQ(BitUtils::highestBit64(1000u), 9);
+}
+
+TEST(BitUtils, LowMask) {
+    EXPECT_EQ(BitUtils::lowMask32(0), 0u);
+    EXPECT_EQ(BitUtils::lowMask32(24), 0x00FFFFFFu);
+    EXPECT_EQ(BitUtils::lowMask32(32), 0xFFFFFFFFu);
+}
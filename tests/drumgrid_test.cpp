@@ -229,3 +229,40 @@ TEST(DrumBar, CopyHitsFrom_PreservesFlags) {
     EXPECT_TRUE(dst.getStep(0, 0).isGhost());
     EXPECT_TRUE(dst.getStep(0, 0).isAccent());
 }
+
+TEST(DrumBar, HasNotes_ActiveMaskSkipsDeadColumns) {
+    DrumBar bar;
+    bar.getStep(0, 28).velocity = 0.9f;
+    EXPECT_TRUE(bar.hasNotes());
+    EXPECT_TRUE(bar.hasNotes(DrumBar::ALL_STEPS));
+    EXPECT_FALSE(bar.hasNotes(0x00FFFFFFu));
+}
+
+TEST(DrumBar, GateVelocity_ActiveMask) {
+    DrumBar bar;
+    bar.getStep(1, 4).velocity = 0.02f;
+    bar.getStep(1, 30).velocity = 0.02f;
+    bar.getStep(1, 8).velocity = 0.5f;
+    bar.gateVelocity(0.05f, 0x00FFFFFFu);
+    EXPECT_FALSE(bar.getStep(1, 4).hasNote());
+    EXPECT_TRUE(bar.getStep(1, 30).hasNote());
+    EXPECT_TRUE(bar.getStep(1, 8).hasNote());
+}
+
+TEST(DrumBar, CopyHitsFrom_ActiveMask) {
+    DrumBar src;
+    src.getStep(2, 0).velocity = 0.7f;
+    src.getStep(2, 31).velocity = 0.7f;
+    DrumBar dst;
+    dst.copyHitsFrom(src, 0x0FFFFFFFu);
+    EXPECT_TRUE(dst.getStep(2, 0).hasNote());
+    EXPECT_FALSE(dst.getStep(2, 31).hasNote());
+}
+
+TEST(DrumBar, NoteMask) {
+    DrumBar bar;
+    bar.getStep(3, 0).velocity = 0.5f;
+    bar.getStep(3, 31).velocity = 0.5f;
+    EXPECT_EQ(bar.noteMask(3), 0x80000001u);
+    EXPECT_EQ(bar.noteMask(0), 0u);
+}
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/fillengine.h>
+#include <gtest/gtest.h>
+
+using namespace JKDigital;
+
+namespace {
+
+// Rock groove: kick on 1 and 3, snare on 2 and 4, 8th-note hats
+DrumBar grooveBar() {
+    DrumBar bar;
+    for (int s = 0; s < 32; s += 16) bar.steps[0][s].velocity = 1.0f;
+    for (int s = 8; s < 32; s += 16) bar.steps[1][s].velocity = 0.9f;
+    for (int s = 0; s < 32; s += 4) bar.steps[2][s].velocity = 0.6f;
+    return bar;
+}
+
+// Note mask of the rows a fill may write (all but kick and crash)
+uint32_t fillRowsMask(const DrumBar& bar) {
+    uint32_t mask = 0;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        if (i != 0 && i != 7) mask |= bar.noteMask(i);
+    }
+    return mask;
+}
+
+}  // namespace
+
+TEST(FillEngine, CandidateMasks) {
+    DrumBar bar = grooveBar();
+    bar.steps[1][28].setFillCandidate(true);
+    bar.steps[5][30].setFillCandidate(true);
+    const FillCandidates c = FillEngine::findCandidates(bar);
+    EXPECT_EQ(c.rows[1], 1u << 28);
+    EXPECT_EQ(c.rows[5], 1u << 30);
+    EXPECT_EQ(c.any, (1u << 28) | (1u << 30));
+    EXPECT_EQ(c.beats, 0x01010101u);
+}
+
+TEST(FillEngine, WindowsFollowTheMeter) {
+    const DrumBar bar;
+    const FillCandidates four = FillEngine::findCandidates(bar, TimeSignature::k4_4);
+    EXPECT_EQ(four.window[0], 0xFF000000u);
+    EXPECT_EQ(four.window[1], 0xFFFF0000u);
+    EXPECT_EQ(four.window[2], 0xFFFFFFFFu);
+
+    // 7/8: seven 4-step beats, 28 active steps
+    const FillCandidates seven = FillEngine::findCandidates(bar, TimeSignature::k7_8);
+    EXPECT_EQ(seven.window[0], 0x0F000000u);
+    EXPECT_EQ(seven.window[1], 0x0FFFF000u);
+    EXPECT_EQ(seven.window[2], 0x0FFFFFFFu);
+}
+
+TEST(FillEngine, WritesOnlyInsideTheWindow) {
+    const DrumBar source = grooveBar();
+    DrumBar out;
+    FillParams params;
+    params.length = FillLength::LastBeat;
+    params.density = 1.0f;
+    FillEngine::generate(source, params, 1234, out);
+
+    EXPECT_EQ(out.role, DrumBar::Role::Fill);
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        EXPECT_EQ(out.noteMask(i) & 0x00FFFFFFu, source.noteMask(i) & 0x00FFFFFFu) << i;
+    }
+    // Hats replaced in the window; kick untouched
+    EXPECT_EQ(out.noteMask(2) & 0xFF000000u, 0u);
+    EXPECT_EQ(out.noteMask(0), source.noteMask(0));
+    // Full density hits every 16th slot of the last beat
+    EXPECT_EQ(fillRowsMask(out) & 0x55000000u, 0x55000000u);
+}
+
+TEST(FillEngine, ZeroDensityStillLeadsIntoTheDownbeat) {
+    DrumBar out;
+    FillParams params;
+    params.length = FillLength::HalfBar;
+    params.density = 0.0f;
+    FillEngine::generate(grooveBar(), params, 99, out);
+    EXPECT_EQ(fillRowsMask(out) & 0xFFFF0000u, 1u << 30);
+    EXPECT_TRUE(out.steps[5][30].isAccent());  // Rock ends on the low tom
+}
+
+TEST(FillEngine, IsDeterministicPerSeed) {
+    const DrumBar source = grooveBar();
+    FillParams params;
+    params.length = FillLength::FullBar;
+    params.density = 0.5f;
+
+    DrumBar a, b, c;
+    FillEngine::generate(source, params, Seed::deriveSeed(7, 3, 1), a);
+    FillEngine::generate(source, params, Seed::deriveSeed(7, 3, 1), b);
+    FillEngine::generate(source, params, Seed::deriveSeed(8, 3, 1), c);
+
+    bool differs = false;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            EXPECT_EQ(a.steps[i][s].velocity, b.steps[i][s].velocity);
+            EXPECT_EQ(a.steps[i][s].flags, b.steps[i][s].flags);
+            differs |= a.steps[i][s].velocity != c.steps[i][s].velocity;
+        }
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(FillEngine, PrefersCandidateSteps) {
+    DrumBar source = grooveBar();
+    for (int s = 16; s < 32; s += 4) source.steps[1][s].setFillCandidate(true);
+    const FillCandidates candidates = FillEngine::findCandidates(source);
+    const FillVoicing voicing = FillEngine::genreVoicing(DrumBar::Genre::Rock);
+    FillParams params;
+    params.length = FillLength::HalfBar;
+    params.density = 0.5f;
+
+    int candidateHits = 0, otherHits = 0;
+    for (uint64_t seed = 0; seed < 400; ++seed) {
+        DrumBar out;
+        FillEngine::generate(source, candidates, params, voicing, seed, out);
+        const uint32_t hits = fillRowsMask(out) & 0x3FFF0000u;  // exclude the forced last slot
+        candidateHits += BitUtils::popcount32(hits & candidates.any);
+        otherHits += BitUtils::popcount32(hits & 0x55555555u & ~candidates.any);
+    }
+    // 3 candidate slots at p = 0.5 vs 4 other 16th slots at p = 0.25
+    EXPECT_GT(candidateHits, otherHits);
+}
+
+TEST(FillEngine, GenreVoicing) {
+    DrumBar source = grooveBar();
+    source.genre = DrumBar::Genre::Latin;
+    FillParams params;
+    params.length = FillLength::FullBar;
+    params.density = 1.0f;
+    DrumBar out;
+    FillEngine::generate(source, params, 5, out);
+    EXPECT_NE(out.noteMask(4), 0u);  // Latin opens on the rim
+    EXPECT_EQ(out.noteMask(2), 0u);
+
+    EXPECT_FALSE(FillEngine::genreVoicing(DrumBar::Genre::HipHop).landingCrash);
+    EXPECT_EQ(FillEngine::genreVoicing(static_cast<DrumBar::Genre>(42)).voices[0],
+              FillEngine::genreVoicing(DrumBar::Genre::Rock).voices[0]);
+}
+
+TEST(FillEngine, InPlaceMatchesCopy) {
+    const DrumBar source = grooveBar();
+    const FillCandidates candidates = FillEngine::findCandidates(source);
+    const FillVoicing voicing = FillEngine::genreVoicing(DrumBar::Genre::Funk);
+    FillParams params;
+    params.length = FillLength::HalfBar;
+
+    DrumBar copy, inPlace = source;
+    FillEngine::generate(source, candidates, params, voicing, 77, copy);
+    FillEngine::generate(inPlace, candidates, params, voicing, 77, inPlace);
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        EXPECT_EQ(copy.noteMask(i), inPlace.noteMask(i));
+    }
+}
+
+TEST(FillEngine, LandingAddsCrashAndKick) {
+    DrumBar next;
+    FillEngine::land(next, FillEngine::genreVoicing(DrumBar::Genre::Rock), 0.9f);
+    EXPECT_FLOAT_EQ(next.steps[7][0].velocity, 0.9f);
+    EXPECT_TRUE(next.steps[7][0].isAccent());
+    EXPECT_FLOAT_EQ(next.steps[0][0].velocity, 0.9f);
+
+    DrumBar quiet;
+    FillEngine::land(quiet, FillEngine::genreVoicing(DrumBar::Genre::HipHop));
+    EXPECT_FALSE(quiet.hasNotes());
+}
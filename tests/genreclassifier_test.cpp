@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/genreclassifier.h>
+#include <gtest/gtest.h>
+
+#include "testbars.h"
+
+using namespace JKDigital;
+
+namespace {
+
+// Swung ride pattern with light snare comping and feathered kick
+DrumBar makeJazzBar() {
+    DrumBar bar;
+    const int ride[] = {0, 8, 14, 16, 24, 30};
+    for (int s : ride) bar.steps[8][s].velocity = 0.75f;
+    bar.steps[2][8].velocity = 0.6f;
+    bar.steps[2][24].velocity = 0.6f;
+    bar.steps[1][14].velocity = 0.35f;
+    bar.steps[1][22].velocity = 0.45f;
+    bar.steps[0][0].velocity = 0.3f;
+    bar.steps[0][20].velocity = 0.4f;
+    return bar;
+}
+
+}  // namespace
+
+TEST(GenreClassifier, EmptyBarIsUncertain) {
+    GenreClassifier classifier;
+    const GenreClassifier::Result r = classifier.classify(DrumBar());
+    EXPECT_EQ(r.genre, DrumBar::Genre::Uncertain);
+    EXPECT_FLOAT_EQ(r.confidence, 0.0f);
+}
+
+TEST(GenreClassifier, ClassifiesRockBeat) {
+    GenreClassifier classifier;
+    const GenreClassifier::Result r = classifier.classify(TestBars::rock());
+    EXPECT_EQ(r.genre, DrumBar::Genre::Rock);
+    EXPECT_GT(r.confidence, GenreClassifier::kDefaultMinConfidence);
+    EXPECT_LE(r.confidence, 1.0f);
+}
+
+TEST(GenreClassifier, ClassifiesJazzRide) {
+    GenreClassifier classifier;
+    EXPECT_EQ(classifier.classify(makeJazzBar()).genre, DrumBar::Genre::Jazz);
+}
+
+TEST(GenreClassifier, LowConfidenceIsUncertain) {
+    GenreClassifier classifier;
+    classifier.setMinConfidence(1.01f);
+    const GenreClassifier::Result r = classifier.classify(TestBars::rock());
+    EXPECT_EQ(r.genre, DrumBar::Genre::Uncertain);
+    EXPECT_GT(r.confidence, 0.0f);
+}
+
+TEST(GenreClassifier, CustomWeights) {
+    float weights[GenreClassifier::NUM_CLASSES][GenreClassifier::NUM_FEATURES] = {};
+    float bias[GenreClassifier::NUM_CLASSES] = {};
+    bias[static_cast<int>(DrumBar::Genre::Funk)] = 10.0f;
+    GenreClassifier classifier;
+    classifier.setWeights(weights, bias);
+    EXPECT_EQ(classifier.classify(TestBars::rock()).genre, DrumBar::Genre::Funk);
+}
+
+TEST(GenreClassifier, BatchMatchesSingle) {
+    GenreClassifier classifier;
+    const DrumBar bars[] = {TestBars::rock(), makeJazzBar(), DrumBar()};
+    GenreClassifier::Result results[3];
+    classifier.classifyBatch(bars, 3, results);
+    for (int b = 0; b < 3; ++b) {
+        const GenreClassifier::Result single = classifier.classify(bars[b]);
+        EXPECT_EQ(results[b].genre, single.genre);
+        EXPECT_FLOAT_EQ(results[b].confidence, single.confidence);
+    }
+}
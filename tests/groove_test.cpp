@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/groove.h>
+#include <gtest/gtest.h>
+
+using namespace JKDigital;
+
+namespace {
+
+DrumBar makeHats() {
+    DrumBar bar;
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 2) bar.getStep(2, s).velocity = 0.6f;
+    return bar;
+}
+
+}  // namespace
+
+TEST(Groove, StepDuration) {
+    // 120 BPM: quarter = 500ms, 32nd = 62.5ms
+    EXPECT_FLOAT_EQ(GrooveTemplate::stepDurationMs(120.0), 62.5f);
+}
+
+TEST(Groove, Straight_FollowsTimeSignature) {
+    EXPECT_EQ(GrooveTemplate::straight(TimeSignature::k3_4).activeSteps, 24);
+    EXPECT_EQ(GrooveTemplate::straight(TimeSignature::k4_4).activeSteps, 32);
+}
+
+TEST(Groove, Swing_DelaysSixteenthOffbeats) {
+    const GrooveTemplate swing = GrooveTemplate::swing(1.0f, TimeSignature::k4_4);
+    EXPECT_EQ(swing.unit, GrooveUnit::StepFraction);
+    EXPECT_FLOAT_EQ(swing.timing[0], 0.0f);
+    EXPECT_FLOAT_EQ(swing.timing[2], 4.0f / 6.0f);
+    EXPECT_FLOAT_EQ(swing.timing[4], 0.0f);
+    EXPECT_FLOAT_EQ(swing.timing[30], 4.0f / 6.0f);
+}
+
+TEST(Groove, Swing_EighthResolutionRespectsActiveSteps) {
+    const GrooveTemplate swing =
+        GrooveTemplate::swing(0.5f, TimeSignature::k3_4, SwingResolution::Eighth);
+    EXPECT_FLOAT_EQ(swing.timing[4], 0.5f * 8.0f / 6.0f);
+    EXPECT_FLOAT_EQ(swing.timing[2], 0.0f);
+    EXPECT_FLOAT_EQ(swing.timing[28], 0.0f);
+}
+
+TEST(Groove, Apply_TempoAwareAndMasked) {
+    DrumBar bar = makeHats();
+    const GrooveTemplate swing = GrooveTemplate::swing(0.3f, TimeSignature::k4_4);
+    Groove::apply(bar, swing, 120.0);
+    // 0.3 * 4/6 steps * 62.5ms = 12.5ms
+    EXPECT_NEAR(bar.getStep(2, 2).timingOffsetMs, 12.5f, 1e-4f);
+    EXPECT_FLOAT_EQ(bar.getStep(2, 0).timingOffsetMs, 0.0f);
+    EXPECT_FLOAT_EQ(bar.getStep(0, 2).timingOffsetMs, 0.0f);
+    EXPECT_FALSE(bar.getStep(0, 2).hasNote());
+}
+
+TEST(Groove, Apply_ClampsToTimingLimits) {
+    DrumBar bar = makeHats();
+    Groove::apply(bar, GrooveTemplate::swing(1.0f, TimeSignature::k4_4), 60.0);
+    EXPECT_FLOAT_EQ(bar.getStep(2, 2).timingOffsetMs, Constants::kMaxTimingOffsetMs);
+}
+
+TEST(Groove, Apply_VelocityScaleAndAmount) {
+    DrumBar bar = makeHats();
+    const GrooveTemplate groove =
+        GrooveTemplate::swing(0.0f, TimeSignature::k4_4, SwingResolution::Sixteenth, 0.5f);
+    Groove::apply(bar, groove, 120.0, 0.5f);
+    EXPECT_FLOAT_EQ(bar.getStep(2, 2).velocity, 0.6f * 0.75f);
+    EXPECT_FLOAT_EQ(bar.getStep(2, 4).velocity, 0.6f);
+}
+
+TEST(Groove, Apply_PatternMatchesPerBar) {
+    DrumBar pattern[3] = {makeHats(), makeHats(), makeHats()};
+    DrumBar single = makeHats();
+    const GrooveTemplate swing = GrooveTemplate::swing(0.6f, TimeSignature::k4_4);
+    Groove::apply(pattern, 3, swing, 96.0);
+    Groove::apply(single, swing, 96.0);
+    for (int b = 0; b < 3; ++b) {
+        EXPECT_FLOAT_EQ(pattern[b].getStep(2, 6).timingOffsetMs,
+                        single.getStep(2, 6).timingOffsetMs);
+    }
+}
+
+TEST(Groove, Blend_InterpolatesSwing) {
+    const GrooveTemplate straight = GrooveTemplate::straight(TimeSignature::k4_4);
+    const GrooveTemplate full = GrooveTemplate::swing(1.0f, TimeSignature::k4_4);
+    const GrooveTemplate half = GrooveTemplate::blend(straight, full, 0.5f);
+    EXPECT_FLOAT_EQ(half.timing[2], GrooveTemplate::swing(0.5f, TimeSignature::k4_4).timing[2]);
+}
+
+TEST(Groove, Blend_ConvertsUnits) {
+    GrooveTemplate ms = GrooveTemplate::straight(TimeSignature::k4_4);
+    ms.unit = GrooveUnit::Milliseconds;
+    const GrooveTemplate steps = GrooveTemplate::swing(1.0f, TimeSignature::k4_4);
+    const GrooveTemplate out = GrooveTemplate::blend(ms, steps, 1.0f, 120.0);
+    EXPECT_EQ(out.unit, GrooveUnit::Milliseconds);
+    EXPECT_NEAR(out.timing[2], 4.0f / 6.0f * 62.5f, 1e-3f);
+}
+
+TEST(Groove, Extract_RoundTrip) {
+    DrumBar bars[4] = {makeHats(), makeHats(), makeHats(), makeHats()};
+    const GrooveTemplate swing =
+        GrooveTemplate::swing(0.5f, TimeSignature::k4_4, SwingResolution::Sixteenth, 0.8f);
+    Groove::apply(bars, 4, swing, 140.0);
+
+    const GrooveTemplate extracted = Groove::extract(bars, 4, 140.0, TimeSignature::k4_4);
+    EXPECT_EQ(extracted.unit, GrooveUnit::StepFraction);
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 2) {
+        EXPECT_NEAR(extracted.timing[s], swing.timing[s], 1e-4f);
+    }
+    // Off-beats at 0.8x relative to on-beats
+    EXPECT_NEAR(extracted.velocityScale[2] / extracted.velocityScale[0], 0.8f, 1e-4f);
+}
+
+TEST(Groove, Extract_EmptyBarsNeutral) {
+    DrumBar empty;
+    const GrooveTemplate groove = Groove::extract(&empty, 1, 120.0, TimeSignature::k6_8);
+    EXPECT_EQ(groove.activeSteps, 24);
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+        EXPECT_FLOAT_EQ(groove.timing[s], 0.0f);
+        EXPECT_FLOAT_EQ(groove.velocityScale[s], 1.0f);
+    }
+}
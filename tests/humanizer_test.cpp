@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/constants.h>
+#include <drumcore/humanizer.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace JKDigital;
+
+namespace {
+
+DrumBar makeGroove() {
+    DrumBar bar;
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 4) {
+        bar.getStep(2, s).velocity = 0.7f;
+    }
+    bar.getStep(0, 0).velocity = 0.9f;
+    bar.getStep(0, 16).velocity = 0.9f;
+    bar.getStep(1, 8) = DrumStep(1.0f, 0.0f, DrumStep::FLAG_ACCENT);
+    bar.getStep(1, 24).velocity = 0.8f;
+    bar.getStep(1, 14) = DrumStep(0.2f, 0.0f, DrumStep::FLAG_GHOST);
+    return bar;
+}
+
+bool stepsEqual(const DrumBar& a, const DrumBar& b) {
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const DrumStep& x = a.getStep(i, s);
+            const DrumStep& y = b.getStep(i, s);
+            if (x.velocity != y.velocity || x.timingOffsetMs != y.timingOffsetMs ||
+                x.flags != y.flags) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(Humanizer, Deterministic) {
+    DrumBar a = makeGroove();
+    DrumBar b = makeGroove();
+    const HumanizeProfile profile = Humanizer::genreProfile(DrumBar::Genre::Jazz);
+    Humanizer::humanizeBar(a, profile, 1234, 2, 5);
+    Humanizer::humanizeBar(b, profile, 1234, 2, 5);
+    EXPECT_TRUE(stepsEqual(a, b));
+}
+
+TEST(Humanizer, DifferentBarIndex_DifferentResult) {
+    DrumBar a = makeGroove();
+    DrumBar b = makeGroove();
+    const HumanizeProfile profile = HumanizeProfile::uniform(0.1f, 5.0f);
+    Humanizer::humanizeBar(a, profile, 1234, 0, 0);
+    Humanizer::humanizeBar(b, profile, 1234, 0, 1);
+    EXPECT_NE(a.getStep(2, 4).timingOffsetMs, b.getStep(2, 4).timingOffsetMs);
+}
+
+TEST(Humanizer, SilentStepsUntouched) {
+    DrumBar bar = makeGroove();
+    Humanizer::humanizeBar(bar, HumanizeProfile::uniform(0.5f, 20.0f), 99, 0, 0);
+    EXPECT_FALSE(bar.getStep(0, 1).hasNote());
+    EXPECT_FLOAT_EQ(bar.getStep(0, 1).timingOffsetMs, 0.0f);
+    EXPECT_FLOAT_EQ(bar.getStep(9, 31).timingOffsetMs, 0.0f);
+}
+
+TEST(Humanizer, ZeroAmount_NoChange) {
+    DrumBar a = makeGroove();
+    DrumBar b = makeGroove();
+    HumanizeProfile profile = Humanizer::genreProfile(DrumBar::Genre::Funk);
+    Humanizer::humanizeBar(a, profile, 7, 0, 3, 0.0f);
+    EXPECT_TRUE(stepsEqual(a, b));
+}
+
+TEST(Humanizer, ClampsToLimits) {
+    HumanizeProfile profile = HumanizeProfile::uniform(2.0f, 100.0f);
+    profile.distribution = JitterDistribution::Uniform;
+    profile.driftAmountMs = 50.0f;
+    for (uint32_t barIndex = 0; barIndex < 16; ++barIndex) {
+        DrumBar bar = makeGroove();
+        Humanizer::humanizeBar(bar, profile, 31337, 0, barIndex);
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                const DrumStep& step = bar.getStep(i, s);
+                EXPECT_GE(step.velocity, 0.0f);
+                EXPECT_LE(step.velocity, 1.0f);
+                EXPECT_GE(step.timingOffsetMs, Constants::kMinTimingOffsetMs);
+                EXPECT_LE(step.timingOffsetMs, Constants::kMaxTimingOffsetMs);
+            }
+        }
+        EXPECT_TRUE(bar.getStep(0, 0).hasNote());
+    }
+}
+
+TEST(Humanizer, Jitter_DistributionsWithinBounds) {
+    const uint64_t seed = Seed::deriveSeed(5, 0, 0);
+    for (uint32_t s = 0; s < 2000; ++s) {
+        const float u = Humanizer::jitter(seed, 0, s, 0, JitterDistribution::Uniform);
+        const float t = Humanizer::jitter(seed, 0, s, 0, JitterDistribution::Triangular);
+        const float g = Humanizer::jitter(seed, 0, s, 0, JitterDistribution::Gaussian);
+        EXPECT_GE(u, -1.0f);
+        EXPECT_LT(u, 1.0f);
+        EXPECT_GE(t, -1.0f);
+        EXPECT_LT(t, 1.0f);
+        EXPECT_LT(std::fabs(g), 1.74f);
+    }
+}
+
+TEST(Humanizer, Jitter_GaussianSpread) {
+    const uint64_t seed = Seed::deriveSeed(11, 0, 0);
+    double sum = 0.0;
+    double sumSq = 0.0;
+    constexpr int kCount = 20000;
+    for (uint32_t s = 0; s < kCount; ++s) {
+        const double g = Humanizer::jitter(seed, 1, s, 0, JitterDistribution::Gaussian);
+        sum += g;
+        sumSq += g * g;
+    }
+    const double mean = sum / kCount;
+    const double stddev = std::sqrt(sumSq / kCount - mean * mean);
+    EXPECT_NEAR(mean, 0.0, 0.02);
+    EXPECT_NEAR(stddev, 0.5, 0.02);
+}
+
+TEST(Humanizer, GhostNotesJitterLessInVelocity) {
+    HumanizeProfile profile = HumanizeProfile::uniform(0.2f, 0.0f);
+    profile.ghostVelocityScale = 0.0f;
+    DrumBar bar = makeGroove();
+    Humanizer::humanizeBar(bar, profile, 3, 0, 0);
+    EXPECT_FLOAT_EQ(bar.getStep(1, 14).velocity, 0.2f);
+    EXPECT_NE(bar.getStep(1, 24).velocity, 0.8f);
+}
+
+TEST(Humanizer, PhraseDrift_ContinuousAcrossBarLines) {
+    HumanizeProfile profile = HumanizeProfile::uniform(0.0f, 0.0f);
+    profile.driftAmountMs = 10.0f;
+    profile.driftPhraseBars = 4;
+    for (uint32_t bar = 0; bar < 12; ++bar) {
+        const float end = Humanizer::phraseDrift(profile, 77, 1, bar, DrumBar::STEPS_PER_BAR);
+        const float next = Humanizer::phraseDrift(profile, 77, 1, bar + 1, 0);
+        EXPECT_NEAR(end, next, 1e-4f);
+    }
+}
+
+TEST(Humanizer, PatternMatchesPerBar) {
+    const HumanizeProfile profile = Humanizer::genreProfile(DrumBar::Genre::NewOrleans);
+    DrumBar pattern[4];
+    DrumBar single[4];
+    for (int b = 0; b < 4; ++b) {
+        pattern[b] = makeGroove();
+        single[b] = makeGroove();
+    }
+    Humanizer::humanizePattern(pattern, 4, profile, 42, 1, 8);
+    for (int b = 3; b >= 0; --b) {
+        Humanizer::humanizeBar(single[b], profile, 42, 1, 8 + static_cast<uint32_t>(b));
+        EXPECT_TRUE(stepsEqual(pattern[b], single[b]));
+    }
+}
+
+TEST(Humanizer, GenreProfile_HipHopSnareLaidBack) {
+    const HumanizeProfile hiphop = Humanizer::genreProfile(DrumBar::Genre::HipHop);
+    const HumanizeProfile rock = Humanizer::genreProfile(DrumBar::Genre::Rock);
+    EXPECT_GT(hiphop.instruments[1].timingBiasMs, rock.instruments[1].timingBiasMs);
+}
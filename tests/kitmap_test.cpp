@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/kitmap.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+using namespace JKDigital;
+
+TEST(KitMap, GeneralMidiMatchesGMDrumMap) {
+    const KitMap kit = KitMap::generalMidi();
+    for (int i = 0; i < KitMap::NUM_INSTRUMENTS; ++i) {
+        EXPECT_EQ(kit.note(i), GMDrumMap::getNote(i));
+        EXPECT_EQ(kit.instrumentFor(GMDrumMap::getNote(i)), i);
+    }
+}
+
+TEST(KitMap, InputAliases) {
+    const KitMap kit = KitMap::generalMidi();
+    EXPECT_EQ(kit.instrumentFor(40), 1);  // Electric Snare
+    EXPECT_EQ(kit.instrumentFor(44), 2);  // Pedal Hi-Hat
+    EXPECT_EQ(kit.instrumentFor(60), KitMap::kNoNote);
+    EXPECT_EQ(kit.instrumentFor(-1), KitMap::kNoNote);
+    EXPECT_EQ(kit.instrumentFor(128), KitMap::kNoNote);
+}
+
+TEST(KitMap, EmptyMapHasNoNotes) {
+    KitMap kit;
+    EXPECT_EQ(kit.note(0), KitMap::kNoNote);
+    EXPECT_EQ(kit.note(-1), KitMap::kNoNote);
+    EXPECT_EQ(kit.instrumentFor(36), KitMap::kNoNote);
+}
+
+TEST(KitMap, ArticulationNotes) {
+    KitMap kit = KitMap::generalMidi();
+    EXPECT_TRUE(kit.setArticulationNote(1, KitMap::Articulation::Ghost, 40));
+    EXPECT_TRUE(kit.setArticulationNote(1, KitMap::Articulation::Accent, 39));
+
+    EXPECT_EQ(kit.noteForFlags(1, 0), 38);
+    EXPECT_EQ(kit.noteForFlags(1, DrumStep::FLAG_GHOST), 40);
+    EXPECT_EQ(kit.noteForFlags(1, DrumStep::FLAG_ACCENT), 39);
+    EXPECT_EQ(kit.noteForFlags(1, DrumStep::FLAG_ACCENT | DrumStep::FLAG_GHOST), 39);
+    // Unset articulations fall back to the base note
+    EXPECT_EQ(kit.noteForFlags(1, DrumStep::FLAG_FILL_CANDIDATE), 38);
+    EXPECT_EQ(kit.noteForFlags(0, DrumStep::FLAG_GHOST), 36);
+    EXPECT_EQ(kit.instrumentFor(39), 1);
+}
+
+TEST(KitMap, ReassignedNotesStopMappingForInput) {
+    KitMap kit = KitMap::generalMidi();
+    EXPECT_TRUE(kit.setNote(1, 61));
+    EXPECT_EQ(kit.instrumentFor(61), 1);
+    EXPECT_EQ(kit.instrumentFor(38), KitMap::kNoNote);
+
+    // Notes registered with addInputNote survive reassignment
+    EXPECT_TRUE(kit.setNote(1, 40));
+    EXPECT_TRUE(kit.setNote(1, 38));
+    EXPECT_EQ(kit.instrumentFor(40), 1);
+    EXPECT_EQ(kit.instrumentFor(61), KitMap::kNoNote);
+
+    // A note still played by another slot maps back to it
+    EXPECT_TRUE(kit.setArticulationNote(2, KitMap::Articulation::Accent, 46));
+    EXPECT_EQ(kit.instrumentFor(46), 2);
+    EXPECT_TRUE(kit.setArticulationNote(2, KitMap::Articulation::Accent, KitMap::kNoNote));
+    EXPECT_EQ(kit.instrumentFor(46), 3);
+
+    kit.removeInputNote(40);
+    EXPECT_TRUE(kit.setArticulationNote(1, KitMap::Articulation::Ghost, 40));
+    EXPECT_TRUE(kit.setArticulationNote(1, KitMap::Articulation::Ghost, 62));
+    EXPECT_EQ(kit.instrumentFor(40), KitMap::kNoNote);
+}
+
+TEST(KitMap, RejectsOutOfRange) {
+    KitMap kit;
+    EXPECT_FALSE(kit.setNote(10, 36));
+    EXPECT_FALSE(kit.setNote(0, 128));
+    EXPECT_FALSE(kit.addInputNote(-2, 0));
+    EXPECT_FALSE(kit.addInputNote(36, 10));
+}
+
+TEST(KitMap, NonGmKit) {
+    KitMap kit;
+    for (int i = 0; i < KitMap::NUM_INSTRUMENTS; ++i) kit.setNote(i, 60 + i);
+    EXPECT_EQ(kit.note(3), 63);
+    EXPECT_EQ(kit.instrumentFor(69), 9);
+    EXPECT_EQ(kit.instrumentFor(36), KitMap::kNoNote);
+}
+
+TEST(KitMap, ConvertBar) {
+    KitMap kit = KitMap::generalMidi();
+    kit.setArticulationNote(2, KitMap::Articulation::Accent, 46);
+    DrumBar bar;
+    bar.steps[0][0].velocity = 1.0f;
+    bar.steps[2][4] = DrumStep(0.8f, 0.0f, DrumStep::FLAG_ACCENT);
+    int8_t notes[KitMap::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    kit.convertBar(bar, notes);
+    EXPECT_EQ(notes[0][0], 36);
+    EXPECT_EQ(notes[2][4], 46);
+    EXPECT_EQ(notes[0][1], KitMap::kNoNote);
+}
+
+TEST(VelocityCurve, LinearCloseToToMidiVelocity) {
+    const VelocityCurve curve = VelocityCurve::linear();
+    for (int i = 1; i <= 100; ++i) {
+        const float v = static_cast<float>(i) / 100.0f;
+        EXPECT_LE(std::abs(curve.toMidi(v) - GMDrumMap::toMidiVelocity(v)), 1) << v;
+    }
+    EXPECT_EQ(curve.toMidi(1.0f), 127);
+}
+
+TEST(VelocityCurve, SilentIsZeroAudibleIsAtLeastOne) {
+    const VelocityCurve curve = VelocityCurve::exponential(3.0f);
+    EXPECT_EQ(curve.toMidi(0.0f), 0);
+    EXPECT_EQ(curve.toMidi(-0.5f), 0);
+    EXPECT_EQ(curve.toMidi(0.0001f), 1);
+    EXPECT_EQ(curve.toMidi(0.0001f, DrumStep::FLAG_GHOST), 1);
+    EXPECT_EQ(curve.toMidi(2.0f), 127);
+}
+
+TEST(VelocityCurve, GhostAndAccentScaling) {
+    const VelocityCurve curve = VelocityCurve::linear();
+    const int normal = curve.toMidi(0.5f);
+    const int ghost = curve.toMidi(0.5f, DrumStep::FLAG_GHOST);
+    const int accent = curve.toMidi(0.5f, DrumStep::FLAG_ACCENT);
+    EXPECT_NEAR(ghost, normal * Constants::kGhostVelocityMultiplier, 1.0);
+    EXPECT_NEAR(accent, normal * Constants::kAccentVelocityMultiplier, 1.0);
+    // Accent clamps at full scale
+    EXPECT_EQ(curve.toMidi(0.95f, DrumStep::FLAG_ACCENT), 127);
+}
+
+TEST(VelocityCurve, ExponentialIsMonotonicAndSofter) {
+    const VelocityCurve curve = VelocityCurve::exponential(2.0f);
+    const VelocityCurve lin = VelocityCurve::linear();
+    for (int i = 2; i < VelocityCurve::LUT_SIZE; ++i) {
+        EXPECT_GE(curve.table(VelocityCurve::kNormal)[i],
+                  curve.table(VelocityCurve::kNormal)[i - 1]);
+    }
+    EXPECT_LT(curve.toMidi(0.5f), lin.toMidi(0.5f));
+}
+
+TEST(VelocityCurve, CustomCurve) {
+    const VelocityCurve curve = VelocityCurve::custom([](float) { return 0.5f; });
+    EXPECT_EQ(curve.toMidi(0.1f), 64);
+    EXPECT_EQ(curve.toMidi(0.9f), 64);
+    EXPECT_EQ(curve.toMidi(0.0f), 0);
+}
+
+TEST(VelocityCurve, ConvertBarMatchesScalar) {
+    const VelocityCurve curve = VelocityCurve::exponential(1.5f);
+    DrumBar bar;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const int k = i * DrumBar::STEPS_PER_BAR + s;
+            bar.steps[i][s].velocity = (k % 3 == 0) ? 0.0f : static_cast<float>(k % 97) / 96.0f;
+            bar.steps[i][s].flags = static_cast<uint8_t>(k % 8);
+        }
+    }
+    bar.steps[4][5].velocity = 0.0001f;
+    uint8_t out[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    curve.convertBar(bar, out);
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            EXPECT_EQ(out[i][s], curve.toMidi(bar.steps[i][s])) << i << "," << s;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/markovgenerator.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+DrumBar makeRockBar() {
+    DrumBar bar;
+    bar.genre = DrumBar::Genre::Rock;
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 4) bar.getStep(2, s).velocity = 0.7f;
+    bar.getStep(0, 0).velocity = 0.9f;
+    bar.getStep(0, 16).velocity = 0.9f;
+    bar.getStep(1, 8).velocity = 1.0f;
+    bar.getStep(1, 24).velocity = 1.0f;
+    bar.getStep(1, 14) = DrumStep(0.2f, 0.0f, DrumStep::FLAG_GHOST);
+    return bar;
+}
+
+MarkovPatternModel trainRock() {
+    MarkovTrainer trainer;
+    const DrumBar bar = makeRockBar();
+    for (int k = 0; k < 10; ++k) trainer.addBar(bar);
+    MarkovPatternModel model;
+    trainer.build(model);
+    return model;
+}
+
+bool sameBars(const DrumBar& a, const DrumBar& b) {
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            if (a.getStep(i, s).velocity != b.getStep(i, s).velocity ||
+                a.getStep(i, s).flags != b.getStep(i, s).flags) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(MarkovGenerator, Quantize) {
+    EXPECT_EQ(MarkovPatternModel::quantize(DrumStep()), MarkovPatternModel::STATE_REST);
+    EXPECT_EQ(MarkovPatternModel::quantize(DrumStep(0.2f, 0.0f, 0)),
+              MarkovPatternModel::STATE_SOFT);
+    EXPECT_EQ(MarkovPatternModel::quantize(DrumStep(0.6f, 0.0f, 0)),
+              MarkovPatternModel::STATE_MEDIUM);
+    EXPECT_EQ(MarkovPatternModel::quantize(DrumStep(0.9f, 0.0f, 0)),
+              MarkovPatternModel::STATE_LOUD);
+    EXPECT_EQ(MarkovPatternModel::quantize(DrumStep(0.9f, 0.0f, DrumStep::FLAG_GHOST)),
+              MarkovPatternModel::STATE_SOFT);
+}
+
+TEST(MarkovGenerator, UntrainedGenre_ReturnsFalse) {
+    MarkovPatternModel model;
+    DrumBar out;
+    EXPECT_FALSE(model.generate(out, DrumBar::Genre::Jazz, 1));
+    EXPECT_FALSE(out.hasNotes());
+}
+
+TEST(MarkovGenerator, SinglePatternCorpus_Reproduced) {
+    const MarkovPatternModel model = trainRock();
+    ASSERT_TRUE(model.hasGenre(DrumBar::Genre::Rock));
+    EXPECT_FALSE(model.hasGenre(DrumBar::Genre::Funk));
+
+    const DrumBar source = makeRockBar();
+    for (uint32_t bar = 0; bar < 20; ++bar) {
+        DrumBar out;
+        ASSERT_TRUE(model.generate(out, DrumBar::Genre::Rock, Seed::deriveSeed(9, 0, bar)));
+        EXPECT_EQ(out.genre, DrumBar::Genre::Rock);
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                EXPECT_EQ(out.getStep(i, s).hasNote(), source.getStep(i, s).hasNote());
+            }
+        }
+        EXPECT_TRUE(out.getStep(1, 14).isGhost());
+        EXPECT_TRUE(out.getStep(1, 8).isAccent());
+        EXPECT_NEAR(out.getStep(2, 4).velocity, 0.7f, 1.0f / 255.0f);
+    }
+}
+
+TEST(MarkovGenerator, Deterministic_AndSeedDependent) {
+    MarkovTrainer trainer;
+    DrumBar a = makeRockBar();
+    DrumBar b = makeRockBar();
+    b.getStep(0, 10).velocity = 0.8f;
+    b.getStep(2, 6).velocity = 0.5f;
+    trainer.addBar(a);
+    trainer.addBar(b);
+    MarkovPatternModel model;
+    trainer.build(model);
+
+    DrumBar x;
+    DrumBar y;
+    model.generate(x, DrumBar::Genre::Rock, 1234);
+    model.generate(y, DrumBar::Genre::Rock, 1234);
+    EXPECT_TRUE(sameBars(x, y));
+
+    bool anyDifferent = false;
+    for (uint64_t seed = 0; seed < 64 && !anyDifferent; ++seed) {
+        model.generate(y, DrumBar::Genre::Rock, Seed::splitmix64(seed));
+        anyDifferent = !sameBars(x, y);
+    }
+    EXPECT_TRUE(anyDifferent);
+}
+
+TEST(MarkovGenerator, SerializeRoundTrip) {
+    const MarkovPatternModel model = trainRock();
+    std::vector<uint8_t> bytes(model.serializedSize());
+    ASSERT_EQ(model.serialize(bytes.data(), bytes.size()), bytes.size());
+
+    MarkovPatternModel loaded;
+    ASSERT_TRUE(loaded.deserialize(bytes.data(), bytes.size()));
+    EXPECT_TRUE(loaded.hasGenre(DrumBar::Genre::Rock));
+    EXPECT_FALSE(loaded.hasGenre(DrumBar::Genre::Latin));
+
+    for (uint32_t bar = 0; bar < 8; ++bar) {
+        DrumBar x;
+        DrumBar y;
+        model.generate(x, DrumBar::Genre::Rock, Seed::deriveSeed(1, 0, bar));
+        loaded.generate(y, DrumBar::Genre::Rock, Seed::deriveSeed(1, 0, bar));
+        EXPECT_TRUE(sameBars(x, y));
+    }
+}
+
+TEST(MarkovGenerator, Serialize_BufferTooSmall) {
+    const MarkovPatternModel model = trainRock();
+    std::vector<uint8_t> bytes(model.serializedSize() - 1);
+    EXPECT_EQ(model.serialize(bytes.data(), bytes.size()), 0u);
+}
+
+TEST(MarkovGenerator, Deserialize_RejectsBadData) {
+    const MarkovPatternModel model = trainRock();
+    std::vector<uint8_t> bytes(model.serializedSize());
+    model.serialize(bytes.data(), bytes.size());
+
+    MarkovPatternModel loaded = trainRock();
+    EXPECT_FALSE(loaded.deserialize(bytes.data(), bytes.size() - 1));
+
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[0] ^= 0xFF;
+    EXPECT_FALSE(loaded.deserialize(corrupt.data(), corrupt.size()));
+    EXPECT_TRUE(loaded.hasGenre(DrumBar::Genre::Rock));
+}
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/midirecorder.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace JKDigital;
+
+namespace {
+
+// 120 BPM at 48 kHz: one quarter note = 24000 samples, one 32nd step = 3000
+constexpr double kRate = 48000.0;
+constexpr int32_t kSamplesPerStep = 3000;
+
+MidiRecorder::Transport transportAt(double ppq, TimeSignature ts = TimeSignature::k4_4) {
+    MidiRecorder::Transport t;
+    t.ppqPosition = ppq;
+    const double beatsPerBar = TimeSignatureUtils::getBeatsPerBar(ts);
+    t.barStartPpq = static_cast<int>(ppq / beatsPerBar) * beatsPerBar;
+    t.tempoBpm = 120.0;
+    t.sampleRate = kRate;
+    t.timeSig = ts;
+    return t;
+}
+
+}  // namespace
+
+TEST(MidiRecorder, QuantizesToNearestStep) {
+    MidiRecorder rec;
+    rec.beginBlock(transportAt(0.0));
+    // 600 samples (12.5 ms) after step 4
+    EXPECT_TRUE(rec.recordEvent(4 * kSamplesPerStep + 600, GMDrumMap::SNARE, 127));
+    // 480 samples (10 ms) before step 8
+    EXPECT_TRUE(rec.recordEvent(8 * kSamplesPerStep - 480, GMDrumMap::KICK, 64));
+    rec.flush();
+
+    DrumBar bar;
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_FLOAT_EQ(bar.steps[1][4].velocity, 1.0f);
+    EXPECT_NEAR(bar.steps[1][4].timingOffsetMs, 12.5f, 1e-3f);
+    EXPECT_NEAR(bar.steps[0][8].velocity, 64.0f / 127.0f, 1e-6f);
+    EXPECT_NEAR(bar.steps[0][8].timingOffsetMs, -10.0f, 1e-3f);
+    EXPECT_EQ(bar.barIndex, 0);
+    EXPECT_EQ(bar.genre, DrumBar::Genre::Uncertain);
+    EXPECT_FALSE(rec.popBar(bar));
+}
+
+TEST(MidiRecorder, ClampsResidualToTimingLimits) {
+    MidiRecorder rec;
+    MidiRecorder::Transport t = transportAt(0.0);
+    t.tempoBpm = 40.0;  // 93.75 ms per step: residuals can exceed 20 ms
+    rec.beginBlock(t);
+    // 0.4 step late = 37.5 ms
+    EXPECT_TRUE(rec.recordEvent(3600, GMDrumMap::KICK, 100));
+    rec.flush();
+    DrumBar bar;
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_FLOAT_EQ(bar.steps[0][0].timingOffsetMs, Constants::kMaxTimingOffsetMs);
+}
+
+TEST(MidiRecorder, IgnoresUnmappedNotesAndNoteOff) {
+    MidiRecorder rec;
+    rec.beginBlock(transportAt(0.0));
+    EXPECT_FALSE(rec.recordEvent(0, 60, 100));
+    EXPECT_FALSE(rec.recordEvent(0, GMDrumMap::KICK, 0));
+    rec.flush();
+    DrumBar bar;
+    EXPECT_FALSE(rec.popBar(bar));
+}
+
+TEST(MidiRecorder, RollsOverAtBarEnd) {
+    MidiRecorder rec;
+    rec.beginBlock(transportAt(0.0));
+    rec.recordEvent(0, GMDrumMap::KICK, 100);
+    // Early hit just before the next downbeat lands on step 0 of bar 1
+    rec.beginBlock(transportAt(3.9));
+    rec.recordEvent(2160, GMDrumMap::CRASH, 100);  // 3.99 PPQ
+    DrumBar bar;
+    EXPECT_FALSE(rec.popBar(bar));  // Bar 0 stays open until half a step past its end
+
+    rec.beginBlock(transportAt(4.5));
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_EQ(bar.barIndex, 0);
+    EXPECT_GT(bar.steps[0][0].velocity, 0.0f);
+    EXPECT_EQ(bar.steps[7][0].velocity, 0.0f);
+
+    rec.flush();
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_EQ(bar.barIndex, 1);
+    EXPECT_GT(bar.steps[7][0].velocity, 0.0f);
+}
+
+TEST(MidiRecorder, AnticipatedDownbeatHasNegativeOffset) {
+    MidiRecorder rec;
+    rec.beginBlock(transportAt(3.75));
+    // 240 samples (5 ms) before the next bar
+    rec.recordEvent(6000 - 240, GMDrumMap::KICK, 100);
+    rec.beginBlock(transportAt(8.0));
+    DrumBar bar;
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_EQ(bar.barIndex, 1);
+    EXPECT_NEAR(bar.steps[0][0].timingOffsetMs, -5.0f, 1e-3f);
+}
+
+TEST(MidiRecorder, LoopJumpFlushesOpenBars) {
+    MidiRecorder rec;
+    rec.beginBlock(transportAt(8.0));
+    rec.recordEvent(0, GMDrumMap::SNARE, 100);
+    rec.beginBlock(transportAt(0.0));
+    DrumBar bar;
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_EQ(bar.barIndex, 2);
+}
+
+TEST(MidiRecorder, DropsStepsOutsideGrid) {
+    MidiRecorder rec;
+    // 5/4 spans 40 steps but only 32 are on the grid
+    rec.beginBlock(transportAt(4.5, TimeSignature::k5_4));
+    EXPECT_FALSE(rec.recordEvent(0, GMDrumMap::KICK, 100));
+    EXPECT_EQ(rec.droppedEvents(), 1u);
+}
+
+TEST(MidiRecorder, KeepsLouderHitAndArticulation) {
+    KitMap kit = KitMap::generalMidi();
+    kit.setArticulationNote(1, KitMap::Articulation::Ghost, 40);
+    MidiRecorder rec;
+    rec.setKitMap(kit);
+    rec.beginBlock(transportAt(0.0));
+    rec.recordEvent(8 * kSamplesPerStep, 40, 30);
+    rec.recordEvent(8 * kSamplesPerStep + 100, GMDrumMap::KICK, 90);
+    rec.recordEvent(8 * kSamplesPerStep + 200, GMDrumMap::KICK, 50);
+    rec.flush();
+    DrumBar bar;
+    ASSERT_TRUE(rec.popBar(bar));
+    EXPECT_TRUE(bar.steps[1][8].isGhost());
+    EXPECT_NEAR(bar.steps[0][8].velocity, 90.0f / 127.0f, 1e-6f);
+}
+
+TEST(MidiRecorder, CountsDroppedBarsWhenQueueFull) {
+    MidiRecorder rec;
+    for (int b = 0; b < 12; ++b) {
+        rec.beginBlock(transportAt(b * 4.0));
+        rec.recordEvent(0, GMDrumMap::KICK, 100);
+    }
+    rec.flush();
+    EXPECT_EQ(rec.pendingBars(), DrumPatternBuffer::CAPACITY - 1);
+    EXPECT_EQ(rec.droppedBars(), 12u - (DrumPatternBuffer::CAPACITY - 1));
+}
+
+TEST(MidiRecorder, DropCountersReadableFromConsumerThread) {
+    MidiRecorder rec;
+    std::atomic<bool> done{false};
+    uint32_t lastSeen = 0;
+    bool monotonic = true;
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            const uint32_t seen = rec.droppedBars();
+            monotonic = monotonic && seen >= lastSeen;
+            lastSeen = seen;
+        }
+    });
+    for (int b = 0; b < 200; ++b) {
+        rec.beginBlock(transportAt(b * 4.0));
+        rec.recordEvent(0, GMDrumMap::KICK, 100);
+    }
+    rec.flush();
+    done.store(true, std::memory_order_release);
+    reader.join();
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(rec.droppedBars(), 200u - (DrumPatternBuffer::CAPACITY - 1));
+}
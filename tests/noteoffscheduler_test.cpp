@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/noteoffscheduler.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+using NoteOff = NoteOffScheduler::NoteOff;
+
+// Collects emitted note-offs
+struct Sink {
+    std::vector<NoteOff> events;
+    void operator()(const NoteOff& e) { events.push_back(e); }
+};
+
+bool sameEvent(const NoteOff& e, int32_t offset, int channel, int note) {
+    return e.sampleOffset == offset && e.channel == channel && e.note == note;
+}
+
+}  // namespace
+
+TEST(NoteOffScheduler, DefaultDurationFromSampleRate) {
+    NoteOffScheduler scheduler(48000.0);
+    EXPECT_EQ(scheduler.noteDuration(), 2400);
+    scheduler.setSampleRate(44100.0);
+    EXPECT_EQ(scheduler.noteDuration(), 2205);
+    scheduler.setNoteDuration(0);
+    EXPECT_EQ(scheduler.noteDuration(), 1);
+}
+
+TEST(NoteOffScheduler, NoteOffLandsInLaterBlock) {
+    NoteOffScheduler scheduler(48000.0);
+    Sink sink;
+    scheduler.noteOn(100, 9, 36, sink);
+    EXPECT_TRUE(scheduler.isPending(9, 36));
+
+    // 2400 samples later: block 4 (2048..2559) at offset 452
+    for (int block = 0; block < 4; ++block) {
+        EXPECT_EQ(scheduler.advance(512, sink), 0u);
+    }
+    EXPECT_EQ(scheduler.advance(512, sink), 1u);
+    ASSERT_EQ(sink.events.size(), 1u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 452, 9, 36));
+    EXPECT_FALSE(scheduler.isPending(9, 36));
+    EXPECT_EQ(scheduler.pending(), 0u);
+    EXPECT_EQ(scheduler.sampleTime(), 2560);
+}
+
+TEST(NoteOffScheduler, EmitsInTimeOrderWithinBlock) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    scheduler.noteOn(0, 0, 40, sink, 300);
+    scheduler.noteOn(10, 0, 41, sink, 5);
+    scheduler.noteOn(20, 1, 40, sink, 100);
+    scheduler.noteOn(20, 0, 42, sink, 100);  // same due sample: scheduling order
+    scheduler.advance(512, sink);
+    ASSERT_EQ(sink.events.size(), 4u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 15, 0, 41));
+    EXPECT_TRUE(sameEvent(sink.events[1], 120, 1, 40));
+    EXPECT_TRUE(sameEvent(sink.events[2], 120, 0, 42));
+    EXPECT_TRUE(sameEvent(sink.events[3], 300, 0, 40));
+}
+
+TEST(NoteOffScheduler, NoteOnEmitsEarlierNoteOffsFirst) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    scheduler.noteOn(0, 9, 38, sink, 50);
+    EXPECT_EQ(scheduler.noteOn(200, 9, 38, sink, 50), 1u);  // previous note already ended
+    ASSERT_EQ(sink.events.size(), 1u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 50, 9, 38));
+    scheduler.advance(512, sink);
+    ASSERT_EQ(sink.events.size(), 2u);
+    EXPECT_TRUE(sameEvent(sink.events[1], 250, 9, 38));
+}
+
+TEST(NoteOffScheduler, ShortenReleasesBeforeRetrigger) {
+    NoteOffScheduler scheduler(48000.0, RetriggerPolicy::Shorten);
+    Sink sink;
+    scheduler.noteOn(0, 9, 42, sink);
+    EXPECT_EQ(scheduler.noteOn(1000, 9, 42, sink), 1u);
+    ASSERT_EQ(sink.events.size(), 1u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 1000, 9, 42));
+    EXPECT_EQ(scheduler.pending(), 1u);
+
+    scheduler.advance(4096, sink);
+    ASSERT_EQ(sink.events.size(), 2u);
+    EXPECT_TRUE(sameEvent(sink.events[1], 3400, 9, 42));
+}
+
+TEST(NoteOffScheduler, ExtendCancelsEarlierNoteOff) {
+    NoteOffScheduler scheduler(48000.0, RetriggerPolicy::Extend);
+    Sink sink;
+    scheduler.noteOn(0, 9, 42, sink);
+    EXPECT_EQ(scheduler.noteOn(1000, 9, 42, sink), 0u);
+    scheduler.advance(4096, sink);
+    ASSERT_EQ(sink.events.size(), 1u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 3400, 9, 42));
+}
+
+TEST(NoteOffScheduler, FlushOnLoopAndStop) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    scheduler.noteOn(0, 9, 36, sink, 100);
+    scheduler.noteOn(400, 9, 38, sink);
+    scheduler.noteOn(480, 9, 42, sink);
+    scheduler.advance(512, sink);
+    ASSERT_EQ(sink.events.size(), 1u);
+
+    // Loop wraps at offset 64: note-offs due before it keep their offsets
+    scheduler.noteOn(0, 9, 49, sink, 10);
+    EXPECT_EQ(scheduler.flush(64, sink), 3u);
+    ASSERT_EQ(sink.events.size(), 4u);
+    EXPECT_TRUE(sameEvent(sink.events[1], 10, 9, 49));
+    EXPECT_EQ(sink.events[2].sampleOffset, 64);
+    EXPECT_EQ(sink.events[3].sampleOffset, 64);
+    EXPECT_EQ(scheduler.pending(), 0u);
+
+    // Notes after the loop point are scheduled normally
+    scheduler.noteOn(64, 9, 36, sink, 100);
+    scheduler.advance(512, sink);
+    ASSERT_EQ(sink.events.size(), 5u);
+    EXPECT_TRUE(sameEvent(sink.events[4], 164, 9, 36));
+
+    scheduler.noteOn(0, 0, 60, sink);
+    EXPECT_EQ(scheduler.flush(0, sink), 1u);
+    EXPECT_EQ(scheduler.flush(0, sink), 0u);
+    EXPECT_EQ(scheduler.advance(100000, sink), 0u);
+}
+
+TEST(NoteOffScheduler, LongNotesWaitForLaterWheelRounds) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    const int64_t far = 3 * NoteOffScheduler::HORIZON + 7;
+    scheduler.noteOn(0, 2, 60, sink, far);
+    scheduler.noteOn(0, 2, 61, sink, 7);  // same wheel slot, first round
+    int64_t time = 0;
+    while (time < 4 * NoteOffScheduler::HORIZON) {
+        scheduler.advance(256, sink);
+        time += 256;
+    }
+    ASSERT_EQ(sink.events.size(), 2u);
+    EXPECT_TRUE(sameEvent(sink.events[0], 7, 2, 61));
+    EXPECT_TRUE(sameEvent(sink.events[1], static_cast<int32_t>(far % 256), 2, 60));
+}
+
+TEST(NoteOffScheduler, LargeBlockKeepsOrder) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    for (int n = 0; n < 20; ++n) {
+        scheduler.noteOn(n, 0, n, sink, (20 - n) * 1000);
+    }
+    const int32_t block = static_cast<int32_t>(3 * NoteOffScheduler::HORIZON);
+    EXPECT_EQ(scheduler.advance(block, sink), 20u);
+    for (size_t k = 1; k < sink.events.size(); ++k) {
+        EXPECT_LE(sink.events[k - 1].sampleOffset, sink.events[k].sampleOffset);
+    }
+    EXPECT_TRUE(sameEvent(sink.events.front(), 1019, 0, 19));
+    EXPECT_TRUE(sameEvent(sink.events.back(), 20000, 0, 0));
+}
+
+TEST(NoteOffScheduler, IgnoresInvalidNotesAndResets) {
+    NoteOffScheduler scheduler;
+    Sink sink;
+    EXPECT_EQ(scheduler.noteOn(0, 16, 36, sink), 0u);
+    EXPECT_EQ(scheduler.noteOn(0, 0, 128, sink), 0u);
+    EXPECT_EQ(scheduler.pending(), 0u);
+    EXPECT_FALSE(scheduler.isPending(-1, 0));
+
+    scheduler.noteOn(0, 0, 36, sink);
+    scheduler.reset();
+    EXPECT_EQ(scheduler.pending(), 0u);
+    EXPECT_EQ(scheduler.advance(100000, sink), 0u);
+    EXPECT_TRUE(sink.events.empty());
+}
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/patternhistory.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+
+using namespace JKDigital;
+
+namespace {
+
+void setHit(PatternHistory& history, int bar, int instrument, int step, float velocity) {
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.bar(bar).steps[instrument][step].velocity = velocity;
+    ASSERT_TRUE(history.commit(std::move(edit)));
+}
+
+}  // namespace
+
+TEST(PatternHistory, StartsWithOneEmptyState) {
+    PatternHistory history;
+    EXPECT_EQ(history.numStates(), 1u);
+    EXPECT_EQ(history.current().numBars(), Constants::kDefaultPatternLength);
+    EXPECT_FALSE(history.current().bar(0).hasNotes());
+    EXPECT_FALSE(history.canUndo());
+    EXPECT_FALSE(history.canRedo());
+    // All empty slots share one node
+    EXPECT_EQ(history.liveNodes(), 1u);
+}
+
+TEST(PatternHistory, EditClonesOnlyTouchedBars) {
+    PatternHistory history;
+    const PatternSnapshot before = history.current();
+
+    PatternHistory::Edit edit = history.beginEdit();
+    EXPECT_FALSE(edit.read(2).hasNotes());
+    EXPECT_EQ(edit.clonedBars(), 0);
+    edit.bar(2).steps[1][8].velocity = 0.7f;
+    EXPECT_EQ(edit.clonedBars(), 1);
+    ASSERT_TRUE(history.commit(std::move(edit)));
+
+    const PatternSnapshot& after = history.current();
+    EXPECT_FLOAT_EQ(after.bar(2).steps[1][8].velocity, 0.7f);
+    EXPECT_FALSE(after.sharesBar(before, 2));
+    for (int b = 0; b < after.numBars(); ++b) {
+        if (b != 2) {
+            EXPECT_TRUE(after.sharesBar(before, b)) << b;
+        }
+    }
+    EXPECT_EQ(history.liveNodes(), 2u);
+    EXPECT_FALSE(before.bar(2).hasNotes());
+}
+
+TEST(PatternHistory, MemoryGrowsWithBarsChangedNotPatternLength) {
+    DrumBar bars[16];
+    for (int b = 0; b < 16; ++b) bars[b].barIndex = b;
+    PatternHistory history;
+    history.reset(bars, 16);
+    EXPECT_EQ(history.liveNodes(), 16u);
+
+    for (int i = 0; i < 50; ++i) setHit(history, i % 16, 0, i % 32, 1.0f - 0.01f * i);
+    EXPECT_EQ(history.liveNodes(), 16u + 50u);
+    EXPECT_EQ(history.memoryUsage(), (16u + 50u) * PatternHistory::kNodeBytes);
+}
+
+TEST(PatternHistory, UndoRedoMovesBetweenStates) {
+    PatternHistory history;
+    setHit(history, 0, 0, 0, 1.0f);
+    setHit(history, 0, 1, 8, 0.5f);
+
+    EXPECT_TRUE(history.undo());
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[0][0].velocity, 1.0f);
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[1][8].velocity, 0.0f);
+    EXPECT_TRUE(history.undo());
+    EXPECT_FALSE(history.current().bar(0).hasNotes());
+    EXPECT_FALSE(history.undo());
+    EXPECT_EQ(history.redoDepth(), 2u);
+
+    EXPECT_TRUE(history.redo());
+    EXPECT_TRUE(history.redo());
+    EXPECT_FALSE(history.redo());
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[1][8].velocity, 0.5f);
+    EXPECT_EQ(history.undoDepth(), 2u);
+}
+
+TEST(PatternHistory, CommitAfterUndoDropsRedoTail) {
+    PatternHistory history;
+    setHit(history, 0, 0, 0, 1.0f);
+    setHit(history, 1, 0, 0, 1.0f);
+    history.undo();
+    setHit(history, 2, 0, 0, 1.0f);
+
+    EXPECT_FALSE(history.canRedo());
+    EXPECT_EQ(history.numStates(), 3u);
+    EXPECT_FALSE(history.current().bar(1).hasNotes());
+    EXPECT_TRUE(history.current().bar(2).hasNotes());
+    // Initial empty node, bar 0 edit, bar 2 edit
+    EXPECT_EQ(history.liveNodes(), 3u);
+}
+
+TEST(PatternHistory, NoOpEditIsNotCommitted) {
+    PatternHistory history;
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.bar(3).steps[0][0].velocity = 0.0f;
+    EXPECT_FALSE(history.commit(std::move(edit)));
+    EXPECT_EQ(history.numStates(), 1u);
+}
+
+TEST(PatternHistory, StaleEditIsRejected) {
+    PatternHistory history;
+    setHit(history, 0, 0, 0, 1.0f);
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.bar(1).steps[0][0].velocity = 1.0f;
+    history.undo();
+    EXPECT_FALSE(history.commit(std::move(edit)));
+}
+
+TEST(PatternHistory, LengthChangeIsAnEdit) {
+    PatternHistory history;
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.setNumBars(12);
+    ASSERT_TRUE(history.commit(std::move(edit)));
+    EXPECT_EQ(history.current().numBars(), 12);
+    EXPECT_EQ(history.liveNodes(), 1u);
+    history.undo();
+    EXPECT_EQ(history.current().numBars(), Constants::kDefaultPatternLength);
+}
+
+TEST(PatternHistory, CommittedStateIgnoresLaterEditWrites) {
+    PatternHistory history;
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.bar(0).steps[0][0].velocity = 0.5f;
+    ASSERT_TRUE(history.commit(std::move(edit)));
+
+    // The edit continues from the committed state with its own clones
+    EXPECT_EQ(edit.clonedBars(), 0);  // NOLINT(bugprone-use-after-move)
+    EXPECT_FLOAT_EQ(edit.read(0).steps[0][0].velocity, 0.5f);
+    edit.bar(0).steps[0][0].velocity = 0.9f;
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[0][0].velocity, 0.5f);
+
+    ASSERT_TRUE(history.commit(std::move(edit)));
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[0][0].velocity, 0.9f);
+    history.undo();
+    EXPECT_FLOAT_EQ(history.current().bar(0).steps[0][0].velocity, 0.5f);
+}
+
+TEST(PatternHistory, GrowingRevealsEmptyBars) {
+    PatternHistory history;
+    PatternHistory::Edit edit = history.beginEdit();
+    edit.setNumBars(8);
+    edit.bar(7).steps[0][0].velocity = 0.7f;
+    ASSERT_TRUE(history.commit(std::move(edit)));
+
+    PatternHistory::Edit shrink = history.beginEdit();
+    shrink.setNumBars(4);
+    ASSERT_TRUE(history.commit(std::move(shrink)));
+
+    PatternHistory::Edit grow = history.beginEdit();
+    grow.setNumBars(8);
+    EXPECT_FALSE(grow.read(7).hasNotes());
+    ASSERT_TRUE(history.commit(std::move(grow)));
+    EXPECT_EQ(history.current().numBars(), 8);
+    EXPECT_FALSE(history.current().bar(7).hasNotes());
+
+    // Shrinking and growing within one edit also clears the bar
+    history.undo();
+    history.undo();
+    PatternHistory::Edit both = history.beginEdit();
+    both.setNumBars(4);
+    both.setNumBars(8);
+    EXPECT_FALSE(both.read(7).hasNotes());
+}
+
+TEST(PatternHistory, BudgetEvictsOldestStates) {
+    PatternHistory history(5 * PatternHistory::kNodeBytes);
+    for (int i = 0; i < 10; ++i) setHit(history, i % 4, 0, i, 1.0f);
+
+    EXPECT_LE(history.memoryUsage(), history.memoryBudget());
+    EXPECT_LT(history.numStates(), 11u);
+    EXPECT_FALSE(history.canRedo());
+    // The newest edit is intact
+    EXPECT_FLOAT_EQ(history.current().bar(1).steps[0][9].velocity, 1.0f);
+
+    while (history.undo()) {
+    }
+    EXPECT_GE(history.current().numBars(), 1);
+
+    history.redo();
+    history.setMemoryBudget(0);
+    EXPECT_EQ(history.undoDepth(), 0u);
+}
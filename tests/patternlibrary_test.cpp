@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/patternlibrary.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+std::vector<DrumBar> makeLibrary() {
+    std::vector<DrumBar> bars(40);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        bars[i].genre = (i % 2 == 0) ? DrumBar::Genre::Jazz : DrumBar::Genre::Latin;
+        bars[i].role = (i % 4 < 2) ? DrumBar::Role::MainGroove : DrumBar::Role::Fill;
+        bars[i].barIndex = static_cast<int32_t>(i);
+    }
+    return bars;
+}
+
+}  // namespace
+
+TEST(PatternLibraryIndex, EmptyIndex) {
+    PatternLibraryIndex index;
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Rock, DrumBar::Role::MainGroove), 0u);
+    EXPECT_TRUE(index.bucket(DrumBar::Genre::Rock, DrumBar::Role::Fill).empty());
+    EXPECT_EQ(index.select(DrumBar::Genre::Rock, DrumBar::Role::Fill, TimeSignature::k4_4, 1),
+              nullptr);
+}
+
+TEST(PatternLibraryIndex, CountsPerBucket) {
+    const std::vector<DrumBar> bars = makeLibrary();
+    PatternLibraryIndex index;
+    index.build(bars.data(), bars.size());
+    EXPECT_EQ(index.size(), 40u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::MainGroove), 10u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::Fill), 10u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Latin, DrumBar::Role::Fill), 10u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Rock, DrumBar::Role::Fill), 0u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::Fill, TimeSignature::k3_4), 0u);
+}
+
+TEST(PatternLibraryIndex, BucketContainsOnlyMatchingBarsInSourceOrder) {
+    const std::vector<DrumBar> bars = makeLibrary();
+    PatternLibraryIndex index;
+    index.build(bars.data(), bars.size());
+
+    const auto bucket = index.bucket(DrumBar::Genre::Latin, DrumBar::Role::Fill);
+    ASSERT_EQ(bucket.size(), 10u);
+    int32_t previous = -1;
+    for (const DrumBar& bar : bucket) {
+        EXPECT_EQ(bar.genre, DrumBar::Genre::Latin);
+        EXPECT_EQ(bar.role, DrumBar::Role::Fill);
+        EXPECT_GT(bar.barIndex, previous);
+        EXPECT_EQ(index.sourceIndex(&bar), static_cast<uint32_t>(bar.barIndex));
+        previous = bar.barIndex;
+    }
+}
+
+TEST(PatternLibraryIndex, PerBarTimeSignatures) {
+    std::vector<DrumBar> bars = makeLibrary();
+    std::vector<TimeSignature> sigs(bars.size(), TimeSignature::k4_4);
+    sigs[0] = TimeSignature::k6_8;
+    sigs[4] = TimeSignature::k6_8;
+    PatternLibraryIndex index;
+    index.build(bars.data(), sigs.data(), bars.size());
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::MainGroove, TimeSignature::k6_8),
+              2u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::MainGroove), 8u);
+}
+
+TEST(PatternLibraryIndex, SelectDeterministicAndCoversBucket) {
+    const std::vector<DrumBar> bars = makeLibrary();
+    PatternLibraryIndex index;
+    index.build(bars.data(), bars.size());
+
+    const DrumBar* a =
+        index.select(DrumBar::Genre::Jazz, DrumBar::Role::Fill, TimeSignature::k4_4, 99);
+    const DrumBar* b =
+        index.select(DrumBar::Genre::Jazz, DrumBar::Role::Fill, TimeSignature::k4_4, 99);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, b);
+
+    std::set<int32_t> seen;
+    for (uint32_t k = 0; k < 500; ++k) {
+        const DrumBar* bar = index.select(DrumBar::Genre::Jazz, DrumBar::Role::Fill,
+                                          TimeSignature::k4_4, Seed::deriveSeed(1, 0, k));
+        ASSERT_NE(bar, nullptr);
+        EXPECT_EQ(bar->genre, DrumBar::Genre::Jazz);
+        EXPECT_EQ(bar->role, DrumBar::Role::Fill);
+        seen.insert(bar->barIndex);
+    }
+    EXPECT_EQ(seen.size(), 10u);
+}
+
+TEST(PatternLibraryIndex, RebuildReplacesContents) {
+    std::vector<DrumBar> bars = makeLibrary();
+    PatternLibraryIndex index;
+    index.build(bars.data(), bars.size());
+    index.build(bars.data(), 4);
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_EQ(index.count(DrumBar::Genre::Jazz, DrumBar::Role::MainGroove), 1u);
+}
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/pipeline.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace JKDigital;
+
+namespace {
+
+// params[0] = velocity scale
+void scaleVelocity(DrumBar& bar, const TransformContext& ctx) {
+    for (auto& row : bar.steps) {
+        for (DrumStep& step : row) step.velocity *= ctx.params[0];
+    }
+}
+
+// Adds a seeded hit on the perc row
+void seededPerc(DrumBar& bar, const TransformContext& ctx) {
+    bar.steps[9][ctx.seed % DrumBar::STEPS_PER_BAR].velocity = 0.5f;
+}
+
+// params[0] = instrument, params[1] = step
+void addHit(DrumBar& bar, const TransformContext& ctx) {
+    bar.steps[static_cast<int>(ctx.params[0])][static_cast<int>(ctx.params[1])].velocity = 1.0f;
+}
+
+DrumBar kickBar(int barIndex) {
+    DrumBar bar;
+    bar.steps[0][0].velocity = 1.0f;
+    bar.steps[0][16].velocity = 0.8f;
+    bar.barIndex = barIndex;
+    return bar;
+}
+
+void expectBarsEqual(const DrumBar& a, const DrumBar& b) {
+    EXPECT_EQ(TransformPipeline::hashBar(a), TransformPipeline::hashBar(b));
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int j = 0; j < DrumBar::STEPS_PER_BAR; ++j) {
+            EXPECT_FLOAT_EQ(a.steps[i][j].velocity, b.steps[i][j].velocity);
+        }
+    }
+}
+
+// Ten-stage chain over 8 bars
+std::unique_ptr<TransformPipeline> tenStageChain() {
+    auto p = std::make_unique<TransformPipeline>();
+    for (int b = 0; b < 8; ++b) p->setInput(b, kickBar(b));
+    const float half = 0.9f;
+    for (int k = 0; k < 10; ++k) {
+        EXPECT_EQ(p->addStage(k % 2 == 0 ? scaleVelocity : seededPerc, &half, 1), k);
+    }
+    return p;
+}
+
+}  // namespace
+
+TEST(TransformPipeline, EmptyChainPassesInputThrough) {
+    TransformPipeline p;
+    p.setInput(0, kickBar(0));
+    expectBarsEqual(p.output(0), kickBar(0));
+    EXPECT_EQ(p.stageRuns(), 0u);
+}
+
+TEST(TransformPipeline, MatchesDirectApplication) {
+    TransformPipeline p;
+    p.setMasterSeed(42);
+    const float scale = 0.5f;
+    const float hit[2] = {1.0f, 4.0f};
+    p.addStage(scaleVelocity, &scale, 1);
+    p.addStage(seededPerc);
+    p.addStage(addHit, hit, 2);
+    p.setInput(3, kickBar(3));
+
+    DrumBar expected = kickBar(3);
+    for (auto& row : expected.steps) {
+        for (DrumStep& step : row) step.velocity *= 0.5f;
+    }
+    expected.steps[9][Seed::deriveSeed(42, 1, 3) % DrumBar::STEPS_PER_BAR].velocity = 0.5f;
+    expected.steps[1][4].velocity = 1.0f;
+
+    expectBarsEqual(p.output(3), expected);
+    EXPECT_EQ(p.numBars(), 4);
+}
+
+TEST(TransformPipeline, SecondEvaluationIsFullyCached) {
+    auto p = tenStageChain();
+    EXPECT_EQ(p->process(), 80u);
+    EXPECT_EQ(p->process(), 0u);
+}
+
+TEST(TransformPipeline, LastStageChangeRecomputesOneStagePerBar) {
+    auto p = tenStageChain();
+    p->process();
+    const DrumBar before = p->output(2);
+
+    EXPECT_TRUE(p->setParam(9, 0, 0.25f));
+    EXPECT_EQ(p->process(), 8u);
+    // seededPerc ignores its parameter, so the output is unchanged
+    expectBarsEqual(p->output(2), before);
+}
+
+TEST(TransformPipeline, MiddleStageChangeRecomputesDownstreamOnly) {
+    auto p = tenStageChain();
+    p->process();
+    EXPECT_TRUE(p->setParam(4, 0, 0.5f));
+    EXPECT_EQ(p->process(), 8u * 6u);
+    EXPECT_FLOAT_EQ(p->param(4, 0), 0.5f);
+}
+
+TEST(TransformPipeline, InputChangeRecomputesThatBarOnly) {
+    auto p = tenStageChain();
+    p->process();
+
+    DrumBar changed = kickBar(5);
+    changed.steps[1][8].velocity = 1.0f;
+    p->setInput(5, changed);
+    EXPECT_EQ(p->process(), 10u);
+    EXPECT_GT(p->output(5).steps[1][8].velocity, 0.0f);
+
+    // Same contents again: nothing to do
+    p->setInput(5, changed);
+    EXPECT_EQ(p->process(), 0u);
+}
+
+TEST(TransformPipeline, RevertedParameterIsStillRecomputedCorrectly) {
+    TransformPipeline p;
+    const float scale = 0.5f;
+    p.addStage(scaleVelocity, &scale, 1);
+    p.setInput(0, kickBar(0));
+    EXPECT_FLOAT_EQ(p.output(0).steps[0][0].velocity, 0.5f);
+    p.setParam(0, 0, 0.25f);
+    EXPECT_FLOAT_EQ(p.output(0).steps[0][0].velocity, 0.25f);
+    p.setParam(0, 0, 0.5f);
+    EXPECT_FLOAT_EQ(p.output(0).steps[0][0].velocity, 0.5f);
+}
+
+TEST(TransformPipeline, MasterSeedChangeRecomputesEverything) {
+    auto p = tenStageChain();
+    p->process();
+    p->setMasterSeed(7);
+    EXPECT_EQ(p->process(), 80u);
+    p->setMasterSeed(7);
+    EXPECT_EQ(p->process(), 0u);
+}
+
+TEST(TransformPipeline, BypassedStageKeepsItsCache) {
+    auto p = tenStageChain();
+    p->process();
+
+    EXPECT_TRUE(p->setEnabled(9, false));
+    EXPECT_FALSE(p->isEnabled(9));
+    EXPECT_EQ(p->process(), 0u);  // output is stage 8's cached result
+
+    EXPECT_TRUE(p->setEnabled(9, true));
+    EXPECT_EQ(p->process(), 0u);
+
+    // Bypassing a middle stage changes the chain key of everything after it
+    p->setEnabled(3, false);
+    EXPECT_EQ(p->process(), 8u * 6u);
+}
+
+TEST(TransformPipeline, MiddleBypassToggleRecomputesOnce) {
+    auto p = tenStageChain();
+    p->process();
+    const DrumBar enabled = p->output(5);
+
+    // Stages 4..9 run once on the bypass chain; stage 3 keeps its output
+    p->setEnabled(3, false);
+    EXPECT_EQ(p->process(), 8u * 6u);
+    const DrumBar bypassed = p->output(5);
+
+    // Both chains stay cached: toggling back and forth is free
+    p->setEnabled(3, true);
+    EXPECT_EQ(p->process(), 0u);
+    expectBarsEqual(p->output(5), enabled);
+    p->setEnabled(3, false);
+    EXPECT_EQ(p->process(), 0u);
+    expectBarsEqual(p->output(5), bypassed);
+
+    // A third chain evicts the least recently used one: stages 4..9 lose
+    // the enabled chain, stage 3 (bypassed meanwhile) keeps its output
+    p->setParam(0, 0, 0.5f);
+    EXPECT_EQ(p->process(), 8u * 9u);
+    p->setParam(0, 0, 0.9f);
+    EXPECT_EQ(p->process(), 0u);
+    p->setEnabled(3, true);
+    EXPECT_EQ(p->process(), 8u * 6u);
+    expectBarsEqual(p->output(5), enabled);
+}
+
+TEST(TransformPipeline, InvalidateForcesFullRecompute) {
+    auto p = tenStageChain();
+    p->process();
+    p->invalidate();
+    EXPECT_EQ(p->process(), 80u);
+}
+
+TEST(TransformPipeline, RejectsInvalidArguments) {
+    TransformPipeline p;
+    const float params[TransformPipeline::MAX_PARAMS + 1] = {};
+    EXPECT_EQ(p.addStage(nullptr), -1);
+    EXPECT_EQ(p.addStage(scaleVelocity, nullptr, 1), -1);
+    EXPECT_EQ(p.addStage(scaleVelocity, params, TransformPipeline::MAX_PARAMS + 1), -1);
+    EXPECT_FALSE(p.setParam(0, 0, 1.0f));
+    EXPECT_FALSE(p.setInput(TransformPipeline::MAX_BARS, DrumBar()));
+
+    ASSERT_EQ(p.addStage(scaleVelocity, params, 1), 0);
+    EXPECT_FALSE(p.setParam(0, 1, 1.0f));
+    EXPECT_FALSE(p.setParams(0, params, 2));
+    for (int k = 1; k < TransformPipeline::MAX_STAGES; ++k) p.addStage(seededPerc);
+    EXPECT_EQ(p.addStage(seededPerc), -1);
+    EXPECT_EQ(p.numStages(), TransformPipeline::MAX_STAGES);
+
+    p.clearStages();
+    EXPECT_EQ(p.numStages(), 0);
+}
+
+TEST(TransformPipeline, HashIgnoresPaddingAndSeesEveryField) {
+    DrumBar a = kickBar(0);
+    DrumBar b = kickBar(0);
+    EXPECT_EQ(TransformPipeline::hashBar(a), TransformPipeline::hashBar(b));
+    b.steps[4][31].flags = DrumStep::FLAG_GHOST;
+    EXPECT_NE(TransformPipeline::hashBar(a), TransformPipeline::hashBar(b));
+    b = a;
+    b.steps[0][0].timingOffsetMs = 1.0f;
+    EXPECT_NE(TransformPipeline::hashBar(a), TransformPipeline::hashBar(b));
+    b = a;
+    b.genre = DrumBar::Genre::Jazz;
+    EXPECT_NE(TransformPipeline::hashBar(a), TransformPipeline::hashBar(b));
+}
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/rhythmfeatures.h>
+#include <gtest/gtest.h>
+
+#include "testbars.h"
+
+#include <drumcore/seed.h>
+
+using namespace JKDigital;
+
+TEST(RhythmFeatures, EmptyBarIsZero) {
+    const RhythmFeatures f = RhythmAnalysis::extract(DrumBar());
+    EXPECT_EQ(f.onsetCount, 0);
+    for (float v : f.values) EXPECT_FLOAT_EQ(v, 0.0f);
+}
+
+TEST(RhythmFeatures, DensityAndBackbeat) {
+    const RhythmFeatures f = RhythmAnalysis::extract(TestBars::rock());
+    EXPECT_EQ(f.onsetCount, 12);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kDensity + 0], 2.0f / 32.0f);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kDensity + 2], 8.0f / 32.0f);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kBackbeat], 1.0f);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kSyncopation], 0.0f);
+    // Hats on the four 8th off-beats
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kOffbeat], 4.0f / 12.0f);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kRideShare], 0.0f);
+    EXPECT_GT(f.values[RhythmFeatures::kVelocityVariance], 0.0f);
+}
+
+TEST(RhythmFeatures, SyncopationCountsAnticipations) {
+    DrumBar bar;
+    // 16th before beat 2 with beat 2 silent is syncopated
+    bar.steps[0][6].velocity = 1.0f;
+    // 16th before beat 3 with beat 3 played is not
+    bar.steps[0][14].velocity = 1.0f;
+    bar.steps[0][16].velocity = 1.0f;
+    const RhythmFeatures f = RhythmAnalysis::extract(bar);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kSyncopation], 1.0f / 3.0f);
+}
+
+TEST(RhythmFeatures, IgnoresInactiveSteps) {
+    DrumBar bar = TestBars::rock();
+    const RhythmFeatures f = RhythmAnalysis::extract(bar, TimeSignature::k3_4);
+    // 3/4 has 24 active steps: the snare on step 24 and hats from 24 are dropped
+    EXPECT_EQ(f.onsetCount, 2 + 1 + 6);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kDensity + 2], 6.0f / 24.0f);
+}
+
+TEST(RhythmFeatures, MetricMasksFor4_4) {
+    const RhythmAnalysis::MetricMasks& m = RhythmAnalysis::kMetricMasks[0];
+    EXPECT_EQ(m.active, 0xFFFFFFFFu);
+    EXPECT_EQ(m.backbeat, (1u << 8) | (1u << 24));
+    EXPECT_EQ(m.offbeat, (1u << 4) | (1u << 12) | (1u << 20) | (1u << 28));
+    EXPECT_EQ(m.stronger[6], 1u << 8);
+    EXPECT_EQ(m.stronger[31], 1u << 0);
+}
+
+TEST(RhythmFeatures, RideShare) {
+    DrumBar bar;
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 8) {
+        bar.steps[RhythmAnalysis::kRide][s].velocity = 0.8f;
+    }
+    bar.steps[RhythmAnalysis::kClosedHat][8].velocity = 0.8f;
+    const RhythmFeatures f = RhythmAnalysis::extract(bar);
+    EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kRideShare], 0.8f);
+}
+
+TEST(RhythmFeatures, MatchesPerStepReference) {
+    // Seeded velocities, some silent or negative, checked against a per-step loop
+    for (int t = 0; t < kNumTimeSignatures; ++t) {
+        const RhythmAnalysis::MetricMasks& m = RhythmAnalysis::kMetricMasks[t];
+        for (uint64_t b = 0; b < 20; ++b) {
+            DrumBar bar;
+            int counts[DrumBar::NUM_INSTRUMENTS] = {};
+            int total = 0;
+            double sum = 0.0;
+            double sumSq = 0.0;
+            for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+                for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                    const uint64_t cell = static_cast<uint64_t>(i * DrumBar::STEPS_PER_BAR + s);
+                    const uint64_t r = Seed::splitmix64(b * 1000 + cell);
+                    const float v = r % 3 == 0 ? Seed::toUnitFloat(r) - 0.2f : 0.0f;
+                    bar.steps[i][s] = DrumStep(v, 1.5f, DrumStep::FLAG_ACCENT);
+                    if (v > 0.0f && ((m.active >> s) & 1u) != 0) {
+                        ++counts[i];
+                        ++total;
+                        sum += v;
+                        sumSq += static_cast<double>(v) * v;
+                    }
+                }
+            }
+
+            RhythmFeatures f;
+            RhythmAnalysis::extract(bar, m, f);
+            ASSERT_EQ(f.onsetCount, total);
+            for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+                EXPECT_FLOAT_EQ(f.values[RhythmFeatures::kDensity + i],
+                                static_cast<float>(counts[i]) /
+                                    static_cast<float>(m.activeSteps));
+            }
+            const double mean = sum / total;
+            EXPECT_NEAR(f.values[RhythmFeatures::kVelocityVariance], sumSq / total - mean * mean,
+                        1e-5);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/rtprofiler.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace JKDigital;
+
+TEST(RtHistogram, BucketBoundsCoverValues) {
+    const uint64_t values[] = {0, 1, 3, 4, 5, 7, 8, 100, 1000, 12345, 999999, 1ull << 39};
+    for (uint64_t v : values) {
+        const int b = RtHistogram::bucketOf(v);
+        EXPECT_LE(RtHistogram::bucketLowerBound(b), v) << v;
+        EXPECT_GE(RtHistogram::bucketUpperBound(b), v) << v;
+    }
+    EXPECT_EQ(RtHistogram::bucketOf(1ull << 41), RtHistogram::NUM_BUCKETS - 1);
+}
+
+TEST(RtHistogram, BucketsAreContiguous) {
+    for (int b = 0; b < RtHistogram::NUM_BUCKETS - 1; ++b) {
+        EXPECT_EQ(RtHistogram::bucketUpperBound(b) + 1, RtHistogram::bucketLowerBound(b + 1));
+        EXPECT_EQ(RtHistogram::bucketOf(RtHistogram::bucketLowerBound(b)), b);
+    }
+}
+
+TEST(RtHistogram, PercentilesWithinBucketPrecision) {
+    RtHistogram h;
+    for (uint64_t v = 1; v <= 1000; ++v) h.record(v * 1000);
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_EQ(h.maxNs(), 1000000u);
+    EXPECT_NEAR(h.meanNs(), 500500.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(h.percentileNs(0.5)), 500000.0, 500000.0 * 0.25);
+    EXPECT_NEAR(static_cast<double>(h.percentileNs(0.99)), 990000.0, 990000.0 * 0.25);
+    EXPECT_EQ(h.percentileNs(1.0), 1000000u);
+}
+
+TEST(RtHistogram, EmptyAndReset) {
+    RtHistogram h;
+    EXPECT_EQ(h.percentileNs(0.5), 0u);
+    h.record(42);
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.maxNs(), 0u);
+}
+
+TEST(RtProfiler, BudgetFromBlockConfig) {
+    RtProfiler profiler;
+    profiler.setBlockConfig(480, 48000.0);
+    EXPECT_EQ(profiler.budgetNs(), 10000000u);
+}
+
+TEST(RtProfiler, CountsOverruns) {
+    RtProfiler profiler;
+    profiler.setBlockConfig(48, 48000.0);  // 1 ms budget
+    profiler.recordCallback(500000);
+    profiler.recordCallback(900000);
+    profiler.recordCallback(1500000);
+    const RtProfiler::Stats stats = profiler.callbackStats();
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_EQ(stats.overruns, 1u);
+    EXPECT_EQ(stats.worstNs, 1500000u);
+    EXPECT_DOUBLE_EQ(profiler.lastLoad(), 1.5);
+}
+
+TEST(RtProfiler, Stages) {
+    RtProfiler profiler;
+    const int pop = profiler.addStage("pattern pop");
+    const int render = profiler.addStage("render");
+    EXPECT_EQ(pop, 0);
+    EXPECT_EQ(render, 1);
+    EXPECT_EQ(profiler.addStage("render"), render);
+    EXPECT_EQ(profiler.findStage("humanize"), -1);
+    EXPECT_STREQ(profiler.stageName(render), "render");
+
+    {
+        RtProfiler::CallbackScope cb(profiler);
+        { RtProfiler::StageScope s(profiler, pop); }
+        {
+            RtProfiler::StageScope s(profiler, render);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    EXPECT_EQ(profiler.callbackStats().count, 1u);
+    EXPECT_EQ(profiler.stageStats(pop).count, 1u);
+    EXPECT_GE(profiler.stageStats(render).worstNs, 200000u);
+    EXPECT_GE(profiler.callbackStats().worstNs, profiler.stageStats(render).worstNs);
+}
+
+TEST(RtProfiler, StageLimit) {
+    RtProfiler profiler;
+    const char* names[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    for (const char* n : names) EXPECT_GE(profiler.addStage(n), 0);
+    EXPECT_EQ(profiler.addStage("overflow"), -1);
+}
+
+TEST(RtProfiler, RequestedResetAppliedByWriter) {
+    RtProfiler profiler;
+    profiler.recordCallback(100);
+    profiler.requestReset();
+    EXPECT_EQ(profiler.callbackStats().count, 1u);
+    profiler.recordCallback(200);
+    EXPECT_EQ(profiler.callbackStats().count, 1u);
+    EXPECT_EQ(profiler.callbackStats().worstNs, 200u);
+}
+
+TEST(RtProfiler, ConcurrentReader) {
+    RtProfiler profiler;
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            const RtProfiler::Stats s = profiler.callbackStats();
+            EXPECT_LE(s.p50Ns, s.worstNs);
+        }
+    });
+    for (int i = 0; i < 20000; ++i) profiler.recordCallback(static_cast<uint64_t>(i % 500));
+    done.store(true);
+    reader.join();
+    EXPECT_EQ(profiler.callbackStats().count, 20000u);
+}
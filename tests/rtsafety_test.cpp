@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/drumgrid.h>
+#include <drumcore/humanizer.h>
+#include <drumcore/kitmap.h>
+#include <drumcore/lockfreequeue.h>
+#include <drumcore/midirecorder.h>
+#include <drumcore/rtsafety.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <new>
+
+using namespace JKDigital;
+
+namespace {
+
+// Silent handler so expected violations do not spam the test log
+void ignoreViolation(RtSafety::Violation, const char*) {}
+
+// Heap round trip the optimizer cannot elide: a direct ::operator new call
+// is not a new-expression, and the volatile sink keeps the pointer live
+void allocateAndFree() {
+    void* volatile sink = ::operator new(sizeof(int));
+    ::operator delete(sink);
+}
+
+class RtSafetyTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        if (!RtSafety::enabled()) GTEST_SKIP() << "built without DRUMCORE_RT_CHECKS";
+        RtSafety::resetCounts();
+    }
+    void TearDown() override { RtSafety::setHandler(nullptr); }
+};
+
+struct Event {
+    int32_t note;
+    float velocity;
+    double ppq;
+};
+
+}  // namespace
+
+TEST_F(RtSafetyTest, ScopeMarksThread) {
+    EXPECT_FALSE(RtSafety::isRealtimeThread());
+    {
+        RtScope rt;
+        {
+            RtScope nested;
+        }
+        const bool inside = RtSafety::isRealtimeThread();
+        EXPECT_TRUE(inside);
+    }
+    EXPECT_FALSE(RtSafety::isRealtimeThread());
+}
+
+TEST_F(RtSafetyTest, DetectsAllocation) {
+    RtSafety::setHandler(ignoreViolation);
+    {
+        RtScope rt;
+        allocateAndFree();
+    }
+    EXPECT_GE(RtSafety::violationCount(RtSafety::Violation::Allocation), 1u);
+    EXPECT_GE(RtSafety::violationCount(RtSafety::Violation::Deallocation), 1u);
+}
+
+TEST_F(RtSafetyTest, IgnoresNonRealtimeThreads) {
+    allocateAndFree();
+    EXPECT_EQ(RtSafety::totalViolations(), 0u);
+}
+
+TEST_F(RtSafetyTest, AllowScopeSuspendsChecks) {
+    RtSafety::setHandler(ignoreViolation);
+    {
+        RtScope rt;
+        RtAllowScope allow;
+        allocateAndFree();
+    }
+    EXPECT_EQ(RtSafety::totalViolations(), 0u);
+}
+
+TEST_F(RtSafetyTest, DetectsMutexLock) {
+    RtSafety::setHandler(ignoreViolation);
+    std::mutex mutex;
+    {
+        RtScope rt;
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    EXPECT_EQ(RtSafety::violationCount(RtSafety::Violation::MutexLock), 1u);
+}
+
+TEST_F(RtSafetyTest, DetectsSleep) {
+    RtSafety::setHandler(ignoreViolation);
+    const timespec ts = {0, 1000};
+    {
+        RtScope rt;
+        nanosleep(&ts, nullptr);
+    }
+    EXPECT_EQ(RtSafety::violationCount(RtSafety::Violation::Sleep), 1u);
+}
+
+TEST_F(RtSafetyTest, DetectsFileIo) {
+    RtSafety::setHandler(ignoreViolation);
+    {
+        RtScope rt;
+        FILE* file = std::fopen("/dev/null", "w");
+        if (file != nullptr) std::fclose(file);
+    }
+    EXPECT_GE(RtSafety::violationCount(RtSafety::Violation::FileIo), 1u);
+}
+
+TEST_F(RtSafetyTest, QueuesAreAllocationFree) {
+    LockFreeQueue<Event, 64> queue;
+    DrumPatternBuffer buffer;
+    DrumBar bar;
+    bar.steps[0][0].velocity = 1.0f;
+    {
+        RtScope rt;
+        Event e = {36, 1.0f, 0.0};
+        for (int i = 0; i < 100; ++i) {
+            queue.push(e);
+            queue.pop(e);
+            buffer.push(bar);
+            buffer.pop(bar);
+        }
+    }
+    EXPECT_EQ(RtSafety::totalViolations(), 0u);
+}
+
+TEST_F(RtSafetyTest, EventPathIsAllocationFree) {
+    // Recording and note/velocity conversion stand in for event rendering
+    const KitMap kit = KitMap::generalMidi();
+    const VelocityCurve curve = VelocityCurve::exponential(1.5f);
+    const HumanizeProfile profile = Humanizer::genreProfile(DrumBar::Genre::Funk);
+    MidiRecorder recorder;
+    MidiRecorder::Transport transport;
+    transport.sampleRate = 48000.0;
+    DrumBar bar;
+    int8_t notes[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    uint8_t velocities[DrumBar::NUM_INSTRUMENTS][DrumBar::STEPS_PER_BAR];
+    {
+        RtScope rt;
+        for (int block = 0; block < 16; ++block) {
+            transport.ppqPosition = block * 0.5;
+            transport.barStartPpq = (block / 8) * 4.0;
+            recorder.beginBlock(transport);
+            recorder.recordEvent(100, 36, 100);
+            recorder.recordEvent(6000, 42, 80);
+        }
+        recorder.flush();
+        while (recorder.popBar(bar)) {
+            Humanizer::humanizeBar(bar, profile, 1234, 0, bar.barIndex);
+            kit.convertBar(bar, notes);
+            curve.convertBar(bar, velocities);
+        }
+    }
+    EXPECT_EQ(RtSafety::totalViolations(), 0u);
+}
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/samplerenderer.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+// Mono click: 1.0 on the first frame, then a decaying tail
+Sample click(size_t frames, double sampleRate = 48000.0) {
+    Sample s;
+    s.numChannels = 1;
+    s.sampleRate = sampleRate;
+    s.channels[0].resize(frames);
+    for (size_t f = 0; f < frames; ++f) s.channels[0][f] = 1.0f / static_cast<float>(f + 1);
+    return s;
+}
+
+// Frames where a click starts (only a click's first frame is exactly 1.0)
+std::vector<size_t> onsets(const std::vector<float>& buffer) {
+    std::vector<size_t> result;
+    for (size_t f = 0; f < buffer.size(); ++f) {
+        if (buffer[f] == 1.0f) result.push_back(f);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(Wav, Pcm16RoundTrip) {
+    std::vector<float> left = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f};
+    std::vector<float> right = {0.25f, -0.25f, 0.0f, 2.0f, -2.0f};
+    const float* channels[2] = {left.data(), right.data()};
+    std::vector<uint8_t> bytes;
+    Wav::encode(channels, 2, left.size(), 44100, Wav::Format::Pcm16, bytes);
+    EXPECT_EQ(bytes.size(), 44u + 5u * 4u);
+
+    Sample s;
+    ASSERT_TRUE(Wav::parse(bytes.data(), bytes.size(), s));
+    EXPECT_EQ(s.numChannels, 2);
+    EXPECT_EQ(s.sampleRate, 44100.0);
+    ASSERT_EQ(s.frames(), 5u);
+    for (size_t f = 0; f < 5; ++f) EXPECT_NEAR(s.channels[0][f], left[f], 1.0f / 16384.0f);
+    EXPECT_NEAR(s.channels[1][3], 1.0f, 1.0f / 16384.0f);   // clipped
+    EXPECT_NEAR(s.channels[1][4], -1.0f, 1.0f / 16384.0f);  // clipped
+}
+
+TEST(Wav, FloatRoundTripIsExact) {
+    std::vector<float> mono = {0.1f, -0.7f, 1.5f};
+    const float* channels[1] = {mono.data()};
+    std::vector<uint8_t> bytes;
+    Wav::encode(channels, 1, mono.size(), 48000, Wav::Format::Float32, bytes);
+    Sample s;
+    ASSERT_TRUE(Wav::parse(bytes.data(), bytes.size(), s));
+    EXPECT_EQ(s.numChannels, 1);
+    EXPECT_EQ(s.channels[0], mono);
+}
+
+TEST(Wav, Parses24BitAndSkipsUnknownChunks) {
+    // RIFF header, odd-sized LIST chunk (padded), fmt, data with two 24-bit frames
+    std::vector<uint8_t> bytes = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+                                  'L', 'I', 'S', 'T', 3, 0, 0, 0, 1, 2, 3, 0,
+                                  'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 1, 0,
+                                  0x80, 0xBB, 0, 0, 0x80, 0x32, 0x02, 0, 3, 0, 24, 0,
+                                  'd', 'a', 't', 'a', 6, 0, 0, 0,
+                                  0x00, 0x00, 0x40, 0x00, 0x00, 0xC0};
+    Sample s;
+    ASSERT_TRUE(Wav::parse(bytes.data(), bytes.size(), s));
+    EXPECT_EQ(s.sampleRate, 48000.0);
+    ASSERT_EQ(s.frames(), 2u);
+    EXPECT_FLOAT_EQ(s.channels[0][0], 0.5f);
+    EXPECT_FLOAT_EQ(s.channels[0][1], -0.5f);
+}
+
+TEST(Wav, RejectsGarbage) {
+    const char junk[] = "RIFF....WAVEdata";
+    Sample s;
+    EXPECT_FALSE(Wav::parse(junk, sizeof(junk), s));
+    EXPECT_FALSE(Wav::parse(junk, 4, s));
+    EXPECT_FALSE(Wav::load("/nonexistent/drumcore.wav", s));
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(Wav, SaveAndLoadFile) {
+    const std::string path = ::testing::TempDir() + "drumcore_samplerenderer_test.wav";
+    std::vector<float> mono = {0.0f, 0.25f, -0.25f};
+    const float* channels[1] = {mono.data()};
+    ASSERT_TRUE(Wav::save(path.c_str(), channels, 1, mono.size(), 48000, Wav::Format::Float32));
+
+    SampleKit kit;
+    ASSERT_TRUE(kit.loadSample(4, path.c_str()));
+    EXPECT_EQ(kit.sample(4).channels[0], mono);
+    std::remove(path.c_str());
+}
+
+TEST(GainCurve, FollowsVelocityCurveFlags) {
+    const GainCurve linear = GainCurve::linear();
+    EXPECT_FLOAT_EQ(linear.gain(0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(linear.gain(1.0f), 1.0f);
+    EXPECT_NEAR(linear.gain(0.5f), 0.5f, 1.0f / 255.0f);
+    EXPECT_NEAR(linear.gain(0.5f, DrumStep::FLAG_GHOST), 0.3f, 1.0f / 255.0f);
+    EXPECT_FLOAT_EQ(linear.gain(1.0f, DrumStep::FLAG_ACCENT), 1.0f);  // clamped
+
+    const GainCurve square = GainCurve::power(2.0f);
+    EXPECT_NEAR(square.gain(0.5f), 0.25f, 0.01f);
+
+    const GainCurve db = GainCurve::decibels(40.0f);
+    EXPECT_FLOAT_EQ(db.gain(1.0f), 1.0f);
+    EXPECT_NEAR(db.gain(0.5f), 0.1f, 0.01f);  // -20 dB
+    EXPECT_FLOAT_EQ(db.gain(0.0f), 0.0f);
+}
+
+TEST(SampleKit, ResamplesToKitRate) {
+    SampleKit kit(48000.0);
+    Sample ramp;
+    ramp.numChannels = 1;
+    ramp.sampleRate = 24000.0;
+    ramp.channels[0] = {0.0f, 1.0f, 2.0f, 3.0f};
+    ASSERT_TRUE(kit.setSample(0, ramp));
+    const std::vector<float>& out = kit.sample(0).channels[0];
+    ASSERT_EQ(out.size(), 8u);
+    EXPECT_FLOAT_EQ(out[1], 0.5f);
+    EXPECT_FLOAT_EQ(out[6], 3.0f);
+    EXPECT_FALSE(kit.setSample(10, ramp));
+    EXPECT_FALSE(kit.setSample(1, Sample()));
+    EXPECT_EQ(kit.longestSample(), 8u);
+}
+
+TEST(SampleRenderer, HitsLandOnStepsAndOffsets) {
+    SampleKit kit(48000.0);
+    kit.setSample(0, click(100));
+    DrumBar bar;
+    bar.steps[0][0] = DrumStep(1.0f, 0.0f, 0);
+    bar.steps[0][8] = DrumStep(1.0f, 0.0f, 0);
+    bar.steps[0][16] = DrumStep(1.0f, 10.0f, 0);  // +480 frames
+    bar.steps[1][4] = DrumStep(1.0f, 0.0f, 0);  // no sample: skipped
+
+    RenderSettings settings;  // 120 BPM 4/4: 24000 frames per quarter
+    EXPECT_EQ(SampleRenderer::barFrames(kit, settings), 96000u);
+    const size_t frames = SampleRenderer::renderFrames(kit, 1, settings);
+    EXPECT_EQ(frames, 96100u);
+
+    std::vector<float> out(frames, 7.0f);
+    EXPECT_EQ(SampleRenderer::render(kit, &bar, 1, settings, out.data(), nullptr, frames), 3u);
+    EXPECT_EQ(onsets(out), (std::vector<size_t>{0, 24000, 48480}));
+    EXPECT_FLOAT_EQ(out[99], 0.01f);
+    EXPECT_FLOAT_EQ(out[100], 0.0f);
+}
+
+TEST(SampleRenderer, ConsecutiveBarsAndEarlyHits) {
+    SampleKit kit(1000.0);
+    kit.setSample(5, click(10, 1000.0));
+    DrumBar bars[2];
+    bars[0].steps[5][0] = DrumStep(1.0f, -5.0f, 0);  // starts before frame 0
+    bars[1].steps[5][0] = DrumStep(1.0f, -5.0f, 0);
+
+    RenderSettings settings;
+    settings.includeTail = false;
+    const size_t frames = SampleRenderer::renderFrames(kit, 2, settings);
+    EXPECT_EQ(frames, 4000u);
+    std::vector<float> out(frames);
+    SampleRenderer::render(kit, bars, 2, settings, out.data(), nullptr, frames);
+    EXPECT_EQ(onsets(out), (std::vector<size_t>{1995}));
+    EXPECT_FLOAT_EQ(out[0], 1.0f / 6.0f);  // only the early hit's tail is heard
+}
+
+TEST(SampleRenderer, VelocityLevelAndStereo) {
+    SampleKit kit(1000.0);
+    Sample stereo = click(4, 1000.0);
+    stereo.numChannels = 2;
+    stereo.channels[1] = {0.5f, 0.5f, 0.5f, 0.5f};
+    kit.setSample(7, stereo);
+    kit.setLevel(7, 0.5f);
+    DrumBar bar;
+    bar.steps[7][0] = DrumStep(1.0f, 0.0f, 0);
+
+    RenderSettings settings;
+    std::vector<float> left(16), right(16);
+    SampleRenderer::render(kit, &bar, 1, settings, left.data(), right.data(), left.size());
+    EXPECT_FLOAT_EQ(left[0], 0.5f);
+    EXPECT_FLOAT_EQ(right[0], 0.25f);
+
+    SampleRenderer::render(kit, &bar, 1, settings, left.data(), nullptr, left.size());
+    EXPECT_FLOAT_EQ(left[0], 0.375f);  // mono mix averages channels
+}
+
+TEST(SampleRenderer, ClosedHatChokesOpenHat) {
+    SampleKit kit(1000.0);
+    Sample sustain;
+    sustain.numChannels = 1;
+    sustain.sampleRate = 1000.0;
+    sustain.channels[0].assign(1000, 1.0f);
+    kit.setSample(3, sustain);  // open hat rings for a second
+    kit.setSample(2, click(1, 1000.0));  // closed hat
+    DrumBar bar;
+    bar.steps[3][0] = DrumStep(1.0f, 0.0f, 0);
+    bar.steps[2][4] = DrumStep(1.0f, 0.0f, 0);  // 250 frames later
+
+    RenderSettings settings;
+    settings.chokeFadeMs = 2.0f;
+    const size_t frames = SampleRenderer::renderFrames(kit, 1, settings);
+    std::vector<float> out(frames);
+    SampleRenderer::render(kit, &bar, 1, settings, out.data(), nullptr, frames);
+    EXPECT_FLOAT_EQ(out[249], 1.0f);
+    EXPECT_FLOAT_EQ(out[250], 1.0f + 2.0f / 3.0f);  // closed hit + first fade frame
+    EXPECT_FLOAT_EQ(out[251], 1.0f / 3.0f);
+    EXPECT_FLOAT_EQ(out[252], 0.0f);
+    EXPECT_FLOAT_EQ(out[600], 0.0f);
+
+    kit.setChokes(2, 0);
+    SampleRenderer::render(kit, &bar, 1, settings, out.data(), nullptr, frames);
+    EXPECT_FLOAT_EQ(out[600], 1.0f);
+
+    kit.setChokeGroup((1u << 2) | (1u << 3));
+    EXPECT_EQ(kit.chokes(2), 1u << 3);
+    EXPECT_EQ(kit.chokes(3), 1u << 2);
+}
+
+TEST(SampleRenderer, BatchMatchesSerial) {
+    SampleKit kit(8000.0);
+    kit.setSample(0, click(300, 8000.0));
+    kit.setSample(2, click(50, 8000.0));
+    kit.setSample(3, click(900, 8000.0));
+    std::vector<DrumBar> bars(9);
+    for (size_t p = 0; p < bars.size(); ++p) {
+        bars[p].steps[0][p % 32] = DrumStep(0.9f, 0.0f, 0);
+        bars[p].steps[3][(p * 5) % 32] = DrumStep(0.6f, 3.0f, DrumStep::FLAG_GHOST);
+        bars[p].steps[2][(p * 7 + 1) % 32] = DrumStep(1.0f, -2.0f, 0);
+    }
+
+    RenderSettings settings;
+    settings.tempoBpm = 140.0;
+    const size_t frames = SampleRenderer::renderFrames(kit, 1, settings);
+    ThreadPool pool(3);
+    std::vector<float> batch(bars.size() * 2 * frames, 9.0f);
+    SampleRenderer::renderBatch(pool, kit, bars.data(), bars.size(), settings, batch.data(), 2,
+                                frames);
+
+    std::vector<float> left(frames), right(frames);
+    for (size_t p = 0; p < bars.size(); ++p) {
+        SampleRenderer::render(kit, &bars[p], 1, settings, left.data(), right.data(), frames);
+        const float* l = batch.data() + 2 * p * frames;
+        ASSERT_EQ(std::vector<float>(l, l + frames), left) << p;
+        ASSERT_EQ(std::vector<float>(l + frames, l + 2 * frames), right) << p;
+    }
+}
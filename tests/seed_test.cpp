@@ -7,6 +7,8 @@
 #include <gtest/gtest.h>
 
 #include <set>
+#include <thread>
+#include <vector>
 
 using namespace JKDigital;
 
@@ -104,3 +106,85 @@ TEST(Seed, RandomFloat_Deterministic) {
     uint64_t stateB = 555;
     EXPECT_FLOAT_EQ(Seed::randomFloat(stateA), Seed::randomFloat(stateB));
 }
+
+TEST(Seed, RandomAt_MatchesSplitmixStream) {
+    // randomAt(seed, k) is the (k+1)-th output of a SplitMix64 stream at seed
+    const uint64_t seed = Seed::deriveSeed(7, 1, 3);
+    EXPECT_EQ(Seed::randomAt(seed, 0), Seed::splitmix64(seed));
+    EXPECT_EQ(Seed::randomAt(seed, 1), Seed::splitmix64(seed + 0x9E3779B97F4A7C15ULL));
+}
+
+TEST(Seed, CounterRandom_MatchesDerivedBarSeed) {
+    const uint64_t barSeed = Seed::deriveSeed(12345, 2, 5);
+    EXPECT_EQ(Seed::counterRandom(12345, 2, 5, 3, 17, 1),
+              Seed::randomAt(barSeed, Seed::stepCounter(3, 17, 1)));
+}
+
+TEST(Seed, CounterRandom_DistinctCoordinates) {
+    std::set<uint64_t> values;
+    for (uint32_t inst = 0; inst < 10; ++inst) {
+        for (uint32_t step = 0; step < 32; ++step) {
+            for (uint32_t draw = 0; draw < 2; ++draw) {
+                values.insert(Seed::counterRandom(42, 0, 0, inst, step, draw));
+            }
+        }
+    }
+    EXPECT_EQ(values.size(), 640u);
+}
+
+TEST(Seed, FloatAt_InRange) {
+    const uint64_t barSeed = Seed::deriveSeed(99, 0, 0);
+    for (uint32_t step = 0; step < 1000; ++step) {
+        float val = Seed::floatAt(barSeed, 0, step);
+        EXPECT_GE(val, 0.0f);
+        EXPECT_LT(val, 1.0f);
+    }
+}
+
+TEST(Seed, FillFloats_MatchesRandomAccess) {
+    const uint64_t barSeed = Seed::deriveSeed(2024, 4, 9);
+    float values[24];
+    Seed::fillFloats(barSeed, 6, 2, values, 24, 8);
+    for (int i = 0; i < 24; ++i) {
+        EXPECT_EQ(values[i], Seed::floatAt(barSeed, 6, 8 + static_cast<uint32_t>(i), 2));
+    }
+}
+
+namespace {
+
+// Fill one bar of values for a transform, visiting cells in a given order
+void generateBar(uint64_t master, uint32_t bar, bool reverse, std::vector<uint64_t>& out) {
+    out.assign(10 * 32, 0);
+    for (int k = 0; k < 10 * 32; ++k) {
+        const int cell = reverse ? (10 * 32 - 1 - k) : k;
+        out[static_cast<size_t>(cell)] = Seed::counterRandom(
+            master, 3, bar, static_cast<uint32_t>(cell / 32), static_cast<uint32_t>(cell % 32));
+    }
+}
+
+}  // namespace
+
+TEST(Seed, CounterRandom_SerialAndParallelIdentical) {
+    constexpr uint32_t kBars = 64;
+    constexpr uint64_t kMaster = 0xC0FFEE;
+
+    std::vector<std::vector<uint64_t>> serial(kBars);
+    for (uint32_t bar = 0; bar < kBars; ++bar) {
+        generateBar(kMaster, bar, false, serial[bar]);
+    }
+
+    // Bars split across threads, cells visited in reverse order
+    std::vector<std::vector<uint64_t>> parallel(kBars);
+    std::vector<std::thread> workers;
+    constexpr uint32_t kThreads = 4;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&parallel, t] {
+            for (uint32_t bar = t; bar < kBars; bar += kThreads) {
+                generateBar(kMaster, bar, true, parallel[bar]);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(serial, parallel);
+}
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/seed.h>
+#include <drumcore/tensordecode.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+constexpr size_t kBar = TensorPack::kFloatsPerBar;
+
+size_t at(TensorLayout layout, int channel, int i, int s) {
+    return TensorDecode::detail::at(layout, channel, i * DrumBar::STEPS_PER_BAR + s);
+}
+
+// Model-like output: probabilities 0..1, velocities and offsets slightly out of range
+std::vector<float> randomOutput(uint64_t seed, TensorLayout layout) {
+    std::vector<float> t(kBar);
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const uint32_t inst = static_cast<uint32_t>(i);
+            const uint32_t step = static_cast<uint32_t>(s);
+            t[at(layout, 0, i, s)] = Seed::floatAt(seed, inst, step) * 1.2f - 0.1f;
+            t[at(layout, 1, i, s)] = Seed::floatAt(seed + 1, inst, step) * 2.4f - 1.2f;
+            // Quantized so that ties occur
+            t[at(layout, 2, i, s)] =
+                static_cast<float>(static_cast<int>(Seed::floatAt(seed + 2, inst, step) * 8)) / 8;
+        }
+    }
+    return t;
+}
+
+// Step-by-step reference: threshold, top-k, flags, offsets, then DrumBar::gateVelocity
+DrumBar reference(const std::vector<float>& t, const DecodeParams& p, TensorLayout layout) {
+    DrumBar bar;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        std::vector<int> hits;
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            if ((p.activeMask >> s & 1u) && t[at(layout, 2, i, s)] >= p.hitThreshold) {
+                hits.push_back(s);
+            }
+        }
+        std::stable_sort(hits.begin(), hits.end(), [&](int a, int b) {
+            return t[at(layout, 2, i, a)] > t[at(layout, 2, i, b)];
+        });
+        hits.resize(std::min<size_t>(hits.size(), static_cast<size_t>(std::max(0, p.maxHits[i]))));
+        for (int s : hits) {
+            DrumStep& d = bar.steps[i][s];
+            d.velocity = std::min(1.0f, std::max(0.0f, t[at(layout, 0, i, s)]));
+            d.timingOffsetMs = std::min(20.0f, std::max(-20.0f, t[at(layout, 1, i, s)] * 20.0f));
+            d.setGhost(d.velocity < p.ghostBelow);
+            d.setAccent(d.velocity >= p.accentAbove);
+            if (d.velocity == 0.0f) d.clear();
+        }
+    }
+    bar.gateVelocity(p.gateThreshold);
+    return bar;
+}
+
+void expectSame(const DrumBar& a, const DrumBar& b) {
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const DrumStep& x = a.steps[i][s];
+            const DrumStep& y = b.steps[i][s];
+            ASSERT_EQ(x.velocity, y.velocity) << i << "," << s;
+            ASSERT_EQ(x.timingOffsetMs, y.timingOffsetMs) << i << "," << s;
+            ASSERT_EQ(x.flags, y.flags) << i << "," << s;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TensorDecode, MatchesStepByStepReference) {
+    DecodeParams params;
+    params.hitThreshold = 0.4f;
+    params.maxHits[0] = 4;
+    params.maxHits[2] = 0;
+    params.maxHits[5] = 1;
+    params.gateThreshold = 0.1f;
+    params.activeMask = 0x0FFFFFFFu;
+    for (TensorLayout layout : {TensorLayout::NCHW, TensorLayout::NHWC}) {
+        for (uint64_t seed = 1; seed < 30; ++seed) {
+            const std::vector<float> t = randomOutput(seed, layout);
+            DrumBar out;
+            TensorDecode::decodeBar(t.data(), out, params, layout);
+            expectSame(out, reference(t, params, layout));
+        }
+    }
+}
+
+TEST(TensorDecode, FastPathMatchesScalar) {
+    DecodeParams params;
+    params.setMaxHits(6);
+    for (TensorLayout layout : {TensorLayout::NCHW, TensorLayout::NHWC}) {
+        for (uint64_t seed = 100; seed < 120; ++seed) {
+            const std::vector<float> t = randomOutput(seed, layout);
+            DrumBar fast, scalar;
+            const int n = TensorDecode::decodeBar(t.data(), fast, params, layout);
+            EXPECT_EQ(TensorDecode::detail::decodeBarScalar(t.data(), scalar, params, layout), n);
+            expectSame(fast, scalar);
+        }
+    }
+}
+
+TEST(TensorDecode, FlagsOffsetsAndGate) {
+    std::vector<float> t(kBar, 0.0f);
+    const TensorLayout nchw = TensorLayout::NCHW;
+    auto hit = [&](int i, int s, float v, float o) {
+        t[at(nchw, 0, i, s)] = v;
+        t[at(nchw, 1, i, s)] = o;
+        t[at(nchw, 2, i, s)] = 0.9f;
+    };
+    hit(1, 0, 0.2f, 0.5f);   // ghost, +10 ms
+    hit(1, 8, 0.9f, -2.0f);  // accent, clamped to -20 ms
+    hit(1, 16, 0.6f, 0.0f);  // plain
+    hit(1, 24, 0.02f, 0.0f); // gated
+    t[at(nchw, 0, 3, 4)] = 1.0f;  // loud but improbable
+
+    DrumBar out;
+    out.genre = DrumBar::Genre::Funk;
+    out.steps[7][7].velocity = 1.0f;  // overwritten
+    EXPECT_EQ(TensorDecode::decodeBar(t.data(), out), 3);
+    EXPECT_TRUE(out.steps[1][0].isGhost());
+    EXPECT_FLOAT_EQ(out.steps[1][0].timingOffsetMs, 10.0f);
+    EXPECT_TRUE(out.steps[1][8].isAccent());
+    EXPECT_FLOAT_EQ(out.steps[1][8].timingOffsetMs, -20.0f);
+    EXPECT_EQ(out.steps[1][16].flags, 0);
+    EXPECT_FALSE(out.steps[1][24].hasNote());
+    EXPECT_FALSE(out.steps[3][4].hasNote());
+    EXPECT_FALSE(out.steps[7][7].hasNote());
+    EXPECT_EQ(out.genre, DrumBar::Genre::Funk);
+}
+
+TEST(TensorDecode, TopKPrefersEarlierStepOnTies) {
+    std::vector<float> t(kBar, 0.0f);
+    for (int s = 0; s < 32; ++s) {
+        t[at(TensorLayout::NCHW, 0, 2, s)] = 0.7f;
+        t[at(TensorLayout::NCHW, 2, 2, s)] = s == 20 ? 0.95f : 0.8f;
+    }
+    DecodeParams params;
+    params.maxHits[2] = 3;
+    DrumBar out;
+    EXPECT_EQ(TensorDecode::decodeBar(t.data(), out, params), 3);
+    EXPECT_EQ(out.noteMask(2), (1u << 20) | 0x3u);
+}
+
+TEST(TensorDecode, RoundTripsPackedBars) {
+    DrumBar bar;
+    bar.steps[0][0] = DrumStep(1.0f, 0.0f, DrumStep::FLAG_ACCENT);
+    bar.steps[1][8] = DrumStep(0.6f, -4.0f, 0);
+    bar.steps[2][3] = DrumStep(0.2f, 6.0f, DrumStep::FLAG_GHOST);
+    for (TensorLayout layout : {TensorLayout::NCHW, TensorLayout::NHWC}) {
+        std::vector<float> t(kBar);
+        TensorPack::packBar(bar, t.data(), layout);
+        // Model stand-in: certain hits where the bar has notes
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                t[at(layout, 2, i, s)] = bar.steps[i][s].hasNote() ? 1.0f : 0.0f;
+            }
+        }
+        DrumBar out;
+        TensorDecode::decodeBar(t.data(), out, DecodeParams(), layout);
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            EXPECT_EQ(out.noteMask(i), bar.noteMask(i));
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                EXPECT_FLOAT_EQ(out.steps[i][s].velocity, bar.steps[i][s].velocity);
+                EXPECT_NEAR(out.steps[i][s].timingOffsetMs, bar.steps[i][s].timingOffsetMs, 1e-5f);
+                EXPECT_EQ(out.steps[i][s].flags, bar.steps[i][s].flags);
+            }
+        }
+    }
+}
+
+TEST(TensorDecode, BatchDecodesEachBar) {
+    const size_t count = 6;
+    std::vector<float> t(TensorPack::floatsFor(count));
+    for (size_t b = 0; b < count; ++b) {
+        const std::vector<float> one = randomOutput(b + 1, TensorLayout::NHWC);
+        std::copy(one.begin(), one.end(), t.begin() + static_cast<std::ptrdiff_t>(b * kBar));
+    }
+    std::vector<DrumBar> bars(count);
+    const size_t total =
+        TensorDecode::decode(t.data(), count, bars.data(), DecodeParams(), TensorLayout::NHWC);
+
+    size_t expected = 0;
+    for (size_t b = 0; b < count; ++b) {
+        DrumBar single;
+        expected += static_cast<size_t>(TensorDecode::decodeBar(
+            t.data() + b * kBar, single, DecodeParams(), TensorLayout::NHWC));
+        expectSame(bars[b], single);
+    }
+    EXPECT_EQ(total, expected);
+    EXPECT_GT(total, 0u);
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/seed.h>
+#include <drumcore/tensorpack.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+// Bar with every field varied, including out-of-range offsets and a stray flag bit
+DrumBar randomBar(uint64_t seed) {
+    DrumBar bar;
+    for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+        for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+            const uint32_t inst = static_cast<uint32_t>(i);
+            const uint32_t step = static_cast<uint32_t>(s);
+            DrumStep& d = bar.steps[i][s];
+            d.velocity = Seed::floatAt(seed, inst, step);
+            d.timingOffsetMs = (Seed::floatAt(seed + 1, inst, step) - 0.5f) * 60.0f;
+            d.flags = static_cast<uint8_t>(Seed::randomAt(seed + 2, i * 32 + s) & 0x0F);
+        }
+    }
+    return bar;
+}
+
+size_t nchw(int c, int i, int s) {
+    return (static_cast<size_t>(c) * DrumBar::NUM_INSTRUMENTS + i) * DrumBar::STEPS_PER_BAR + s;
+}
+
+size_t nhwc(int c, int i, int s) {
+    return (static_cast<size_t>(i) * DrumBar::STEPS_PER_BAR + s) * TensorPack::kNumChannels + c;
+}
+
+}  // namespace
+
+TEST(TensorPack, Shape) {
+    int64_t dims[4];
+    TensorPack::shape(256, TensorLayout::NCHW, dims);
+    EXPECT_EQ(dims[0], 256);
+    EXPECT_EQ(dims[1], 3);
+    EXPECT_EQ(dims[2], 10);
+    EXPECT_EQ(dims[3], 32);
+    TensorPack::shape(4, TensorLayout::NHWC, dims);
+    EXPECT_EQ(dims[1], 10);
+    EXPECT_EQ(dims[3], 3);
+    EXPECT_EQ(TensorPack::floatsFor(2), 2u * 960u);
+}
+
+TEST(TensorPack, ChannelValues) {
+    DrumBar bar;
+    bar.steps[3][5] = DrumStep(0.75f, -10.0f, DrumStep::FLAG_ACCENT);
+    bar.steps[9][31] = DrumStep(1.0f, 40.0f, DrumStep::FLAG_GHOST | 0x80);
+
+    std::vector<float> t(TensorPack::kFloatsPerBar);
+    TensorPack::packBar(bar, t.data(), TensorLayout::NCHW);
+    EXPECT_FLOAT_EQ(t[nchw(0, 3, 5)], 0.75f);
+    EXPECT_FLOAT_EQ(t[nchw(1, 3, 5)], -0.5f);
+    EXPECT_FLOAT_EQ(t[nchw(2, 3, 5)], 2.0f);
+    EXPECT_FLOAT_EQ(t[nchw(1, 9, 31)], 1.0f);  // clamped
+    EXPECT_FLOAT_EQ(t[nchw(2, 9, 31)], 1.0f);  // unknown bit dropped
+    EXPECT_FLOAT_EQ(t[nchw(0, 0, 0)], 0.0f);
+
+    TensorPack::packBar(bar, t.data(), TensorLayout::NHWC);
+    EXPECT_FLOAT_EQ(t[nhwc(0, 3, 5)], 0.75f);
+    EXPECT_FLOAT_EQ(t[nhwc(1, 3, 5)], -0.5f);
+    EXPECT_FLOAT_EQ(t[nhwc(2, 3, 5)], 2.0f);
+    EXPECT_FLOAT_EQ(t[nhwc(1, 9, 31)], 1.0f);
+}
+
+TEST(TensorPack, MatchesScalarReference) {
+    for (TensorLayout layout : {TensorLayout::NCHW, TensorLayout::NHWC}) {
+        for (uint64_t seed = 1; seed < 20; ++seed) {
+            const DrumBar bar = randomBar(seed);
+            std::vector<float> fast(TensorPack::kFloatsPerBar, -9.0f);
+            std::vector<float> reference(TensorPack::kFloatsPerBar, -9.0f);
+            TensorPack::packBar(bar, fast.data(), layout);
+            TensorPack::detail::packBarScalar(bar, reference.data(), layout);
+            ASSERT_EQ(fast, reference) << "seed " << seed;
+        }
+    }
+}
+
+TEST(TensorPack, LayoutsAreTransposes) {
+    const DrumBar bar = randomBar(7);
+    std::vector<float> a(TensorPack::kFloatsPerBar), b(TensorPack::kFloatsPerBar);
+    TensorPack::packBar(bar, a.data(), TensorLayout::NCHW);
+    TensorPack::packBar(bar, b.data(), TensorLayout::NHWC);
+    for (int c = 0; c < 3; ++c) {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                ASSERT_EQ(a[nchw(c, i, s)], b[nhwc(c, i, s)]);
+            }
+        }
+    }
+}
+
+TEST(TensorPack, BatchIsContiguous) {
+    std::vector<DrumBar> bars;
+    for (uint64_t seed = 0; seed < 5; ++seed) bars.push_back(randomBar(seed));
+    std::vector<float> batch(TensorPack::floatsFor(bars.size()));
+    TensorPack::pack(bars.data(), bars.size(), batch.data());
+
+    std::vector<const DrumBar*> gathered = {&bars[4], &bars[0]};
+    std::vector<float> fromPointers(TensorPack::floatsFor(2));
+    TensorPack::pack(gathered.data(), gathered.size(), fromPointers.data());
+
+    std::vector<float> single(TensorPack::kFloatsPerBar);
+    for (size_t b = 0; b < bars.size(); ++b) {
+        TensorPack::packBar(bars[b], single.data());
+        EXPECT_TRUE(std::equal(single.begin(), single.end(),
+                               batch.begin() + static_cast<std::ptrdiff_t>(b * 960)));
+    }
+    EXPECT_TRUE(
+        std::equal(fromPointers.begin(), fromPointers.begin() + 960, batch.begin() + 4 * 960));
+    EXPECT_TRUE(std::equal(fromPointers.begin() + 960, fromPointers.end(), batch.begin()));
+}
+
+TEST(TensorBuffer, AlignedAndGrowsOnly) {
+    TensorBuffer buffer(4);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % TensorPack::kAlignment, 0u);
+    EXPECT_EQ(buffer.capacityBars(), 4u);
+
+    const float* first = buffer.data();
+    buffer.reserveBars(2);
+    EXPECT_EQ(buffer.data(), first);
+
+    std::vector<DrumBar> bars(16, randomBar(3));
+    const float* packed = buffer.pack(bars.data(), bars.size(), TensorLayout::NHWC);
+    EXPECT_EQ(buffer.capacityBars(), 16u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(packed) % TensorPack::kAlignment, 0u);
+    EXPECT_EQ(packed[nhwc(0, 1, 2) + 15 * 960], bars[0].steps[1][2].velocity);
+
+    TensorBuffer moved(std::move(buffer));
+    EXPECT_EQ(moved.data(), packed);
+    EXPECT_EQ(buffer.data(), nullptr);  // NOLINT(bugprone-use-after-move)
+}
@@ -0,0 +1,26 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+// Reference bars shared by the analysis tests.
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <drumcore/drumgrid.h>
+
+namespace JKDigital {
+namespace TestBars {
+
+/** Kick on 1 and 3, snare on 2 and 4, closed hats on 8ths. */
+inline DrumBar rock() {
+    DrumBar bar;
+    bar.steps[0][0].velocity = 1.0f;
+    bar.steps[0][16].velocity = 1.0f;
+    bar.steps[1][8].velocity = 1.0f;
+    bar.steps[1][24].velocity = 1.0f;
+    for (int s = 0; s < DrumBar::STEPS_PER_BAR; s += 4) bar.steps[2][s].velocity = 0.7f;
+    return bar;
+}
+
+}  // namespace TestBars
+}  // namespace JKDigital
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/fillengine.h>
+#include <drumcore/seed.h>
+#include <drumcore/threadpool.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace JKDigital;
+
+namespace {
+
+// Fill bar i from a fixed source, seeded by its index
+void generateBar(std::vector<DrumBar>& bars, size_t i, uint64_t master) {
+    DrumBar source;
+    for (int s = 0; s < 32; s += 8) source.steps[1][s].velocity = 0.8f;
+    FillParams params;
+    params.length = FillLength::FullBar;
+    FillEngine::generate(source, params, Seed::deriveSeed(master, 0, static_cast<uint32_t>(i)),
+                         bars[i]);
+}
+
+bool sameBars(const std::vector<DrumBar>& a, const std::vector<DrumBar>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        for (int i = 0; i < DrumBar::NUM_INSTRUMENTS; ++i) {
+            for (int s = 0; s < DrumBar::STEPS_PER_BAR; ++s) {
+                const DrumStep& x = a[k].steps[i][s];
+                const DrumStep& y = b[k].steps[i][s];
+                if (x.velocity != y.velocity || x.timingOffsetMs != y.timingOffsetMs ||
+                    x.flags != y.flags) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(ThreadPool, RunsSubmittedTasks) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.numWorkers(), 3u);
+    std::atomic<int> count{0};
+    {
+        TaskGroup group(pool);
+        for (int i = 0; i < 100; ++i) group.run([&] { count.fetch_add(1); });
+    }
+    EXPECT_EQ(count.load(), 100);
+    EXPECT_GE(pool.metrics().tasksExecuted, 100u);
+}
+
+TEST(ThreadPool, ZeroWorkersRunOnTheWaitingThread) {
+    ThreadPool pool(0);
+    const std::thread::id self = std::this_thread::get_id();
+    bool onCaller = true;
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; ++i) {
+        group.run([&] { onCaller = onCaller && std::this_thread::get_id() == self; });
+    }
+    group.wait();
+    EXPECT_TRUE(onCaller);
+}
+
+TEST(ThreadPool, DestructorFinishesQueuedTasks) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) pool.submit([&] { count.fetch_add(1); });
+    }
+    EXPECT_EQ(count.load(), 50);
+}
+
+TEST(TaskGroup, NestedGroupsDoNotDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<int> leaves{0};
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i) {
+        outer.run([&] {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 8; ++j) inner.run([&] { leaves.fetch_add(1); });
+            inner.wait();
+        });
+    }
+    outer.wait();
+    EXPECT_EQ(leaves.load(), 64);
+}
+
+TEST(Parallel, ChunksAreIndependentOfThePool) {
+    EXPECT_EQ(Parallel::numChunks(0, 0, 8), 0u);
+    EXPECT_EQ(Parallel::numChunks(0, 16, 8), 2u);
+    EXPECT_EQ(Parallel::numChunks(3, 20, 8), 3u);
+    EXPECT_EQ(Parallel::numChunks(0, 5, 0), 5u);
+
+    ThreadPool pool(2);
+    std::vector<int> owner(100, -1);
+    std::atomic<int> calls{0};
+    Parallel::forRange(pool, 10, 100, 16, [&](size_t b, size_t e) {
+        EXPECT_EQ((b - 10) % 16, 0u);
+        EXPECT_LE(e - b, 16u);
+        const int id = calls.fetch_add(1);
+        for (size_t i = b; i < e; ++i) owner[i] = id;
+    });
+    EXPECT_EQ(calls.load(), 6);
+    for (size_t i = 0; i < 10; ++i) EXPECT_EQ(owner[i], -1);
+    for (size_t i = 10; i < 100; ++i) EXPECT_GE(owner[i], 0);
+}
+
+TEST(Parallel, ForEachMatchesSerialGeneration) {
+    const size_t count = 500;
+    std::vector<DrumBar> serial(count);
+    for (size_t i = 0; i < count; ++i) generateBar(serial, i, 42);
+
+    for (unsigned workers : {0u, 1u, 4u}) {
+        ThreadPool pool(workers);
+        std::vector<DrumBar> parallel(count);
+        Parallel::forEach(pool, 0, count, 7, [&](size_t i) { generateBar(parallel, i, 42); });
+        EXPECT_TRUE(sameBars(serial, parallel)) << workers << " workers";
+    }
+}
+
+TEST(Parallel, ReduceFoldsInChunkOrder) {
+    // Float sums depend on order; the result must not depend on the pool
+    auto map = [](size_t b, size_t e) {
+        float sum = 0.0f;
+        for (size_t i = b; i < e; ++i) sum += 1.0f / static_cast<float>(i + 1);
+        return sum;
+    };
+    auto add = [](float acc, float v) { return acc + v; };
+
+    ThreadPool none(0);
+    const float reference = Parallel::reduce(none, 0, 100000, 333, 0.0f, map, add);
+    for (unsigned workers : {1u, 3u, 8u}) {
+        ThreadPool pool(workers);
+        EXPECT_EQ(Parallel::reduce(pool, 0, 100000, 333, 0.0f, map, add), reference);
+    }
+
+    ThreadPool pool(2);
+    std::vector<size_t> order = Parallel::reduce(
+        pool, 0, 10, 3, std::vector<size_t>(),
+        [](size_t b, size_t) { return std::vector<size_t>{b}; },
+        [](std::vector<size_t> acc, std::vector<size_t> v) {
+            acc.insert(acc.end(), v.begin(), v.end());
+            return acc;
+        });
+    EXPECT_EQ(order, (std::vector<size_t>{0, 3, 6, 9}));
+}
+
+TEST(Parallel, EmptyRangeCallsNothing) {
+    ThreadPool pool(1);
+    bool called = false;
+    Parallel::forEach(pool, 5, 5, 4, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+    EXPECT_EQ(Parallel::reduce(pool, 5, 5, 4, 7, [](size_t, size_t) { return 1; },
+                               [](int a, int b) { return a + b; }),
+              7);
+}
+
+TEST(Parallel, ReducePartialsUseTheCallersScratchArena) {
+    ThreadPool pool(2);
+    auto map = [](size_t b, size_t e) { return static_cast<double>(e - b); };
+    auto add = [](double acc, double v) { return acc + v; };
+    EXPECT_EQ(Parallel::reduce(pool, 0, 4096, 16, 0.0, map, add), 4096.0);
+
+    ScratchArena& arena = threadScratch();
+    arena.resetMetrics();
+    EXPECT_EQ(Parallel::reduce(pool, 0, 4096, 16, 0.0, map, add), 4096.0);
+    EXPECT_GT(arena.metrics().allocations, 0u);
+    EXPECT_EQ(arena.metrics().upstreamAllocations, 0u);
+}
@@ -58,3 +58,69 @@ TEST(TimeSignature, Denominator_Values) {
     EXPECT_DOUBLE_EQ(TimeSignatureUtils::getDenominator(TimeSignature::k6_8), 8.0);
     EXPECT_DOUBLE_EQ(TimeSignatureUtils::getDenominator(TimeSignature::k7_8), 8.0);
 }
+
+TEST(TimeSignature, ActiveSteps_LongMetersTruncated) {
+    EXPECT_EQ(TimeSignatureUtils::getActiveSteps(TimeSignature::k5_4), 32);
+    EXPECT_EQ(TimeSignatureUtils::getActiveSteps(TimeSignature::k7_4), 32);
+    EXPECT_EQ(TimeSignatureUtils::getActiveSteps(TimeSignature::k12_8), 32);
+}
+
+TEST(TimeSignature, ActiveMask_MatchesActiveSteps) {
+    EXPECT_EQ(TimeSignatureUtils::getActiveMask(TimeSignature::k4_4), 0xFFFFFFFFu);
+    EXPECT_EQ(TimeSignatureUtils::getActiveMask(TimeSignature::k3_4), 0x00FFFFFFu);
+    EXPECT_EQ(TimeSignatureUtils::getActiveMask(TimeSignature::k7_8), 0x0FFFFFFFu);
+}
+
+TEST(TimeSignature, Descriptor_IsCompileTime) {
+    constexpr TimeSignatureDescriptor d = TimeSignatureUtils::makeDescriptor(5, 8);
+    static_assert(d.activeSteps == 20, "5/8 has 20 active steps");
+    static_assert(d.activeMask == 0x000FFFFFu, "5/8 mask");
+    static_assert(TimeSignatureUtils::getActiveSteps(TimeSignature::k6_8) == 24, "6/8");
+    EXPECT_DOUBLE_EQ(d.beatsPerBar, 2.5);
+    EXPECT_FALSE(d.compound);
+}
+
+TEST(TimeSignature, Descriptor_SimpleMeterTables) {
+    const TimeSignatureDescriptor& d = TimeSignatureUtils::getDescriptor(TimeSignature::k3_4);
+    EXPECT_EQ(d.stepsPerBeat, 8);
+    EXPECT_EQ(d.beatIndex[0], 0);
+    EXPECT_EQ(d.beatIndex[9], 1);
+    EXPECT_EQ(d.subdivision[9], 1);
+    EXPECT_EQ(d.metricWeight[0], TimeSignatureDescriptor::WEIGHT_DOWNBEAT);
+    EXPECT_EQ(d.metricWeight[8], TimeSignatureDescriptor::WEIGHT_BEAT);
+    EXPECT_EQ(d.metricWeight[12], TimeSignatureDescriptor::WEIGHT_8TH);
+    EXPECT_EQ(d.metricWeight[2], TimeSignatureDescriptor::WEIGHT_16TH);
+    EXPECT_EQ(d.metricWeight[3], TimeSignatureDescriptor::WEIGHT_32ND);
+    EXPECT_EQ(d.metricWeight[24], 0);
+    EXPECT_FALSE(d.isActive(24));
+    EXPECT_TRUE(d.isActive(23));
+    EXPECT_DOUBLE_EQ(d.ppq[12], 1.5);
+}
+
+TEST(TimeSignature, Descriptor_CompoundMeter) {
+    const TimeSignatureDescriptor& d = TimeSignatureUtils::getDescriptor(TimeSignature::k6_8);
+    EXPECT_TRUE(d.compound);
+    EXPECT_EQ(d.stepsPerBeat, 12);
+    EXPECT_EQ(d.metricWeight[12], TimeSignatureDescriptor::WEIGHT_BEAT);
+    EXPECT_EQ(d.metricWeight[4], TimeSignatureDescriptor::WEIGHT_8TH);
+    EXPECT_EQ(d.metricWeight[8], TimeSignatureDescriptor::WEIGHT_8TH);
+    EXPECT_EQ(d.beatIndex[23], 1);
+}
+
+TEST(TimeSignature, Descriptor_OddMeters) {
+    const TimeSignatureDescriptor d11 = TimeSignatureUtils::makeDescriptor(11, 16);
+    EXPECT_EQ(d11.activeSteps, 22);
+    EXPECT_EQ(d11.stepsPerBeat, 2);
+    EXPECT_DOUBLE_EQ(d11.beatsPerBar, 2.75);
+
+    const TimeSignatureDescriptor d9 = TimeSignatureUtils::makeDescriptor(9, 8);
+    EXPECT_TRUE(d9.compound);
+    EXPECT_EQ(d9.activeSteps, 32);
+}
+
+TEST(TimeSignature, Descriptor_InvalidFallsBackTo4_4) {
+    EXPECT_FALSE(TimeSignatureUtils::isValid(4, 3));
+    const TimeSignatureDescriptor d = TimeSignatureUtils::makeDescriptor(4, 3);
+    EXPECT_EQ(d.numerator, 4);
+    EXPECT_EQ(d.denominator, 4);
+}
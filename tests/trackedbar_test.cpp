@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2025-2026 JK Digital.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------
+
+#include <drumcore/trackedbar.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace JKDigital;
+
+TEST(TrackedBar, NewConsumerSeesEverything) {
+    TrackedBar bar;
+    TrackedBar::Cursor cursor;
+    const DirtyRegion region = bar.consume(cursor);
+    EXPECT_EQ(region.instrumentMask, (1u << DrumBar::NUM_INSTRUMENTS) - 1);
+    EXPECT_EQ(region.stepMasks[0], DrumBar::ALL_STEPS);
+    EXPECT_TRUE(region.metadata);
+    EXPECT_TRUE(bar.consume(cursor).empty());
+}
+
+TEST(TrackedBar, ReportsOnlyChangedSteps) {
+    TrackedBar bar;
+    TrackedBar::Cursor cursor;
+    bar.consume(cursor);
+
+    EXPECT_TRUE(bar.setVelocity(1, 4, 0.8f));
+    EXPECT_TRUE(bar.setFlags(1, 12, DrumStep::FLAG_GHOST));
+    EXPECT_TRUE(bar.setTimingOffset(8, 31, 2.0f));
+    EXPECT_TRUE(bar.hasChanges(cursor));
+
+    const DirtyRegion region = bar.consume(cursor);
+    EXPECT_EQ(region.instrumentMask, (1u << 1) | (1u << 8));
+    EXPECT_EQ(region.stepMasks[1], (1u << 4) | (1u << 12));
+    EXPECT_EQ(region.stepMasks[8], 1u << 31);
+    EXPECT_TRUE(region.rowDirty(1));
+    EXPECT_FALSE(region.rowDirty(0));
+    EXPECT_FALSE(region.metadata);
+    EXPECT_EQ(region.firstStep(), 4);
+    EXPECT_EQ(region.lastStep(), 31);
+    EXPECT_FLOAT_EQ(bar.step(1, 4).velocity, 0.8f);
+}
+
+TEST(TrackedBar, UnchangedWritesAreNotReported) {
+    TrackedBar bar;
+    TrackedBar::Cursor cursor;
+    bar.setVelocity(0, 0, 1.0f);
+    bar.consume(cursor);
+
+    const uint32_t gen = bar.generation();
+    EXPECT_FALSE(bar.setVelocity(0, 0, 1.0f));
+    EXPECT_FALSE(bar.clearStep(5, 5));
+    bar.clearRow(3);
+    bar.setGenre(bar.bar().genre);
+    EXPECT_EQ(bar.generation(), gen);
+    EXPECT_FALSE(bar.hasChanges(cursor));
+}
+
+TEST(TrackedBar, IndependentConsumersSeeTheirOwnDeltas) {
+    TrackedBar bar;
+    TrackedBar::Cursor renderer, hasher;
+    bar.consume(renderer);
+    bar.consume(hasher);
+
+    bar.setVelocity(0, 0, 1.0f);
+    EXPECT_EQ(bar.consume(renderer).stepMasks[0], 1u);
+
+    bar.setVelocity(2, 8, 0.5f);
+    const DirtyRegion forRenderer = bar.consume(renderer);
+    EXPECT_EQ(forRenderer.instrumentMask, 1u << 2);
+
+    // The hasher has not looked yet: it sees both edits
+    const DirtyRegion forHasher = bar.consume(hasher);
+    EXPECT_EQ(forHasher.instrumentMask, (1u << 0) | (1u << 2));
+    EXPECT_EQ(forHasher.stepMasks[2], 1u << 8);
+}
+
+TEST(TrackedBar, AssignDiffsAgainstCurrentContents) {
+    DrumBar source;
+    source.steps[0][0].velocity = 1.0f;
+    source.steps[1][8].velocity = 0.7f;
+    TrackedBar bar(source);
+    TrackedBar::Cursor cursor;
+    bar.consume(cursor);
+
+    DrumBar next = source;
+    next.steps[1][8].velocity = 0.0f;
+    next.steps[2][16].velocity = 0.4f;
+    next.genre = DrumBar::Genre::Funk;
+    EXPECT_EQ(bar.assign(next), 2);
+
+    const DirtyRegion region = bar.consume(cursor);
+    EXPECT_EQ(region.instrumentMask, (1u << 1) | (1u << 2));
+    EXPECT_EQ(region.stepMasks[1], 1u << 8);
+    EXPECT_EQ(region.stepMasks[2], 1u << 16);
+    EXPECT_TRUE(region.metadata);
+    EXPECT_EQ(bar.bar().genre, DrumBar::Genre::Funk);
+}
+
+TEST(TrackedBar, MarkDirtyCoversExternalEdits) {
+    TrackedBar bar;
+    TrackedBar::Cursor cursor;
+    bar.consume(cursor);
+    bar.markDirty(6, 0xF0u);
+    bar.markDirty(7, 0);
+    const DirtyRegion region = bar.consume(cursor);
+    EXPECT_EQ(region.instrumentMask, 1u << 6);
+    EXPECT_EQ(region.stepMasks[6], 0xF0u);
+}
+
+TEST(TrackedPattern, ReportsChangedBarsPerConsumer) {
+    auto pattern = std::make_unique<TrackedPattern>(4);
+    TrackedPattern::Cursor ui, renderer;
+    DirtyRegion regions[TrackedPattern::MAX_BARS];
+
+    EXPECT_EQ(pattern->consume(ui, regions), 0xFu);
+    EXPECT_EQ(pattern->consume(renderer, nullptr), 0xFu);
+    EXPECT_EQ(pattern->consume(ui, regions), 0u);
+
+    (*pattern)[2].setVelocity(1, 4, 1.0f);
+    EXPECT_EQ(pattern->changedBars(ui), 1u << 2);
+    EXPECT_EQ(pattern->consume(ui, regions), 1u << 2);
+    EXPECT_TRUE(regions[0].empty());
+    EXPECT_EQ(regions[2].stepMasks[1], 1u << 4);
+
+    (*pattern)[0].setVelocity(0, 0, 1.0f);
+    EXPECT_EQ(pattern->consume(renderer, nullptr), (1u << 0) | (1u << 2));
+}
+
+TEST(TrackedPattern, GrowReportsNewBarsInFull) {
+    auto pattern = std::make_unique<TrackedPattern>(2);
+    TrackedPattern::Cursor cursor;
+    pattern->consume(cursor, nullptr);
+
+    pattern->setNumBars(4);
+    DirtyRegion regions[TrackedPattern::MAX_BARS];
+    EXPECT_EQ(pattern->consume(cursor, regions), (1u << 2) | (1u << 3));
+    EXPECT_EQ(regions[3].stepMasks[9], DrumBar::ALL_STEPS);
+
+    pattern->setNumBars(1);
+    EXPECT_EQ(pattern->consume(cursor, regions), 0u);
+    EXPECT_EQ(pattern->numBars(), 1);
+}
+
+TEST(TrackedPattern, AssignReportsOnlyDifferences) {
+    DrumBar bars[3];
+    bars[1].steps[0][0].velocity = 1.0f;
+    auto pattern = std::make_unique<TrackedPattern>(3);
+    pattern->assign(bars, 3);
+    TrackedPattern::Cursor cursor;
+    pattern->consume(cursor, nullptr);
+
+    bars[1].steps[0][0].velocity = 0.5f;
+    EXPECT_EQ(pattern->assign(bars, 3), 1);
+    EXPECT_EQ(pattern->consume(cursor, nullptr), 1u << 1);
+}